@@ -0,0 +1,120 @@
+#!/bin/sh
+# Copyright (c) 2018 Ristretto Developers.
+# Released under the MIT License.  See LICENSE.txt for license information.
+#
+# Build, check and benchmark every backend with every profile, for
+# make bench-matrix.  Usage:
+#
+#   bench_matrix.sh "arches" "profiles" out.json [filter...]
+#
+# Each pair is built from scratch under $BUILD/matrix.  The first pair that
+# builds and runs is the reference: every other one must print the same
+# ristretto_bench --check digests, or it is reported as a mismatch and not
+# ranked.  The filters are passed on to ristretto_bench.
+
+set -u
+
+arches=$1
+profiles=$2
+json=$3
+shift 3
+
+make=${MAKE:-make}
+top=${BUILD:-build}/matrix
+mkdir -p "$top"
+
+ref=
+list=$top/configs.txt
+times=$top/times.txt
+: > "$list"
+: > "$times"
+
+for arch in $arches; do
+    for profile in $profiles; do
+        name=$arch-$(echo "$profile" | tr 'A-Z' 'a-z' | sed 's/[,=]/-/g')
+        dir=$top/$name
+        settings=
+        [ "$profile" = default ] || settings=$(echo "$profile" | tr ',' ' ')
+        echo "== $name" >&2
+
+        rm -rf "$dir"
+        mkdir -p "$dir"
+        # $settings is deliberately split into one argument per setting
+        if ! $make --no-print-directory ARCH="$arch" $settings BUILD="$dir" \
+                TABLES_C="$dir/ristretto_tables.c" "$dir/obj/bin/ristretto_bench" > "$dir/build.log" 2>&1; then
+            check="build failed"
+        elif ! "$dir/obj/bin/ristretto_bench" --check "$@" > "$dir/check.txt" 2>> "$dir/build.log"; then
+            check="won't run"
+        elif [ -z "$ref" ]; then
+            ref=$name
+            check=ok
+        elif cmp -s "$top/$ref/check.txt" "$dir/check.txt"; then
+            check=ok
+        else
+            check=mismatch
+            diff "$top/$ref/check.txt" "$dir/check.txt" | sed -n 's/^> \([^ ]*\) .*/   differs from '"$ref"': \1/p' >&2
+        fi
+        [ "$check" = ok ] || echo "   $check, see $dir" >&2
+
+        if [ "$check" = ok ]; then
+            "$dir/obj/bin/ristretto_bench" "$@" > "$dir/bench.json"
+            awk -v c="$name" 'match($0, /"name": "[^"]*"/) {
+                n = substr($0, RSTART+9, RLENGTH-10)
+                if (match($0, /"ns_per_op": [0-9.]+/)) print c, n, substr($0, RSTART+13, RLENGTH-13)
+            }' "$dir/bench.json" >> "$times"
+        fi
+        printf '%s\t%s\t%s\t%s\n' "$name" "$arch" "$profile" "$check" >> "$list"
+    done
+done
+
+if [ -z "$ref" ]; then
+    echo "No configuration could be built and run" >&2
+    exit 1
+fi
+
+# Speedup of each configuration over the reference: the geometric mean of
+# its ratios on the benchmarks both ran.
+speedups=$top/speedups.txt
+awk -v ref="$ref" '
+    { ns[$1, $2] = $3; if ($1 == ref) names[$2] = 1; confs[$1] = 1 }
+    END {
+        for (c in confs) {
+            s = 0; k = 0
+            for (n in names) if ((c, n) in ns && ns[c, n] > 0) { s += log(ns[ref, n] / ns[c, n]); k++ }
+            if (k) printf "%s %.3f\n", c, exp(s / k)
+        }
+    }' "$times" | sort -k2,2nr > "$speedups"
+
+echo
+echo "Ranked by geometric mean speedup over $ref:"
+printf '%4s  %-28s %8s\n' rank config speedup
+awk '{ printf "%4d  %-28s %7.2fx\n", NR, $1, $2 }' "$speedups"
+awk -F '\t' '$4 != "ok" { printf "   -  %-28s %s\n", $1, $4 }' "$list"
+
+echo
+echo "Fastest configuration for each benchmark:"
+printf '%-44s %-28s %12s %8s\n' benchmark config ns_per_op speedup
+awk -v ref="$ref" '
+    { if (!($2 in best) || $3 < best[$2]) { best[$2] = $3; who[$2] = $1 }
+      if ($1 == ref) { base[$2] = $3; order[++k] = $2 } }
+    END { for (i=1; i<=k; i++) { n = order[i]; r = best[n] ? base[n] / best[n] : 0
+        printf "%-44s %-28s %12.1f %7.2fx\n", n, who[n], best[n], r } }
+' "$times"
+
+# Everything, as one JSON document
+{
+    printf '{\n  "machine": "%s",\n  "reference": "%s",\n  "configs": [' "$(uname -m)" "$ref"
+    first=1
+    while IFS="$(printf '\t')" read -r name arch profile check; do
+        [ $first = 1 ] || printf ','
+        first=0
+        speedup=$(awk -v c="$name" '$1 == c { print $2 }' "$speedups")
+        printf '\n    {"name": "%s", "arch": "%s", "profile": "%s", "check": "%s", "speedup": %s, "bench": ' \
+            "$name" "$arch" "$profile" "$check" "${speedup:-null}"
+        if [ -s "$top/$name/bench.json" ]; then sed 's/^/    /' "$top/$name/bench.json" | sed '1s/^ *//'; else printf 'null'; fi
+        printf '}'
+    done < "$list"
+    printf '\n  ]\n}\n'
+} > "$json"
+echo
+echo "Wrote $json"
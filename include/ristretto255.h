@@ -158,6 +158,88 @@ typedef struct ristretto255_precomputed_s ristretto255_precomputed_s;
 /** Size and alignment of precomputed point tables. */
 extern const size_t ristretto255_sizeof_precomputed_s, ristretto255_alignof_precomputed_s;
 
+/**
+ * Caller-supplied memory allocator for tables and scratch space.  Every
+ * function which takes one also accepts NULL, meaning posix_memalign and
+ * free.
+ */
+typedef struct {
+    /** Return size bytes aligned to align, a power of two, or NULL. */
+    void *(*alloc)(void *ctx, size_t size, size_t align);
+    /** Release a region from alloc.  size is the size that was asked for. */
+    void (*free)(void *ctx, void *ptr, size_t size);
+    /** Passed to alloc and free. */
+    void *ctx;
+} ristretto255_allocator_t;
+
+/**
+ * Caller-supplied way to run independent tasks in parallel, e.g. on a thread
+ * pool.  Every function which takes one also accepts NULL, meaning run
+ * everything on the calling thread.
+ *
+ * The library splits a job into tasks of a fixed shape which doesn't depend
+ * on the executor, so the result is the same however many threads run them.
+ */
+typedef struct {
+    /**
+     * Call task(arg, i) once for each i < ntasks, in any order and from any
+     * threads, and return when they have all finished.
+     */
+    void (*run)(void *ctx, void (*task)(void *arg, size_t i), void *arg, size_t ntasks);
+    /** Passed to run. */
+    void *ctx;
+} ristretto255_executor_t;
+
+/**
+ * Caller-supplied source of random bytes, e.g. for the weights in
+ * ristretto255_batch_verify.  It must be cryptographically secure and
+ * unpredictable to whoever supplied the data being checked.
+ */
+typedef struct {
+    /** Fill out with len random bytes. */
+    void (*fill)(void *ctx, unsigned char *out, size_t len);
+    /** Passed to fill. */
+    void *ctx;
+} ristretto255_rng_t;
+
+/**
+ * Bytes of scratch space per term used by ristretto255_multiscalar_mul and
+ * ristretto255_multiscalar_mul_non_secret: n terms never need more than
+ * n * ristretto255_multiscalar_scratch_bytes_per_term, in one allocation.
+ * Nothing else allocates scratch from the heap.  The _with_scratch variants
+ * run in caller-owned space of ristretto255_multiscalar_scratch_size bytes.
+ */
+extern const size_t ristretto255_multiscalar_scratch_bytes_per_term;
+
+/** Table of odd multiples of a point, for repeated variable-time
+ * multiplication by the same base.  Opaque; see
+ * ristretto255_wnaf_precomputed_create.
+ */
+typedef struct ristretto255_wnaf_precomputed_s ristretto255_wnaf_precomputed_t;
+
+/** Largest table_bits accepted by ristretto255_wnaf_precomputed_create. */
+#define RISTRETTO255_WNAF_MAX_TABLE_BITS 8
+
+/** Comb tables of a fixed vector of generators, for repeated multiscalar
+ * multiplication by the same points.  Opaque; see
+ * ristretto255_generators_create.
+ */
+typedef struct ristretto255_generators_s ristretto255_generators_t;
+
+/** Largest teeth accepted by ristretto255_generators_create. */
+#define RISTRETTO255_GENERATORS_MAX_TEETH 8
+
+/** An array of points in struct-of-arrays form: the points are grouped in
+ * blocks of RISTRETTO255_POINT_BATCH_LANES, and within a block each limb of
+ * each coordinate is stored for all the points together, so that a SIMD
+ * backend can work on a whole block at once.  Opaque; see
+ * ristretto255_point_batch_create.
+ */
+typedef struct ristretto255_point_batch_s ristretto255_point_batch_t;
+
+/** Points in each block of a ristretto255_point_batch_t. */
+#define RISTRETTO255_POINT_BATCH_LANES 8
+
 /** Representation of an element of the scalar field. */
 typedef struct {
     /** @cond internal */
@@ -165,6 +247,17 @@ typedef struct {
     /** @endcond */
 } ristretto255_scalar_t;
 
+/**
+ * A scalar x held as x*2^256 mod the group order.  Multiplying two of these
+ * costs half as much as ristretto255_scalar_mul, so long chains of products
+ * can convert once on the way in and once on the way out.
+ */
+typedef struct {
+    /** @cond internal */
+    ristretto_word_t limb[RISTRETTO255_SCALAR_LIMBS];
+    /** @endcond */
+} ristretto255_scalar_mont_t;
+
 #if defined _MSC_VER
 
 /** The scalar 1. */
@@ -216,6 +309,27 @@ ristretto_error_t ristretto255_scalar_decode (
     const unsigned char ser[RISTRETTO255_SCALAR_BYTES]
 ) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Read an array of scalars from wire format.
+ *
+ * Equivalent to calling ristretto255_scalar_decode on each element, and
+ * runs in constant time with respect to which elements are canonical.
+ *
+ * @param [out] out The n deserialized scalars.
+ * @param [in] ser The serialized scalars, n*RISTRETTO255_SCALAR_BYTES bytes
+ * laid out back to back.
+ * @param [in] n The number of scalars.
+ *
+ * @retval RISTRETTO_SUCCESS Every scalar was correctly encoded.
+ * @retval RISTRETTO_FAILURE At least one scalar was greater than the
+ * modulus.  Every scalar has still been decoded and reduced.
+ */
+ristretto_error_t ristretto255_scalar_decode_batch (
+    ristretto255_scalar_t *out,
+    const unsigned char *ser,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
 /**
  * @brief Read a scalar from wire format or from bytes.  Reduces mod
  * scalar prime.
@@ -289,6 +403,82 @@ void ristretto255_scalar_mul (
     const ristretto255_scalar_t *b
 ) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Multiply two scalars and add a third, as one reduction.  The
+ * scalars may use the same memory.
+ * @param [in] a One scalar.
+ * @param [in] b Another scalar.
+ * @param [in] c The scalar to add.
+ * @param [out] out a*b+c.
+ */
+void ristretto255_scalar_muladd (
+    ristretto255_scalar_t *out,
+    const ristretto255_scalar_t *a,
+    const ristretto255_scalar_t *b,
+    const ristretto255_scalar_t *c
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Convert a scalar to Montgomery form.  The scalars may use the
+ * same memory.
+ * @param [in] a A scalar.
+ * @param [out] out a in Montgomery form.
+ */
+void ristretto255_scalar_to_montgomery (
+    ristretto255_scalar_mont_t *out,
+    const ristretto255_scalar_t *a
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Convert a scalar out of Montgomery form.  The scalars may use the
+ * same memory.
+ * @param [in] a A scalar in Montgomery form.
+ * @param [out] out a as an ordinary scalar.
+ */
+void ristretto255_scalar_from_montgomery (
+    ristretto255_scalar_t *out,
+    const ristretto255_scalar_mont_t *a
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Multiply two scalars in Montgomery form.  The scalars may use the
+ * same memory.
+ * @param [in] a One scalar.
+ * @param [in] b Another scalar.
+ * @param [out] out a*b, in Montgomery form.
+ */
+void ristretto255_scalar_mont_mul (
+    ristretto255_scalar_mont_t *out,
+    const ristretto255_scalar_mont_t *a,
+    const ristretto255_scalar_mont_t *b
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Square a scalar in Montgomery form.  The scalars may use the same
+ * memory.
+ * @param [in] a A scalar.
+ * @param [out] out a^2, in Montgomery form.
+ */
+void ristretto255_scalar_mont_sqr (
+    ristretto255_scalar_mont_t *out,
+    const ristretto255_scalar_mont_t *a
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Multiply two scalars in Montgomery form and add a third, e.g. for
+ * one step of Horner's rule.  The scalars may use the same memory.
+ * @param [in] a One scalar.
+ * @param [in] b Another scalar.
+ * @param [in] c The scalar to add.
+ * @param [out] out a*b+c, in Montgomery form.
+ */
+void ristretto255_scalar_mont_muladd (
+    ristretto255_scalar_mont_t *out,
+    const ristretto255_scalar_mont_t *a,
+    const ristretto255_scalar_mont_t *b,
+    const ristretto255_scalar_mont_t *c
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
 /**
 * @brief Halve a scalar.  The scalars may use the same memory.
 * @param [in] a A scalar.
@@ -310,6 +500,26 @@ ristretto_error_t ristretto255_scalar_invert (
     const ristretto255_scalar_t *a
 ) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Invert an array of scalars.  Zeros are inverted to 0 as with
+ * ristretto255_scalar_invert, and the others are unaffected by them.
+ *
+ * Uses Montgomery's trick, so n inversions cost one ristretto255_scalar_invert
+ * and 3(n-1) multiplications.  Constant time.
+ *
+ * @param [out] out The n inverses.  Must not overlap a.
+ * @param [in] a The n scalars to invert.
+ * @param [in] n The number of scalars.
+ *
+ * @retval RISTRETTO_SUCCESS Every input was nonzero.
+ * @retval RISTRETTO_FAILURE At least one input was zero.
+ */
+ristretto_error_t ristretto255_scalar_batch_invert (
+    ristretto255_scalar_t *__restrict__ out,
+    const ristretto255_scalar_t *__restrict__ a,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
 /**
  * @brief Copy a scalar.  The scalars may use the same memory, in which
  * case this function does nothing.
@@ -344,6 +554,23 @@ void ristretto255_point_encode (
     const ristretto255_point_t *pt
 ) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Encode an array of points as sequences of bytes.
+ *
+ * Equivalent to calling ristretto255_point_encode on each point.  Every
+ * encoding requires its own inverse square root, so the cost is linear
+ * in n with no shared exponentiation.
+ *
+ * @param [out] out The byte representations of the points.
+ * @param [in] pts The points to encode.
+ * @param [in] n The number of points.
+ */
+void ristretto255_point_encode_batch (
+    uint8_t (*out)[RISTRETTO255_SER_BYTES],
+    const ristretto255_point_t *pts,
+    size_t n
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
 /**
  * @brief Decode a point from a sequence of bytes.
  *
@@ -364,6 +591,32 @@ ristretto_error_t ristretto255_point_decode (
     ristretto_bool_t allow_identity
 ) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Decode an array of points from sequences of bytes.
+ *
+ * Equivalent to calling ristretto255_point_decode on each element.  If an
+ * element is an invalid encoding, its output point is undefined, but the
+ * others are still decoded.  Runs in constant time with respect to which
+ * elements are valid.
+ *
+ * @param [out] pts The decoded points.
+ * @param [out] results The result of decoding each element.
+ * @param [in] ser The serialized points, n*RISTRETTO255_SER_BYTES bytes
+ * laid out back to back.
+ * @param [in] n The number of points.
+ * @param [in] allow_identity RISTRETTO_TRUE if the identity is a legal input.
+ * @retval RISTRETTO_SUCCESS Every element was decoded successfully.
+ * @retval RISTRETTO_FAILURE At least one element didn't represent a point;
+ * consult results to find out which.
+ */
+ristretto_error_t ristretto255_point_decode_batch (
+    ristretto255_point_t *pts,
+    ristretto_error_t *results,
+    const uint8_t *ser,
+    size_t n,
+    ristretto_bool_t allow_identity
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
 /**
  * @brief Copy a point.  The input and output may alias,
  * in which case this function does nothing.
@@ -392,6 +645,49 @@ ristretto_bool_t ristretto255_point_eq (
     const ristretto255_point_t *b
 ) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Compute a key for each of an array of points, such that two points
+ * are equal exactly when their keys are equal as bytes.
+ *
+ * The keys are meant for hashing and sorting in place of encodings.  They
+ * are not encodings and can't be decoded.  Each run of up to 64 points
+ * shares one field inversion, instead of every point taking an inverse
+ * square root as in ristretto255_point_encode_batch.
+ *
+ * @param [out] keys The keys of the points.
+ * @param [in] pts The points.
+ * @param [in] n The number of points.
+ */
+void ristretto255_point_canonical_batch (
+    uint8_t (*keys)[RISTRETTO255_SER_BYTES],
+    const ristretto255_point_t *pts,
+    size_t n
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Find the duplicates in an array of points.
+ *
+ * This sorts the keys from ristretto255_point_canonical_batch, so it takes
+ * O(n log n) byte comparisons rather than O(n^2) calls to
+ * ristretto255_point_eq.  It is not constant-time.
+ *
+ * @param [out] first For each point, the index of the first point equal to
+ * it.  pts[i] repeats an earlier point exactly when first[i] != i.
+ * @param [in] pts The points.
+ * @param [in] n The number of points.
+ * @param [in] allocator Where to allocate scratch space, or NULL for the heap.
+ *
+ * @retval RISTRETTO_SUCCESS The duplicates were found.
+ * @retval RISTRETTO_FAILURE Scratch space couldn't be allocated, and first
+ * was not written.
+ */
+ristretto_error_t ristretto255_point_dedup (
+    size_t *first,
+    const ristretto255_point_t *pts,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
 /**
  * @brief Add two points to produce a third point.  The
  * input points and output point can be pointers to the same
@@ -498,6 +794,26 @@ void ristretto255_precompute (
     const ristretto255_point_t *b
 ) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Allocate and fill a precomputed table, as with
+ * ristretto255_precompute.  The table is ristretto255_sizeof_precomputed_s
+ * bytes, aligned to ristretto255_alignof_precomputed_s, and is the only
+ * allocation made.
+ *
+ * @param [out] pre The new table, to be freed with
+ * ristretto255_precomputed_free.  NULL on failure.
+ * @param [in] base Any point.
+ * @param [in] allocator Where to allocate the table, or NULL for the heap.
+ *
+ * @retval RISTRETTO_SUCCESS The table was created.
+ * @retval RISTRETTO_FAILURE The table couldn't be allocated.
+ */
+ristretto_error_t ristretto255_precomputed_create (
+    ristretto255_precomputed_s **pre,
+    const ristretto255_point_t *base,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
 /**
  * @brief Multiply a precomputed base point by a scalar:
  * scaled = scalar*base.
@@ -515,6 +831,26 @@ void ristretto255_precomputed_scalarmul (
     const ristretto255_scalar_t *scalar
 ) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Multiply a precomputed base point by a scalar:
+ * scaled = scalar*base.
+ *
+ * Otherwise equivalent to ristretto255_precomputed_scalarmul, but faster
+ * at the expense of being variable time.  It uses the same tables.
+ *
+ * @param [out] scaled The scaled point base*scalar
+ * @param [in] base The point to be scaled.
+ * @param [in] scalar The scalar to multiply by.
+ *
+ * @warning: This function takes variable time, and may leak the scalar
+ * used.  It is designed for signature verification.
+ */
+void ristretto255_precomputed_scalarmul_non_secret (
+    ristretto255_point_t *scaled,
+    const ristretto255_precomputed_s *base,
+    const ristretto255_scalar_t *scalar
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
 /**
  * @brief Multiply two base points by two scalars:
  * scaled = scalar1*base1 + scalar2*base2.
@@ -581,6 +917,671 @@ void ristretto255_base_double_scalarmul_non_secret (
     const ristretto255_scalar_t *scalar2
 ) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Precompute a wNAF table of a point, to be reused by many calls to
+ * ristretto255_base_double_scalarmul_non_secret_precomputed.
+ *
+ * The table holds 2^table_bits odd multiples of the base, 192 bytes each.
+ * Building it also takes 2^table_bits * 384 bytes of scratch space, which is
+ * erased and freed before returning.
+ * ristretto255_base_double_scalarmul_non_secret uses table_bits = 3 for the
+ * table it builds on every call.  A long-lived base can afford more: 5 or 6
+ * saves about a third of the additions.
+ *
+ * @param [out] pre The new table, to be freed with
+ * ristretto255_wnaf_precomputed_destroy.  NULL on failure.
+ * @param [in] base The point.
+ * @param [in] table_bits The window, from 1 to RISTRETTO255_WNAF_MAX_TABLE_BITS.
+ * @param [in] allocator Where to allocate the table, or NULL for the heap.
+ *
+ * @retval RISTRETTO_SUCCESS The table was created.
+ * @retval RISTRETTO_FAILURE table_bits was out of range, or the table
+ * couldn't be allocated.
+ */
+ristretto_error_t ristretto255_wnaf_precomputed_create (
+    ristretto255_wnaf_precomputed_t **pre,
+    const ristretto255_point_t *base,
+    unsigned int table_bits,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Erase and free a table from ristretto255_wnaf_precomputed_create.
+ * @param [in] pre The table.  May be NULL.
+ * @param [in] allocator The allocator it was created with.
+ */
+void ristretto255_wnaf_precomputed_destroy (
+    ristretto255_wnaf_precomputed_t *pre,
+    const ristretto255_allocator_t *allocator
+);
+
+/**
+ * @brief Bytes needed for a wNAF table with the given window, or 0 if
+ * table_bits is out of range.  Together with ristretto255_wnaf_precompute
+ * this lets a caller keep tables in memory it manages itself.
+ */
+size_t ristretto255_sizeof_wnaf_precomputed (
+    unsigned int table_bits
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Bytes of scratch space that ristretto255_wnaf_precompute takes from
+ * its allocator, in one allocation, or 0 if table_bits is out of range.
+ */
+size_t ristretto255_wnaf_precompute_scratch_size (
+    unsigned int table_bits
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Build a wNAF table in place, as ristretto255_wnaf_precomputed_create
+ * does.  Don't pass the result to ristretto255_wnaf_precomputed_destroy.
+ *
+ * @param [out] pre Where to build the table:
+ * ristretto255_sizeof_wnaf_precomputed(table_bits) bytes, aligned to
+ * ristretto255_alignof_precomputed_s.
+ * @param [in] base The point.
+ * @param [in] table_bits The window, from 1 to RISTRETTO255_WNAF_MAX_TABLE_BITS.
+ * @param [in] allocator Where to allocate scratch space, or NULL for the heap.
+ *
+ * @retval RISTRETTO_SUCCESS The table was built.
+ * @retval RISTRETTO_FAILURE table_bits was out of range, or the scratch
+ * space couldn't be allocated.
+ */
+ristretto_error_t ristretto255_wnaf_precompute (
+    ristretto255_wnaf_precomputed_t *pre,
+    const ristretto255_point_t *base,
+    unsigned int table_bits,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief The window a wNAF table was built with.
+ * @param [in] pre The table.
+ * @return Its table_bits.
+ */
+unsigned int ristretto255_wnaf_precomputed_table_bits (
+    const ristretto255_wnaf_precomputed_t *pre
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/**
+ * @brief Multiply two base points by two scalars:
+ * scaled = scalar1*ristretto255_point_base + scalar2*base2.
+ *
+ * Equivalent to ristretto255_base_double_scalarmul_non_secret, but with the
+ * second base's table built once ahead of time.
+ *
+ * @param [out] combo The linear combination scalar1*base + scalar2*base2.
+ * @param [in] scalar1 A first scalar to multiply by.
+ * @param [in] base2 A table of the second point to be scaled.
+ * @param [in] scalar2 A second scalar to multiply by.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for signature verification.
+ */
+void ristretto255_base_double_scalarmul_non_secret_precomputed (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalar1,
+    const ristretto255_wnaf_precomputed_t *base2,
+    const ristretto255_scalar_t *scalar2
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Multiply many base points by many scalars:
+ * combo = scalars[0]*bases[0] + ... + scalars[n-1]*bases[n-1].
+ *
+ * Equivalent to n calls to ristretto255_point_scalarmul followed by
+ * additions, but much faster because the doublings are shared between
+ * all of the terms.
+ *
+ * @param [out] combo The linear combination.
+ * @param [in] scalars An array of n scalars.
+ * @param [in] bases An array of n points to be scaled.
+ * @param [in] n The number of terms.  If zero, combo is the identity.
+ *
+ * @retval RISTRETTO_SUCCESS The multiplication succeeded.
+ * @retval RISTRETTO_FAILURE Scratch space couldn't be allocated, and
+ * combo was not written.
+ */
+ristretto_error_t ristretto255_multiscalar_mul (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Multiply many base points by many scalars:
+ * combo = scalars[0]*bases[0] + ... + scalars[n-1]*bases[n-1].
+ *
+ * Otherwise equivalent to ristretto255_multiscalar_mul, but faster at the
+ * expense of being variable time.  Small batches use interleaved wNAF, and
+ * large ones use Pippenger's bucket method.
+ *
+ * @param [out] combo The linear combination.
+ * @param [in] scalars An array of n scalars.
+ * @param [in] bases An array of n points to be scaled.
+ * @param [in] n The number of terms.  If zero, combo is the identity.
+ *
+ * @retval RISTRETTO_SUCCESS The multiplication succeeded.
+ * @retval RISTRETTO_FAILURE Scratch space couldn't be allocated, and
+ * combo was not written.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for batch signature verification.
+ */
+ristretto_error_t ristretto255_multiscalar_mul_non_secret (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief As ristretto255_multiscalar_mul, but takes its scratch space from
+ * allocator, or from the heap if it is NULL.
+ */
+ristretto_error_t ristretto255_multiscalar_mul_with_allocator (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief As ristretto255_multiscalar_mul_non_secret, but takes its scratch
+ * space from allocator, or from the heap if it is NULL.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for batch signature verification.
+ */
+ristretto_error_t ristretto255_multiscalar_mul_non_secret_with_allocator (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief As ristretto255_multiscalar_mul_with_allocator, but splits the
+ * terms into fixed-size groups and runs them on executor.  The scratch
+ * space is still a single allocation within the same per-term bound.
+ */
+ristretto_error_t ristretto255_multiscalar_mul_parallel (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief As ristretto255_multiscalar_mul_non_secret_with_allocator, but runs
+ * the work on executor: each Pippenger window accumulates its buckets as a
+ * separate task.  Batches too small for Pippenger run on the calling thread.
+ * The scratch space is still a single allocation within the same per-term
+ * bound.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for batch signature verification.
+ */
+ristretto_error_t ristretto255_multiscalar_mul_non_secret_parallel (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief Bytes of scratch space that ristretto255_multiscalar_mul_with_scratch
+ * and ristretto255_multiscalar_mul_non_secret_with_scratch need for n terms,
+ * with or without an executor, at any alignment.  A buffer of this size for
+ * the largest n can be reused for every smaller call.
+ */
+size_t ristretto255_multiscalar_scratch_size (
+    size_t n
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief As ristretto255_multiscalar_mul_parallel, but in caller-owned
+ * scratch space instead of an allocation, so that it never allocates.  The
+ * scratch is erased before returning.
+ *
+ * @param [out] combo The linear combination.
+ * @param [in] scalars The scalars.
+ * @param [in] bases The points to be scaled.
+ * @param [in] n The number of terms.
+ * @param [in] scratch The scratch space, of any alignment.
+ * @param [in] scratch_bytes Its size, at least
+ * ristretto255_multiscalar_scratch_size(n).
+ * @param [in] executor Where to run the tasks, or NULL for this thread.
+ *
+ * @retval RISTRETTO_SUCCESS The multiplication succeeded.
+ * @retval RISTRETTO_FAILURE The scratch space was too small, and combo was
+ * not written.
+ */
+ristretto_error_t ristretto255_multiscalar_mul_with_scratch (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n,
+    void *scratch,
+    size_t scratch_bytes,
+    const ristretto255_executor_t *executor
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief As ristretto255_multiscalar_mul_non_secret_parallel, but in
+ * caller-owned scratch space instead of an allocation.  Only public data
+ * is left in the scratch, which is not erased.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for batch signature verification.
+ */
+ristretto_error_t ristretto255_multiscalar_mul_non_secret_with_scratch (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_t *bases,
+    size_t n,
+    void *scratch,
+    size_t scratch_bytes,
+    const ristretto255_executor_t *executor
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief Precompute comb tables of a fixed vector of generators, such as
+ * the g_i and h of Pedersen vector commitments, to be reused by many calls
+ * to ristretto255_generators_mul.
+ *
+ * Each generator gets a single comb of the given number of teeth, so its
+ * table holds 2^(teeth-1) points of 192 bytes.  A multiply then costs about
+ * 253/teeth additions per term.  The generators are multiplied 64 at a
+ * time, so that each group's tables stay in cache, and the generators of a
+ * group share their doublings: ceil(253/teeth) doublings per group of 64, or
+ * about one for every 64 additions.  ristretto255_multiscalar_mul
+ * takes 64 additions per term and 252 doublings.  Constant-time lookups read the whole of
+ * each generator's table, so ristretto255_generators_mul is fastest with 5
+ * teeth; ristretto255_generators_mul_non_secret doesn't, and is fastest
+ * with 8.
+ *
+ * @param [out] gens The new tables, to be freed with
+ * ristretto255_generators_destroy.  NULL on failure.
+ * @param [in] points The generators.
+ * @param [in] n The number of generators.
+ * @param [in] teeth The comb size, from 1 to RISTRETTO255_GENERATORS_MAX_TEETH.
+ * @param [in] allocator Where to allocate the tables and scratch space, or
+ * NULL for the heap.
+ *
+ * @retval RISTRETTO_SUCCESS The tables were created.
+ * @retval RISTRETTO_FAILURE teeth was out of range, or the tables couldn't
+ * be allocated.
+ */
+ristretto_error_t ristretto255_generators_create (
+    ristretto255_generators_t **gens,
+    const ristretto255_point_t *points,
+    size_t n,
+    unsigned int teeth,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Erase and free tables from ristretto255_generators_create.
+ * @param [in] gens The tables.  May be NULL.
+ * @param [in] allocator The allocator they were created with.
+ */
+void ristretto255_generators_destroy (
+    ristretto255_generators_t *gens,
+    const ristretto255_allocator_t *allocator
+);
+
+/**
+ * @brief The number of generators that tables were created with.
+ * @param [in] gens The tables.
+ */
+size_t ristretto255_generators_count (
+    const ristretto255_generators_t *gens
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/**
+ * @brief The comb size that tables were created with.
+ * @param [in] gens The tables.
+ */
+unsigned int ristretto255_generators_teeth (
+    const ristretto255_generators_t *gens
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/**
+ * @brief Bytes in the tables of n generators with the given comb size, or 0
+ * if teeth is out of range or the size doesn't fit in a size_t.
+ */
+size_t ristretto255_sizeof_generators (
+    size_t n,
+    unsigned int teeth
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Multiply the first n generators by n scalars:
+ * combo = scalars[0]*points[0] + ... + scalars[n-1]*points[n-1].
+ *
+ * Equivalent to ristretto255_multiscalar_mul on the points the tables were
+ * created with, but faster.  No scratch space is allocated.
+ *
+ * @param [out] combo The linear combination.
+ * @param [in] gens The generators' tables.
+ * @param [in] scalars An array of n scalars.
+ * @param [in] n The number of terms.  If zero, combo is the identity.
+ *
+ * @retval RISTRETTO_SUCCESS The multiplication succeeded.
+ * @retval RISTRETTO_FAILURE There are fewer than n generators, and combo
+ * was not written.
+ */
+ristretto_error_t ristretto255_generators_mul (
+    ristretto255_point_t *combo,
+    const ristretto255_generators_t *gens,
+    const ristretto255_scalar_t *scalars,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Multiply the first n generators by n scalars:
+ * combo = scalars[0]*points[0] + ... + scalars[n-1]*points[n-1].
+ *
+ * Otherwise equivalent to ristretto255_generators_mul, but faster at the
+ * expense of being variable time.
+ *
+ * @param [out] combo The linear combination.
+ * @param [in] gens The generators' tables.
+ * @param [in] scalars An array of n scalars.
+ * @param [in] n The number of terms.  If zero, combo is the identity.
+ *
+ * @retval RISTRETTO_SUCCESS The multiplication succeeded.
+ * @retval RISTRETTO_FAILURE There are fewer than n generators, and combo
+ * was not written.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for verifiers.
+ */
+ristretto_error_t ristretto255_generators_mul_non_secret (
+    ristretto255_point_t *combo,
+    const ristretto255_generators_t *gens,
+    const ristretto255_scalar_t *scalars,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Create a batch of n points, all the identity.
+ *
+ * @param [out] batch The new batch, to be freed with
+ * ristretto255_point_batch_destroy.  NULL on failure.
+ * @param [in] n The number of points.
+ * @param [in] allocator Where to allocate the batch, or NULL for the heap.
+ *
+ * @retval RISTRETTO_SUCCESS The batch was created.
+ * @retval RISTRETTO_FAILURE The memory couldn't be allocated.
+ */
+ristretto_error_t ristretto255_point_batch_create (
+    ristretto255_point_batch_t **batch,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Erase and free a batch from ristretto255_point_batch_create.
+ * @param [in] batch The batch.  May be NULL.
+ * @param [in] allocator The allocator it was created with.
+ */
+void ristretto255_point_batch_destroy (
+    ristretto255_point_batch_t *batch,
+    const ristretto255_allocator_t *allocator
+);
+
+/** The number of points in a batch. */
+size_t ristretto255_point_batch_count (
+    const ristretto255_point_batch_t *batch
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/**
+ * @brief Copy points into a batch: point first+i of the batch becomes pts[i].
+ *
+ * @param [out] batch The batch.
+ * @param [in] first The first point of the batch to write.
+ * @param [in] pts The points.
+ * @param [in] n The number of points.
+ *
+ * @retval RISTRETTO_SUCCESS The points were copied.
+ * @retval RISTRETTO_FAILURE The batch has fewer than first+n points.
+ */
+ristretto_error_t ristretto255_point_batch_pack (
+    ristretto255_point_batch_t *batch,
+    size_t first,
+    const ristretto255_point_t *pts,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/**
+ * @brief Copy points out of a batch: pts[i] becomes point first+i of the
+ * batch.
+ *
+ * @param [out] pts The points.
+ * @param [in] batch The batch.
+ * @param [in] first The first point of the batch to read.
+ * @param [in] n The number of points.
+ *
+ * @retval RISTRETTO_SUCCESS The points were copied.
+ * @retval RISTRETTO_FAILURE The batch has fewer than first+n points.
+ */
+ristretto_error_t ristretto255_point_batch_unpack (
+    ristretto255_point_t *pts,
+    const ristretto255_point_batch_t *batch,
+    size_t first,
+    size_t n
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/**
+ * @brief Add two batches pointwise: out[i] = a[i] + b[i].  The batches
+ * must all have the same number of points, and may be the same batch.
+ *
+ * @retval RISTRETTO_SUCCESS The points were added.
+ * @retval RISTRETTO_FAILURE The batches have different sizes.
+ */
+ristretto_error_t ristretto255_point_batch_add (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a,
+    const ristretto255_point_batch_t *b
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Double a batch pointwise: out[i] = 2*a[i].
+ *
+ * @retval RISTRETTO_SUCCESS The points were doubled.
+ * @retval RISTRETTO_FAILURE The batches have different sizes.
+ */
+ristretto_error_t ristretto255_point_batch_double (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Negate a batch pointwise: out[i] = -a[i].
+ *
+ * @retval RISTRETTO_SUCCESS The points were negated.
+ * @retval RISTRETTO_FAILURE The batches have different sizes.
+ */
+ristretto_error_t ristretto255_point_batch_negate (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Select between two batches pointwise in constant time:
+ * out[i] = pick_b[i] ? b[i] : a[i].
+ *
+ * @param [out] out The selected points.
+ * @param [in] a The points to take where pick_b[i] is false.
+ * @param [in] b The points to take where pick_b[i] is true.
+ * @param [in] pick_b One choice for each point.
+ *
+ * @retval RISTRETTO_SUCCESS The points were selected.
+ * @retval RISTRETTO_FAILURE The batches have different sizes.
+ */
+ristretto_error_t ristretto255_point_batch_cond_sel (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a,
+    const ristretto255_point_batch_t *b,
+    const ristretto_bool_t *pick_b
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Multiply each point of a batch by its own secret scalar:
+ * out[i] = scalars[i]*a[i].  Equivalent to ristretto255_point_scalarmul
+ * on each point, but backends with an 8-way field run a whole block of
+ * multiplications side by side.
+ *
+ * @param [out] out The products.
+ * @param [in] a The points to be scaled.
+ * @param [in] scalars One scalar for each point.
+ *
+ * @retval RISTRETTO_SUCCESS The points were multiplied.
+ * @retval RISTRETTO_FAILURE The batches have different sizes.
+ */
+ristretto_error_t ristretto255_point_batch_scalarmul (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a,
+    const ristretto255_scalar_t *scalars
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Encode every point of a batch, as ristretto255_point_encode_batch.
+ *
+ * @param [out] out One encoding for each point.
+ * @param [in] batch The points.
+ */
+void ristretto255_point_batch_encode (
+    uint8_t (*out)[RISTRETTO255_SER_BYTES],
+    const ristretto255_point_batch_t *batch
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Decode one point for each point of a batch, as
+ * ristretto255_point_decode_batch.
+ *
+ * @param [out] batch The decoded points.  Those which failed to decode are
+ * undefined.
+ * @param [out] results The result of decoding each element.
+ * @param [in] ser The serialized points, one for each point of the batch,
+ * laid out back to back.
+ * @param [in] allow_identity RISTRETTO_TRUE if the identity is a legal input.
+ *
+ * @retval RISTRETTO_SUCCESS Every element was decoded successfully.
+ * @retval RISTRETTO_FAILURE At least one element didn't represent a point;
+ * consult results to find out which.
+ */
+ristretto_error_t ristretto255_point_batch_decode (
+    ristretto255_point_batch_t *batch,
+    ristretto_error_t *results,
+    const uint8_t *ser,
+    ristretto_bool_t allow_identity
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief Hash one input to the curve for each point of a batch, as
+ * ristretto255_point_from_hash_uniform_batch.
+ *
+ * @param [out] batch The points.
+ * @param [in] hashed_data One output of some hash function for each point,
+ * 2*RISTRETTO255_HASH_BYTES each, laid out back to back.
+ */
+void ristretto255_point_batch_from_hash_uniform (
+    ristretto255_point_batch_t *batch,
+    const unsigned char *hashed_data
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
+/**
+ * @brief As ristretto255_multiscalar_mul_parallel, with the bases taken
+ * from a batch: combo = sum scalars[i]*bases[i].
+ *
+ * @param [out] combo The linear combination.
+ * @param [in] scalars One scalar for each point of the batch.
+ * @param [in] bases The points to be scaled.
+ * @param [in] allocator Where to allocate scratch space, or NULL for the
+ * heap.
+ * @param [in] executor Where to run the tasks, or NULL for this thread.
+ *
+ * @retval RISTRETTO_SUCCESS The multiplication succeeded.
+ * @retval RISTRETTO_FAILURE The scratch space couldn't be allocated, and
+ * combo was not written.
+ */
+ristretto_error_t ristretto255_point_batch_multiscalar_mul (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_batch_t *bases,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief As ristretto255_multiscalar_mul_non_secret_parallel, with the
+ * bases taken from a batch.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for verifiers.
+ */
+ristretto_error_t ristretto255_point_batch_multiscalar_mul_non_secret (
+    ristretto255_point_t *combo,
+    const ristretto255_scalar_t *scalars,
+    const ristretto255_point_batch_t *bases,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
+/**
+ * @brief Check n equations s[i]*B == R[i] + c[i]*A[i] at once, where B is
+ * the base point, as in Schnorr signature verification.
+ *
+ * The equations are combined with random 128-bit weights from rng into one
+ * multiscalar multiply and one comparison.  A batch containing a false
+ * equation passes with probability at most 2^-128.  If the batch fails and
+ * bad is not NULL, it is split in halves recursively to find the false
+ * equations; this costs about 2*log2(n) more multiscalar multiplies for
+ * each one.
+ *
+ * @param [out] bad If not NULL, the indices of the false equations, in
+ * increasing order; it must have room for n.
+ * @param [out] nbad If bad is not NULL, the number of indices written.
+ * @param [in] s The scalars multiplying the base point.
+ * @param [in] R The points on their own.
+ * @param [in] c The scalars multiplying A.
+ * @param [in] A The points multiplied by c.
+ * @param [in] n The number of equations.
+ * @param [in] rng Where the weights come from.
+ * @param [in] allocator Where to allocate scratch space, or NULL for the
+ * heap.
+ * @param [in] executor Where to run the multiscalar multiplies, or NULL.
+ *
+ * @retval RISTRETTO_SUCCESS Every equation holds.
+ * @retval RISTRETTO_FAILURE At least one equation is false, or scratch
+ * space couldn't be allocated, in which case *nbad is 0.
+ *
+ * @warning: This function takes variable time, and may leak the scalars
+ * used.  It is designed for batch signature verification.
+ */
+ristretto_error_t ristretto255_batch_verify (
+    size_t *bad,
+    size_t *nbad,
+    const ristretto255_scalar_t *s,
+    const ristretto255_point_t *R,
+    const ristretto255_scalar_t *c,
+    const ristretto255_point_t *A,
+    size_t n,
+    const ristretto255_rng_t *rng,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) RISTRETTO_WARN_UNUSED RISTRETTO_NOINLINE;
+
 /**
  * @brief Constant-time decision between two points.  If pick_b
  * is zero, out = a; else out = b.
@@ -651,6 +1652,35 @@ void ristretto255_point_debugging_pscale (
     const unsigned char factor[RISTRETTO255_SER_BYTES]
 ) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * Counts of the field and point operations done by one thread, for checking
+ * what an API call costs.  4- and 8-way field operations count once per
+ * lane, and the multiplies and squarings inside gf_isr are counted too.
+ * Each kind of point addition counts as a point_add.
+ */
+typedef struct {
+    uint64_t gf_mul, gf_sqr, gf_isr, point_add, point_double;
+} ristretto255_counters_t;
+
+/**
+ * @brief Get the calling thread's operation counts.
+ *
+ * The library only counts when it is built with COUNTERS=1, which slows it
+ * down a little.
+ *
+ * @param [out] counters The counts since the thread started, or since it
+ * last called ristretto255_counters_reset.  Zeros if the library doesn't count.
+ *
+ * @retval RISTRETTO_SUCCESS The library was built to count.
+ * @retval RISTRETTO_FAILURE It wasn't.
+ */
+ristretto_error_t ristretto255_counters_get (
+    ristretto255_counters_t *counters
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/** @brief Reset the calling thread's operation counts to zero. */
+void ristretto255_counters_reset (void);
+
 /**
  * @brief Almost-Elligator-like hash to curve.
  *
@@ -697,6 +1727,26 @@ void ristretto255_point_from_hash_uniform (
     const unsigned char hashed_data[2*RISTRETTO255_HASH_BYTES]
 ) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
 
+/**
+ * @brief Hash an array of inputs to the curve.
+ *
+ * Equivalent to calling ristretto255_point_from_hash_uniform on each
+ * input.  Each of the 2n Elligator maps needs its own inverse square root,
+ * which backends with an 8-way field compute eight at a time.  The output
+ * can go straight to ristretto255_point_encode_batch, which does the same
+ * for the encodings.
+ *
+ * @param [out] pts The n points.
+ * @param [in] hashed_data n outputs of some hash function,
+ * 2*RISTRETTO255_HASH_BYTES each, laid out back to back.
+ * @param [in] n The number of inputs.
+ */
+void ristretto255_point_from_hash_uniform_batch (
+    ristretto255_point_t *pts,
+    const unsigned char *hashed_data,
+    size_t n
+) RISTRETTO_NONNULL RISTRETTO_NOINLINE;
+
 /**
  * @brief Inverse of elligator-like hash to curve.
  *
@@ -774,6 +1824,16 @@ void ristretto255_precomputed_destroy (
     ristretto255_precomputed_s *pre
 ) RISTRETTO_NONNULL;
 
+/**
+ * @brief Erase and free a table from ristretto255_precomputed_create.
+ * @param [in] pre The table.  May be NULL.
+ * @param [in] allocator The allocator it was created with.
+ */
+void ristretto255_precomputed_free (
+    ristretto255_precomputed_s *pre,
+    const ristretto255_allocator_t *allocator
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
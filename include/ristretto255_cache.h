@@ -0,0 +1,105 @@
+/**
+ * @file ristretto255_cache.h
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Bounded cache from point encodings to decoded points and their
+ * wNAF tables, for verifiers which see the same public keys again and again.
+ *
+ * The cache is safe to share between threads.  It is split into shards
+ * with a lock each, and every encoding maps to one set of a few entries,
+ * which are replaced using the CLOCK policy.  All of its memory, including
+ * the scratch space for building tables, is allocated when it is created.
+ */
+
+#ifndef __RISTRETTO255_CACHE_H__
+#define __RISTRETTO255_CACHE_H__ 1
+
+#include <ristretto255.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A point cache.  Opaque; see ristretto255_point_cache_create. */
+typedef struct ristretto255_point_cache_s ristretto255_point_cache_t;
+
+/**
+ * @brief Create a point cache.
+ *
+ * @param [out] cache The new cache, to be freed with
+ * ristretto255_point_cache_destroy.  NULL on failure.
+ * @param [in] max_bytes The most memory the cache may use.  Each entry
+ * takes a little more than ristretto255_sizeof_wnaf_precomputed(table_bits),
+ * and each shard ristretto255_wnaf_precompute_scratch_size(table_bits).
+ * @param [in] table_bits The window of the cached wNAF tables, as for
+ * ristretto255_wnaf_precomputed_create.
+ * @param [in] allocator Where to allocate the cache, or NULL for the heap.
+ * Nothing else is allocated until the cache is destroyed.
+ *
+ * @retval RISTRETTO_SUCCESS The cache was created.
+ * @retval RISTRETTO_FAILURE table_bits was out of range, max_bytes was too
+ * small for even one set of entries, or the memory couldn't be allocated.
+ */
+ristretto_error_t ristretto255_point_cache_create (
+    ristretto255_point_cache_t **cache,
+    size_t max_bytes,
+    unsigned int table_bits,
+    const ristretto255_allocator_t *allocator
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Free a cache.  No tables from it may still be in use.
+ * @param [in] cache The cache.  May be NULL.
+ * @param [in] allocator The allocator it was created with.
+ */
+void ristretto255_point_cache_destroy (
+    ristretto255_point_cache_t *cache,
+    const ristretto255_allocator_t *allocator
+);
+
+/**
+ * @brief Decode a point through the cache, and get its wNAF table for
+ * ristretto255_base_double_scalarmul_non_secret_precomputed.
+ *
+ * On a miss the point is decoded, and its table built in the shard's
+ * scratch space, outside the lock before being added to the cache.  Builds
+ * in the same shard take turns with the scratch space.  Invalid encodings are not cached.
+ *
+ * @param [out] pt The decoded point.
+ * @param [out] table The point's table, which stays valid until it is given
+ * back with ristretto255_point_cache_release.  NULL if every entry the
+ * point could use is held by another caller, or the table couldn't be
+ * built; pt is still decoded in that case.
+ * @param [in] cache The cache.
+ * @param [in] ser The encoding.
+ * @param [in] allow_identity As for ristretto255_point_decode.
+ *
+ * @retval RISTRETTO_SUCCESS The encoding was valid.
+ * @retval RISTRETTO_FAILURE As for ristretto255_point_decode; *table is
+ * NULL.
+ */
+ristretto_error_t ristretto255_point_cache_decode (
+    ristretto255_point_t *pt,
+    const ristretto255_wnaf_precomputed_t **table,
+    ristretto255_point_cache_t *cache,
+    const unsigned char ser[RISTRETTO255_SER_BYTES],
+    ristretto_bool_t allow_identity
+) RISTRETTO_WARN_UNUSED RISTRETTO_NONNULL;
+
+/**
+ * @brief Give back a table from ristretto255_point_cache_decode, so that
+ * its entry can be replaced again.
+ * @param [in] cache The cache.
+ * @param [in] table The table.  May be NULL.
+ */
+void ristretto255_point_cache_release (
+    ristretto255_point_cache_t *cache,
+    const ristretto255_wnaf_precomputed_t *table
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __RISTRETTO255_CACHE_H__ */
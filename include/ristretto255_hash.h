@@ -0,0 +1,134 @@
+/**
+ * @file ristretto255_hash.h
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Streaming hash to the group: absorb a message of any length a piece
+ * at a time, then map its digest to a point.
+ *
+ * The default hash is SHA-512, whose 64-byte digest is exactly the input of
+ * ristretto255_point_from_hash_uniform.  Any other hash with a 64-byte
+ * output can be plugged in instead.  Digests can also be taken out as bytes
+ * and mapped many at a time by ristretto255_point_from_hash_uniform_batch.
+ */
+
+#ifndef __RISTRETTO255_HASH_H__
+#define __RISTRETTO255_HASH_H__ 1
+
+#include <ristretto255.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of bytes in a SHA-512 digest. */
+#define RISTRETTO255_SHA512_BYTES 64
+
+/** The state of a SHA-512 computation. */
+typedef struct {
+    /** @cond internal */
+    uint64_t state[8];
+    uint64_t bytes;
+    unsigned char block[128];
+    /** @endcond */
+} ristretto255_sha512_ctx_t;
+
+/**
+ * Caller-supplied hash for ristretto255_hash_to_point_init.  Its ctx holds
+ * the state of a single computation, so each stream needs its own.
+ */
+typedef struct {
+    /** Start a new computation. */
+    void (*init)(void *ctx);
+    /** Absorb len bytes of data. */
+    void (*update)(void *ctx, const unsigned char *data, size_t len);
+    /** Write the 2*RISTRETTO255_HASH_BYTES byte digest of everything absorbed. */
+    void (*final)(void *ctx, unsigned char out[2*RISTRETTO255_HASH_BYTES]);
+    /** Passed to init, update and final. */
+    void *ctx;
+} ristretto255_hash_t;
+
+/** A message being hashed to the group. */
+typedef struct {
+    /** @cond internal */
+    const ristretto255_hash_t *hash;
+    ristretto255_sha512_ctx_t sha512;
+    /** @endcond */
+} ristretto255_hash_to_point_ctx_t;
+
+/** Start a SHA-512 computation. */
+void ristretto255_sha512_init (
+    ristretto255_sha512_ctx_t *ctx
+) RISTRETTO_NONNULL;
+
+/** Absorb len bytes of data into a SHA-512 computation. */
+void ristretto255_sha512_update (
+    ristretto255_sha512_ctx_t *ctx,
+    const unsigned char *data,
+    size_t len
+) RISTRETTO_NONNULL;
+
+/**
+ * @brief Finish a SHA-512 computation.  The state is erased, and must be
+ * initialized again before reuse.
+ *
+ * @param [in] ctx The computation.
+ * @param [out] out The digest.
+ */
+void ristretto255_sha512_final (
+    ristretto255_sha512_ctx_t *ctx,
+    unsigned char out[RISTRETTO255_SHA512_BYTES]
+) RISTRETTO_NONNULL;
+
+/**
+ * @brief Start hashing a message to the group.
+ *
+ * @param [out] ctx The computation.
+ * @param [in] hash The hash to use, which must outlive the computation, or
+ * NULL for SHA-512.
+ */
+void ristretto255_hash_to_point_init (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    const ristretto255_hash_t *hash
+);
+
+/** Absorb the next len bytes of the message. */
+void ristretto255_hash_to_point_update (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    const unsigned char *data,
+    size_t len
+) RISTRETTO_NONNULL;
+
+/**
+ * @brief Finish hashing a message to the group:
+ * pt = ristretto255_point_from_hash_uniform(hash(message)).  The state is
+ * erased, and must be initialized again before reuse.
+ *
+ * @param [in] ctx The computation.
+ * @param [out] pt The point.
+ */
+void ristretto255_hash_to_point_final (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    ristretto255_point_t *pt
+) RISTRETTO_NONNULL;
+
+/**
+ * @brief Finish hashing a message, but stop at the digest.  Digests written
+ * back to back can be mapped together by
+ * ristretto255_point_from_hash_uniform_batch, which is cheaper than
+ * calling ristretto255_hash_to_point_final on each.  The state is erased,
+ * and must be initialized again before reuse.
+ *
+ * @param [in] ctx The computation.
+ * @param [out] out The digest.
+ */
+void ristretto255_hash_to_point_final_digest (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    unsigned char out[2*RISTRETTO255_HASH_BYTES]
+) RISTRETTO_NONNULL;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __RISTRETTO255_HASH_H__ */
@@ -0,0 +1,118 @@
+/**
+ * @file ristretto255_tables.h
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief A binary format for precomputed tables, which can be mapped
+ * straight into memory instead of being rebuilt at every start.
+ *
+ * A table file holds any number of comb tables, wNAF tables, point vectors
+ * and generator tables, in the same layout as in memory.  It is tagged with a version and
+ * with the field representation and comb geometry it was written with, and
+ * only a build with the same ones will read it; others should regenerate
+ * their tables.  Reading a file copies nothing: the tables come back as
+ * pointers into the caller's buffer, typically from mmap.
+ *
+ * The file also carries a checksum, which catches truncation and corruption
+ * but not tampering.  Files should only be read from trusted locations.
+ */
+
+#ifndef __RISTRETTO255_TABLES_H__
+#define __RISTRETTO255_TABLES_H__ 1
+
+#include <ristretto255.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The version of the format written by ristretto255_tables_serialize. */
+#define RISTRETTO255_TABLES_VERSION 1
+
+/** Alignment that buffers given to ristretto255_tables_view must have.
+ * Page-aligned memory from mmap always does.
+ */
+#define RISTRETTO255_TABLES_ALIGNMENT 64
+
+/** What a table is. */
+typedef enum {
+    RISTRETTO255_TABLE_COMB   = 1, /**< A ristretto255_precomputed_s. */
+    RISTRETTO255_TABLE_WNAF   = 2, /**< A ristretto255_wnaf_precomputed_t. */
+    RISTRETTO255_TABLE_POINTS = 3, /**< An array of ristretto255_point_t. */
+    RISTRETTO255_TABLE_GENERATORS = 4 /**< A ristretto255_generators_t.  Don't
+                                       *   destroy one found in a buffer. */
+} ristretto255_table_kind_t;
+
+/** A table to write, or one found in a buffer. */
+typedef struct {
+    ristretto255_table_kind_t kind; /**< What the table is. */
+    size_t count;                   /**< Points in a RISTRETTO255_TABLE_POINTS
+                                     *   table; 1 for the others. */
+    const void *table;              /**< The table itself. */
+} ristretto255_table_ref_t;
+
+/**
+ * @brief Size of the file ristretto255_tables_serialize writes.
+ * @param [in] tables The tables to write.
+ * @param [in] n The number of tables.
+ * @return The size in bytes, or 0 if a table has an unknown kind, or a
+ * count other than 1 for a table that isn't a point vector.
+ */
+size_t ristretto255_tables_serialized_bytes (
+    const ristretto255_table_ref_t *tables,
+    size_t n
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Write tables in the file format.  The padding in field elements
+ * is written as zeros, so the same tables always give the same bytes.
+ *
+ * @param [out] out Where to write the file.
+ * @param [in] out_bytes The space at out, at least
+ * ristretto255_tables_serialized_bytes(tables, n).
+ * @param [in] tables The tables to write.
+ * @param [in] n The number of tables.
+ *
+ * @retval RISTRETTO_SUCCESS The file was written.
+ * @retval RISTRETTO_FAILURE The tables were invalid, as for
+ * ristretto255_tables_serialized_bytes, or out_bytes was too small.
+ */
+ristretto_error_t ristretto255_tables_serialize (
+    unsigned char *out,
+    size_t out_bytes,
+    const ristretto255_table_ref_t *tables,
+    size_t n
+) RISTRETTO_WARN_UNUSED;
+
+/**
+ * @brief Find the tables in a file, without copying them.  The results
+ * point into buf, so they are only valid while it is.
+ *
+ * @param [out] tables The tables, in the order they were written.  May be
+ * NULL if *n is 0, to count them.
+ * @param [in,out] n On input, the space at tables.  On output, the number
+ * of tables in the file, even if that is more than there was space for.
+ * @param [in] buf The file, aligned to RISTRETTO255_TABLES_ALIGNMENT.
+ * @param [in] buf_bytes The size of the file.
+ * @param [in] verify Whether to check the checksum.  This reads the whole
+ * file, which defeats lazy paging; the header and the table sizes are
+ * always checked.
+ *
+ * @retval RISTRETTO_SUCCESS The tables were found.
+ * @retval RISTRETTO_FAILURE buf is misaligned or too short, it isn't a
+ * table file, it has another version, field representation or comb
+ * geometry, its checksum is wrong, or there are more than *n tables.
+ */
+ristretto_error_t ristretto255_tables_view (
+    ristretto255_table_ref_t *tables,
+    size_t *n,
+    const unsigned char *buf,
+    size_t buf_bytes,
+    ristretto_bool_t verify
+) RISTRETTO_WARN_UNUSED;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __RISTRETTO255_TABLES_H__ */
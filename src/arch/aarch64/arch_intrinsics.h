@@ -0,0 +1,41 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#ifndef __ARCH_AARCH64_ARCH_INTRINSICS_H__
+#define __ARCH_AARCH64_ARCH_INTRINSICS_H__
+
+#ifndef __aarch64__
+#error "ARCH=aarch64 requires a compiler targeting aarch64"
+#endif
+
+#define ARCH_WORD_BITS 64
+
+#include <stdint.h>
+
+static __inline__ __attribute((always_inline,unused))
+uint64_t word_is_zero(uint64_t a) {
+    uint64_t ret;
+    __asm__("cmp %1, #0\n\tcsetm %0, eq" : "=r"(ret) : "r"(a) : "cc");
+    return ret;
+}
+
+/* Compilers turn these into MUL/UMULH and ADDS/ADC pairs, and schedule them
+ * better than inline asm would.
+ */
+static __inline__ __attribute((always_inline,unused))
+__uint128_t widemul(uint64_t a, uint64_t b) {
+    return ((__uint128_t)a) * b;
+}
+
+static __inline__ __attribute((always_inline,unused))
+void mac(__uint128_t *acc, uint64_t a, uint64_t b) {
+    *acc += ((__uint128_t)a) * b;
+}
+
+static __inline__ __attribute((always_inline,unused))
+uint64_t shrld(__uint128_t x, int n) {
+    return x>>n;
+}
+
+#endif /* __ARCH_AARCH64_ARCH_INTRINSICS_H__ */
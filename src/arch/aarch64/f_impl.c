@@ -0,0 +1,498 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#define _XOPEN_SOURCE 600 /* f_field.h pulls in word.h's posix_memalign, after <ristretto255.h> */
+
+#include <ristretto255.h>
+#include "f_field.h"
+
+/** Requires: input limbs < 9*2^51 */
+void gf_mul (gf_25519_t *__restrict__ cs, const gf_25519_t *as, const gf_25519_t *bs) {
+    RISTRETTO_COUNT(gf_mul,1);
+    const uint64_t *a = as->limb, *b = bs->limb, mask = ((1ull<<51)-1);
+    uint64_t *c = cs->limb;
+
+    __uint128_t accum0, accum1, accum2;
+
+    uint64_t ai = a[0];
+    accum0 = widemul(ai, b[0]);
+    accum1 = widemul(ai, b[1]);
+    accum2 = widemul(ai, b[2]);
+
+    ai = a[1];
+    mac(&accum2, ai, b[1]);
+    mac(&accum1, ai, b[0]);
+    ai *= 19;
+    mac(&accum0, ai, b[4]);
+
+    ai = a[2];
+    mac(&accum2, ai, b[0]);
+    ai *= 19;
+    mac(&accum0, ai, b[3]);
+    mac(&accum1, ai, b[4]);
+
+    ai = a[3] * 19;
+    mac(&accum0, ai, b[2]);
+    mac(&accum1, ai, b[3]);
+    mac(&accum2, ai, b[4]);
+
+    ai = a[4] * 19;
+    mac(&accum0, ai, b[1]);
+    mac(&accum1, ai, b[2]);
+    mac(&accum2, ai, b[3]);
+
+    uint64_t c0 = accum0 & mask;
+    accum1 += shrld(accum0, 51);
+    uint64_t c1 = accum1 & mask;
+    accum2 += shrld(accum1, 51);
+    c[2] = accum2 & mask;
+
+    accum0 = shrld(accum2, 51);
+
+    mac(&accum0, ai, b[4]);
+
+    ai = a[0];
+    mac(&accum0, ai, b[3]);
+    accum1 = widemul(ai, b[4]);
+
+    ai = a[1];
+    mac(&accum0, ai, b[2]);
+    mac(&accum1, ai, b[3]);
+
+    ai = a[2];
+    mac(&accum0, ai, b[1]);
+    mac(&accum1, ai, b[2]);
+
+    ai = a[3];
+    mac(&accum0, ai, b[0]);
+    mac(&accum1, ai, b[1]);
+
+    ai = a[4];
+    mac(&accum1, ai, b[0]);
+    /* Here accum1 < 5*(9*2^51)^2 */
+
+    c[3] = accum0 & mask;
+    accum1 += shrld(accum0, 51);
+    c[4] = accum1 & mask;
+
+    uint64_t a1 = shrld(accum1,51);
+    /* Here a1 < (5*(9*2^51)^2 + small) >> 51 = 405 * 2^51 + small
+     * a1 * 19 + c0 < (405*19+1)*2^51 + small < 2^13 * 2^51.
+     */
+    accum1 = a1 * 19 + c0;
+    c[0] = accum1 & mask;
+    c[1] = c1 + (accum1>>51);
+}
+
+static RISTRETTO_INLINE void gf_sqr_limbs (uint64_t *__restrict__ c, const uint64_t *a) {
+    const uint64_t mask = ((1ull<<51)-1);
+
+    __uint128_t accum0, accum1, accum2;
+
+    uint64_t ai = a[0];
+    accum0 = widemul(ai, ai);
+    ai *= 2;
+    accum1 = widemul(ai, a[1]);
+    accum2 = widemul(ai, a[2]);
+
+    ai = a[1];
+    mac(&accum2, ai, ai);
+    ai *= 38;
+    mac(&accum0, ai, a[4]);
+
+    ai = a[2] * 38;
+    mac(&accum0, ai, a[3]);
+    mac(&accum1, ai, a[4]);
+
+    ai = a[3] * 19;
+    mac(&accum1, ai, a[3]);
+    ai *= 2;
+    mac(&accum2, ai, a[4]);
+
+    uint64_t c0 = accum0 & mask;
+    accum1 += shrld(accum0, 51);
+    uint64_t c1 = accum1 & mask;
+    accum2 += shrld(accum1, 51);
+    c[2] = accum2 & mask;
+
+    accum0 = accum2 >> 51;
+
+    ai = a[0]*2;
+    mac(&accum0, ai, a[3]);
+    accum1 = widemul(ai, a[4]);
+
+    ai = a[1]*2;
+    mac(&accum0, ai, a[2]);
+    mac(&accum1, ai, a[3]);
+
+    mac(&accum0, a[4]*19, a[4]);
+    mac(&accum1, a[2], a[2]);
+
+    c[3] = accum0 & mask;
+    accum1 += shrld(accum0, 51);
+    c[4] = accum1 & mask;
+
+    /* 2^102 * 16 * 5 * 19 * (1+ep) >> 64
+     * = 2^(-13 + <13)
+     */
+
+    uint64_t a1 = shrld(accum1,51);
+    accum1 = a1 * 19 + c0;
+    c[0] = accum1 & mask;
+    c[1] = c1 + (accum1>>51);
+}
+
+void gf_sqr (gf_25519_t *__restrict__ cs, const gf_25519_t *as) {
+    RISTRETTO_COUNT(gf_sqr,1);
+    gf_sqr_limbs(cs->limb, as->limb);
+}
+
+/* The squaring chains in gf_isr are most of its time, so keep them in one
+ * function instead of making a call per squaring.
+ */
+void gf_sqrn (gf_25519_t *__restrict__ ys, const gf_25519_t *xs, int n) {
+    uint64_t t[5];
+    assert(n>0);
+    RISTRETTO_COUNT(gf_sqr,n);
+    if (n&1) {
+        gf_sqr_limbs(ys->limb, xs->limb);
+        n--;
+    } else {
+        gf_sqr_limbs(t, xs->limb);
+        gf_sqr_limbs(ys->limb, t);
+        n-=2;
+    }
+    for (; n; n-=2) {
+        gf_sqr_limbs(t, ys->limb);
+        gf_sqr_limbs(ys->limb, t);
+    }
+}
+
+void gf_mulw_unsigned (gf_25519_t *__restrict__ cs, const gf_25519_t *as, uint32_t b) {
+    const uint64_t *a = as->limb, mask = ((1ull<<51)-1);
+    uint64_t *c = cs->limb;
+
+    __uint128_t accum = widemul(b, a[0]);
+    uint64_t c0 = accum & mask;
+    accum = shrld(accum,51);
+
+    mac(&accum, b, a[1]);
+    uint64_t c1 = accum & mask;
+    accum = shrld(accum,51);
+
+    mac(&accum, b, a[2]);
+    c[2] = accum & mask;
+    accum = shrld(accum,51);
+
+    mac(&accum, b, a[3]);
+    c[3] = accum & mask;
+    accum = shrld(accum,51);
+
+    mac(&accum, b, a[4]);
+    c[4] = accum & mask;
+
+    uint64_t a1 = shrld(accum,51);
+    a1 = a1*19+c0;
+
+    c[0] = a1 & mask;
+    c[1] = c1 + (a1>>51);
+}
+
+#define GF2_CARRY(c, i, bits) do { \
+    (c)[(i)+1] = vsraq_n_u64((c)[(i)+1], (c)[i], bits); \
+    (c)[i] = vandq_u64((c)[i], vdupq_n_u64((1<<(bits))-1)); \
+} while (0)
+
+static RISTRETTO_INLINE void gf2_carry (gf2_25519_t *out, uint64x2_t c[10]) {
+    uint64x2_t carry;
+    unsigned int i;
+
+    /* Two interleaved carry chains, as in ref10 */
+    GF2_CARRY(c, 0, 26); GF2_CARRY(c, 4, 26);
+    GF2_CARRY(c, 1, 25); GF2_CARRY(c, 5, 25);
+    GF2_CARRY(c, 2, 26); GF2_CARRY(c, 6, 26);
+    GF2_CARRY(c, 3, 25); GF2_CARRY(c, 7, 25);
+    GF2_CARRY(c, 4, 26); GF2_CARRY(c, 8, 26);
+
+    /* 2^255 = 19; the carry may exceed 32 bits, so no vmlal_u32 */
+    carry = vshrq_n_u64(c[9], 25);
+    c[9] = vandq_u64(c[9], vdupq_n_u64((1<<25)-1));
+    c[0] = vaddq_u64(c[0], vaddq_u64(carry,
+        vaddq_u64(vshlq_n_u64(carry, 4), vshlq_n_u64(carry, 1))));
+    GF2_CARRY(c, 0, 26);
+
+    for (i=0; i<10; i++) out->limb[i] = vmovn_u64(c[i]);
+}
+
+/* 2-way multiply in radix 2^25.5, the same schedule as the AVX2 gf4_mul with
+ * vmlal_u32 doing the multiply-adds.  Lane k of the output is the product of
+ * lanes k of the inputs.  Requires: a, b limbs within a hair of 2^{26,25},
+ * as gf2_mul, gf2_sqr and gf2_load produce.  Then every column sum fits in
+ * 64 bits and 19*b fits in 32.
+ */
+void gf2_mul (gf2_25519_t *__restrict__ cs, const gf2_25519_t *as, const gf2_25519_t *bs) {
+    RISTRETTO_COUNT(gf_mul,2);
+    const uint32x2_t *a = as->limb, *b = bs->limb;
+    /* Odd*odd products carry an extra factor of 2 in this radix */
+    const uint32x2_t a1_2 = vshl_n_u32(a[1],1), a3_2 = vshl_n_u32(a[3],1),
+        a5_2 = vshl_n_u32(a[5],1), a7_2 = vshl_n_u32(a[7],1), a9_2 = vshl_n_u32(a[9],1);
+    const uint32x2_t b1_19 = vmul_n_u32(b[1],19), b2_19 = vmul_n_u32(b[2],19), b3_19 = vmul_n_u32(b[3],19);
+    const uint32x2_t b4_19 = vmul_n_u32(b[4],19), b5_19 = vmul_n_u32(b[5],19), b6_19 = vmul_n_u32(b[6],19);
+    const uint32x2_t b7_19 = vmul_n_u32(b[7],19), b8_19 = vmul_n_u32(b[8],19), b9_19 = vmul_n_u32(b[9],19);
+    uint64x2_t c[10];
+
+    c[0] = vmull_u32(a[0], b[0]);
+    c[0] = vmlal_u32(c[0], a1_2, b9_19);
+    c[0] = vmlal_u32(c[0], a[2], b8_19);
+    c[0] = vmlal_u32(c[0], a3_2, b7_19);
+    c[0] = vmlal_u32(c[0], a[4], b6_19);
+    c[0] = vmlal_u32(c[0], a5_2, b5_19);
+    c[0] = vmlal_u32(c[0], a[6], b4_19);
+    c[0] = vmlal_u32(c[0], a7_2, b3_19);
+    c[0] = vmlal_u32(c[0], a[8], b2_19);
+    c[0] = vmlal_u32(c[0], a9_2, b1_19);
+    c[1] = vmull_u32(a[0], b[1]);
+    c[1] = vmlal_u32(c[1], a[1], b[0]);
+    c[1] = vmlal_u32(c[1], a[2], b9_19);
+    c[1] = vmlal_u32(c[1], a[3], b8_19);
+    c[1] = vmlal_u32(c[1], a[4], b7_19);
+    c[1] = vmlal_u32(c[1], a[5], b6_19);
+    c[1] = vmlal_u32(c[1], a[6], b5_19);
+    c[1] = vmlal_u32(c[1], a[7], b4_19);
+    c[1] = vmlal_u32(c[1], a[8], b3_19);
+    c[1] = vmlal_u32(c[1], a[9], b2_19);
+    c[2] = vmull_u32(a[0], b[2]);
+    c[2] = vmlal_u32(c[2], a1_2, b[1]);
+    c[2] = vmlal_u32(c[2], a[2], b[0]);
+    c[2] = vmlal_u32(c[2], a3_2, b9_19);
+    c[2] = vmlal_u32(c[2], a[4], b8_19);
+    c[2] = vmlal_u32(c[2], a5_2, b7_19);
+    c[2] = vmlal_u32(c[2], a[6], b6_19);
+    c[2] = vmlal_u32(c[2], a7_2, b5_19);
+    c[2] = vmlal_u32(c[2], a[8], b4_19);
+    c[2] = vmlal_u32(c[2], a9_2, b3_19);
+    c[3] = vmull_u32(a[0], b[3]);
+    c[3] = vmlal_u32(c[3], a[1], b[2]);
+    c[3] = vmlal_u32(c[3], a[2], b[1]);
+    c[3] = vmlal_u32(c[3], a[3], b[0]);
+    c[3] = vmlal_u32(c[3], a[4], b9_19);
+    c[3] = vmlal_u32(c[3], a[5], b8_19);
+    c[3] = vmlal_u32(c[3], a[6], b7_19);
+    c[3] = vmlal_u32(c[3], a[7], b6_19);
+    c[3] = vmlal_u32(c[3], a[8], b5_19);
+    c[3] = vmlal_u32(c[3], a[9], b4_19);
+    c[4] = vmull_u32(a[0], b[4]);
+    c[4] = vmlal_u32(c[4], a1_2, b[3]);
+    c[4] = vmlal_u32(c[4], a[2], b[2]);
+    c[4] = vmlal_u32(c[4], a3_2, b[1]);
+    c[4] = vmlal_u32(c[4], a[4], b[0]);
+    c[4] = vmlal_u32(c[4], a5_2, b9_19);
+    c[4] = vmlal_u32(c[4], a[6], b8_19);
+    c[4] = vmlal_u32(c[4], a7_2, b7_19);
+    c[4] = vmlal_u32(c[4], a[8], b6_19);
+    c[4] = vmlal_u32(c[4], a9_2, b5_19);
+    c[5] = vmull_u32(a[0], b[5]);
+    c[5] = vmlal_u32(c[5], a[1], b[4]);
+    c[5] = vmlal_u32(c[5], a[2], b[3]);
+    c[5] = vmlal_u32(c[5], a[3], b[2]);
+    c[5] = vmlal_u32(c[5], a[4], b[1]);
+    c[5] = vmlal_u32(c[5], a[5], b[0]);
+    c[5] = vmlal_u32(c[5], a[6], b9_19);
+    c[5] = vmlal_u32(c[5], a[7], b8_19);
+    c[5] = vmlal_u32(c[5], a[8], b7_19);
+    c[5] = vmlal_u32(c[5], a[9], b6_19);
+    c[6] = vmull_u32(a[0], b[6]);
+    c[6] = vmlal_u32(c[6], a1_2, b[5]);
+    c[6] = vmlal_u32(c[6], a[2], b[4]);
+    c[6] = vmlal_u32(c[6], a3_2, b[3]);
+    c[6] = vmlal_u32(c[6], a[4], b[2]);
+    c[6] = vmlal_u32(c[6], a5_2, b[1]);
+    c[6] = vmlal_u32(c[6], a[6], b[0]);
+    c[6] = vmlal_u32(c[6], a7_2, b9_19);
+    c[6] = vmlal_u32(c[6], a[8], b8_19);
+    c[6] = vmlal_u32(c[6], a9_2, b7_19);
+    c[7] = vmull_u32(a[0], b[7]);
+    c[7] = vmlal_u32(c[7], a[1], b[6]);
+    c[7] = vmlal_u32(c[7], a[2], b[5]);
+    c[7] = vmlal_u32(c[7], a[3], b[4]);
+    c[7] = vmlal_u32(c[7], a[4], b[3]);
+    c[7] = vmlal_u32(c[7], a[5], b[2]);
+    c[7] = vmlal_u32(c[7], a[6], b[1]);
+    c[7] = vmlal_u32(c[7], a[7], b[0]);
+    c[7] = vmlal_u32(c[7], a[8], b9_19);
+    c[7] = vmlal_u32(c[7], a[9], b8_19);
+    c[8] = vmull_u32(a[0], b[8]);
+    c[8] = vmlal_u32(c[8], a1_2, b[7]);
+    c[8] = vmlal_u32(c[8], a[2], b[6]);
+    c[8] = vmlal_u32(c[8], a3_2, b[5]);
+    c[8] = vmlal_u32(c[8], a[4], b[4]);
+    c[8] = vmlal_u32(c[8], a5_2, b[3]);
+    c[8] = vmlal_u32(c[8], a[6], b[2]);
+    c[8] = vmlal_u32(c[8], a7_2, b[1]);
+    c[8] = vmlal_u32(c[8], a[8], b[0]);
+    c[8] = vmlal_u32(c[8], a9_2, b9_19);
+    c[9] = vmull_u32(a[0], b[9]);
+    c[9] = vmlal_u32(c[9], a[1], b[8]);
+    c[9] = vmlal_u32(c[9], a[2], b[7]);
+    c[9] = vmlal_u32(c[9], a[3], b[6]);
+    c[9] = vmlal_u32(c[9], a[4], b[5]);
+    c[9] = vmlal_u32(c[9], a[5], b[4]);
+    c[9] = vmlal_u32(c[9], a[6], b[3]);
+    c[9] = vmlal_u32(c[9], a[7], b[2]);
+    c[9] = vmlal_u32(c[9], a[8], b[1]);
+    c[9] = vmlal_u32(c[9], a[9], b[0]);
+
+    gf2_carry(cs, c);
+}
+
+/* 2-way square, with the same bounds as gf2_mul. */
+void gf2_sqr (gf2_25519_t *__restrict__ cs, const gf2_25519_t *as) {
+    RISTRETTO_COUNT(gf_sqr,2);
+    const uint32x2_t *a = as->limb;
+    /* Cross terms appear twice, and odd*odd products double again */
+    const uint32x2_t a0_2 = vshl_n_u32(a[0],1), a1_2 = vshl_n_u32(a[1],1), a2_2 = vshl_n_u32(a[2],1),
+        a3_2 = vshl_n_u32(a[3],1), a4_2 = vshl_n_u32(a[4],1), a5_2 = vshl_n_u32(a[5],1),
+        a6_2 = vshl_n_u32(a[6],1), a7_2 = vshl_n_u32(a[7],1), a8_2 = vshl_n_u32(a[8],1), a9_2 = vshl_n_u32(a[9],1);
+    const uint32x2_t a1_4 = vshl_n_u32(a[1],2), a3_4 = vshl_n_u32(a[3],2), a5_4 = vshl_n_u32(a[5],2), a7_4 = vshl_n_u32(a[7],2);
+    const uint32x2_t a5_19 = vmul_n_u32(a[5],19), a6_19 = vmul_n_u32(a[6],19), a7_19 = vmul_n_u32(a[7],19);
+    const uint32x2_t a8_19 = vmul_n_u32(a[8],19), a9_19 = vmul_n_u32(a[9],19);
+    uint64x2_t c[10];
+
+    c[0] = vmull_u32(a[0], a[0]);
+    c[0] = vmlal_u32(c[0], a1_4, a9_19);
+    c[0] = vmlal_u32(c[0], a2_2, a8_19);
+    c[0] = vmlal_u32(c[0], a3_4, a7_19);
+    c[0] = vmlal_u32(c[0], a4_2, a6_19);
+    c[0] = vmlal_u32(c[0], a5_2, a5_19);
+    c[1] = vmull_u32(a0_2, a[1]);
+    c[1] = vmlal_u32(c[1], a2_2, a9_19);
+    c[1] = vmlal_u32(c[1], a3_2, a8_19);
+    c[1] = vmlal_u32(c[1], a4_2, a7_19);
+    c[1] = vmlal_u32(c[1], a5_2, a6_19);
+    c[2] = vmull_u32(a0_2, a[2]);
+    c[2] = vmlal_u32(c[2], a1_2, a[1]);
+    c[2] = vmlal_u32(c[2], a3_4, a9_19);
+    c[2] = vmlal_u32(c[2], a4_2, a8_19);
+    c[2] = vmlal_u32(c[2], a5_4, a7_19);
+    c[2] = vmlal_u32(c[2], a[6], a6_19);
+    c[3] = vmull_u32(a0_2, a[3]);
+    c[3] = vmlal_u32(c[3], a1_2, a[2]);
+    c[3] = vmlal_u32(c[3], a4_2, a9_19);
+    c[3] = vmlal_u32(c[3], a5_2, a8_19);
+    c[3] = vmlal_u32(c[3], a6_2, a7_19);
+    c[4] = vmull_u32(a0_2, a[4]);
+    c[4] = vmlal_u32(c[4], a1_4, a[3]);
+    c[4] = vmlal_u32(c[4], a[2], a[2]);
+    c[4] = vmlal_u32(c[4], a5_4, a9_19);
+    c[4] = vmlal_u32(c[4], a6_2, a8_19);
+    c[4] = vmlal_u32(c[4], a7_2, a7_19);
+    c[5] = vmull_u32(a0_2, a[5]);
+    c[5] = vmlal_u32(c[5], a1_2, a[4]);
+    c[5] = vmlal_u32(c[5], a2_2, a[3]);
+    c[5] = vmlal_u32(c[5], a6_2, a9_19);
+    c[5] = vmlal_u32(c[5], a7_2, a8_19);
+    c[6] = vmull_u32(a0_2, a[6]);
+    c[6] = vmlal_u32(c[6], a1_4, a[5]);
+    c[6] = vmlal_u32(c[6], a2_2, a[4]);
+    c[6] = vmlal_u32(c[6], a3_2, a[3]);
+    c[6] = vmlal_u32(c[6], a7_4, a9_19);
+    c[6] = vmlal_u32(c[6], a[8], a8_19);
+    c[7] = vmull_u32(a0_2, a[7]);
+    c[7] = vmlal_u32(c[7], a1_2, a[6]);
+    c[7] = vmlal_u32(c[7], a2_2, a[5]);
+    c[7] = vmlal_u32(c[7], a3_2, a[4]);
+    c[7] = vmlal_u32(c[7], a8_2, a9_19);
+    c[8] = vmull_u32(a0_2, a[8]);
+    c[8] = vmlal_u32(c[8], a1_4, a[7]);
+    c[8] = vmlal_u32(c[8], a2_2, a[6]);
+    c[8] = vmlal_u32(c[8], a3_4, a[5]);
+    c[8] = vmlal_u32(c[8], a[4], a[4]);
+    c[8] = vmlal_u32(c[8], a9_2, a9_19);
+    c[9] = vmull_u32(a0_2, a[9]);
+    c[9] = vmlal_u32(c[9], a1_2, a[8]);
+    c[9] = vmlal_u32(c[9], a2_2, a[7]);
+    c[9] = vmlal_u32(c[9], a3_2, a[6]);
+    c[9] = vmlal_u32(c[9], a4_2, a[5]);
+
+    gf2_carry(cs, c);
+}
+
+static RISTRETTO_INLINE void gf2_sqrn (gf2_25519_t *__restrict__ y, const gf2_25519_t *x, int n) {
+    gf2_25519_t tmp;
+    assert(n>0);
+    if (n&1) {
+        gf2_sqr(y,x);
+        n--;
+    } else {
+        gf2_sqr(&tmp,x);
+        gf2_sqr(y,&tmp);
+        n-=2;
+    }
+    for (; n; n-=2) {
+        gf2_sqr(&tmp,y);
+        gf2_sqr(y,&tmp);
+    }
+}
+
+/* Split x[0] and x[1] into the two lanes of out */
+static void gf2_load (gf2_25519_t *out, const gf_25519_t x[2]) {
+    gf_25519_t r[2] = { x[0], x[1] };
+    uint32_t even[2], odd[2];
+    unsigned int i, k;
+
+    for (k=0; k<2; k++) gf_weak_reduce(&r[k]);
+    for (i=0; i<5; i++) {
+        for (k=0; k<2; k++) {
+            even[k] = r[k].limb[i] & ((1<<26)-1);
+            odd[k]  = r[k].limb[i] >> 26;
+        }
+        out->limb[2*i]   = vld1_u32(even);
+        out->limb[2*i+1] = vld1_u32(odd);
+    }
+}
+
+static void gf2_store (gf_25519_t x[2], const gf2_25519_t *a) {
+    uint64_t merged[2];
+    unsigned int i;
+
+    for (i=0; i<5; i++) {
+        vst1q_u64(merged, vaddw_u32(vshll_n_u32(a->limb[2*i+1], 26), a->limb[2*i]));
+        x[0].limb[i] = merged[0];
+        x[1].limb[i] = merged[1];
+    }
+}
+
+void gf2_isr (mask_t succ[2], gf_25519_t *__restrict__ a, const gf_25519_t *x) {
+    RISTRETTO_COUNT(gf_isr,2);
+    gf2_25519_t L0, L1, L2, L3, X;
+    gf_25519_t r[2];
+
+    gf2_load(&X, x);
+    gf2_sqr (&L0, &X);
+    gf2_mul (&L1, &L0, &X);
+    gf2_sqr (&L0, &L1);
+    gf2_mul (&L1, &L0, &X);
+    gf2_sqrn(&L0, &L1, 3);
+    gf2_mul (&L2, &L0, &L1);
+    gf2_sqrn(&L0, &L2, 6);
+    gf2_mul (&L1, &L2, &L0);
+    gf2_sqr (&L2, &L1);
+    gf2_mul (&L0, &L2, &X);
+    gf2_sqrn(&L2, &L0, 12);
+    gf2_mul (&L0, &L2, &L1);
+    gf2_sqrn(&L2, &L0, 25);
+    gf2_mul (&L3, &L2, &L0);
+    gf2_sqrn(&L2, &L3, 25);
+    gf2_mul (&L1, &L2, &L0);
+    gf2_sqrn(&L2, &L1, 50);
+    gf2_mul (&L0, &L2, &L3);
+    gf2_sqrn(&L2, &L0, 125);
+    gf2_mul (&L3, &L2, &L0);
+    gf2_sqrn(&L2, &L3, 2);
+    gf2_mul (&L0, &L2, &X);
+    gf2_store(r, &L0);
+
+    succ[0] = gf_isr_finish(&a[0], &r[0], &x[0]);
+    succ[1] = gf_isr_finish(&a[1], &r[1], &x[1]);
+}
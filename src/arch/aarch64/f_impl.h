@@ -0,0 +1,57 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#define GF_HEADROOM 933
+#define FIELD_LITERAL(a,b,c,d,e) {{ a,b,c,d,e }}
+
+#define LIMB_PLACE_VALUE(i) 51
+
+/* Square x, n times, without a call per squaring */
+#define GF_HAS_SQRN 1
+void gf_sqrn (gf_25519_t *__restrict__ y, const gf_25519_t *x, int n);
+
+/* Two field elements computed in parallel, one per 64-bit lane of a NEON
+ * register.  Limbs are in radix 2^25.5 (26 bits even, 25 bits odd) so that
+ * the products fit vmull_u32's 32x32->64 multiplier.  As with gf8 on IFMA,
+ * only what the exponentiation inside gf2_isr needs is provided.
+ */
+#define GF_HAS_GF2 1
+
+typedef struct {
+    uint32x2_t limb[10];
+} gf2_25519_t;
+
+void gf2_mul (gf2_25519_t *__restrict__ out, const gf2_25519_t *a, const gf2_25519_t *b);
+void gf2_sqr (gf2_25519_t *__restrict__ out, const gf2_25519_t *a);
+
+/** Two gf_isr's at once: succ[k] = gf_isr(&a[k], &x[k]).  No aliasing. */
+void gf2_isr (mask_t succ[2], gf_25519_t *__restrict__ a, const gf_25519_t *x);
+
+void gf_add_RAW (gf_25519_t *out, const gf_25519_t *a, const gf_25519_t *b) {
+    for (unsigned int i=0; i<5; i++) {
+        out->limb[i] = a->limb[i] + b->limb[i];
+    }
+}
+
+void gf_sub_RAW (gf_25519_t *out, const gf_25519_t *a, const gf_25519_t *b) {
+    for (unsigned int i=0; i<5; i++) {
+        out->limb[i] = a->limb[i] - b->limb[i];
+    }
+}
+
+void gf_bias (gf_25519_t *a, int amt) {
+    a->limb[0] += ((uint64_t)(amt)<<52) - 38*amt;
+    for (unsigned int i=1; i<5; i++) {
+        a->limb[i] += ((uint64_t)(amt)<<52)-2*amt;
+    }
+}
+
+void gf_weak_reduce (gf_25519_t *a) {
+    uint64_t mask = (1ull<<51) - 1;
+    uint64_t tmp = a->limb[4] >> 51;
+    for (unsigned int i=4; i>0; i--) {
+        a->limb[i] = (a->limb[i] & mask) + (a->limb[i-1]>>51);
+    }
+    a->limb[0] = (a->limb[0] & mask) + tmp*19;
+}
@@ -0,0 +1,15 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#ifndef __ARCH_AVX2_ARCH_INTRINSICS_H__
+#define __ARCH_AVX2_ARCH_INTRINSICS_H__
+
+#ifndef __AVX2__
+#error "ARCH=avx2 requires a compiler targeting AVX2, eg -mavx2 or -march=haswell"
+#endif
+
+/* Single field elements use the x86_64 code unchanged. */
+#include "../x86_64/arch_intrinsics.h"
+
+#endif /* __ARCH_AVX2_ARCH_INTRINSICS_H__ */
@@ -0,0 +1,196 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#include "../x86_64/f_impl.c"
+
+/* 4-way multiply in radix 2^25.5.  Lane k of the output is the product of
+ * lanes k of the inputs.  Requires: a, b limbs < 3 * 2^{26,25}, ie results of
+ * gf4_mul/gf4_sqr/gf4_reduce through at most one gf4_add or gf4_sub.
+ * Then every column sum fits in 64 bits and 19*b fits in 32.
+ */
+void gf4_mul (gf4_25519_t *__restrict__ cs, const gf4_25519_t *as, const gf4_25519_t *bs) {
+    RISTRETTO_COUNT(gf_mul,4);
+    const __m256i *a = as->limb, *b = bs->limb, nineteen = _mm256_set1_epi64x(19);
+    /* Odd*odd products carry an extra factor of 2 in this radix */
+    const __m256i a1_2 = _mm256_add_epi64(a[1],a[1]), a3_2 = _mm256_add_epi64(a[3],a[3]),
+        a5_2 = _mm256_add_epi64(a[5],a[5]), a7_2 = _mm256_add_epi64(a[7],a[7]), a9_2 = _mm256_add_epi64(a[9],a[9]);
+    const __m256i b1_19 = _mm256_mul_epu32(b[1],nineteen), b2_19 = _mm256_mul_epu32(b[2],nineteen), b3_19 = _mm256_mul_epu32(b[3],nineteen);
+    const __m256i b4_19 = _mm256_mul_epu32(b[4],nineteen), b5_19 = _mm256_mul_epu32(b[5],nineteen), b6_19 = _mm256_mul_epu32(b[6],nineteen);
+    const __m256i b7_19 = _mm256_mul_epu32(b[7],nineteen), b8_19 = _mm256_mul_epu32(b[8],nineteen), b9_19 = _mm256_mul_epu32(b[9],nineteen);
+    __m256i c[10];
+
+    c[0] = _mm256_mul_epu32(a[0], b[0]);
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a1_2, b9_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a[2], b8_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a3_2, b7_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a[4], b6_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a5_2, b5_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a[6], b4_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a7_2, b3_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a[8], b2_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a9_2, b1_19));
+    c[1] = _mm256_mul_epu32(a[0], b[1]);
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[1], b[0]));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[2], b9_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[3], b8_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[4], b7_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[5], b6_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[6], b5_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[7], b4_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[8], b3_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a[9], b2_19));
+    c[2] = _mm256_mul_epu32(a[0], b[2]);
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a1_2, b[1]));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a[2], b[0]));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a3_2, b9_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a[4], b8_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a5_2, b7_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a[6], b6_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a7_2, b5_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a[8], b4_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a9_2, b3_19));
+    c[3] = _mm256_mul_epu32(a[0], b[3]);
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[1], b[2]));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[2], b[1]));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[3], b[0]));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[4], b9_19));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[5], b8_19));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[6], b7_19));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[7], b6_19));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[8], b5_19));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a[9], b4_19));
+    c[4] = _mm256_mul_epu32(a[0], b[4]);
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a1_2, b[3]));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a[2], b[2]));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a3_2, b[1]));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a[4], b[0]));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a5_2, b9_19));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a[6], b8_19));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a7_2, b7_19));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a[8], b6_19));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a9_2, b5_19));
+    c[5] = _mm256_mul_epu32(a[0], b[5]);
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[1], b[4]));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[2], b[3]));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[3], b[2]));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[4], b[1]));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[5], b[0]));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[6], b9_19));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[7], b8_19));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[8], b7_19));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a[9], b6_19));
+    c[6] = _mm256_mul_epu32(a[0], b[6]);
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a1_2, b[5]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a[2], b[4]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a3_2, b[3]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a[4], b[2]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a5_2, b[1]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a[6], b[0]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a7_2, b9_19));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a[8], b8_19));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a9_2, b7_19));
+    c[7] = _mm256_mul_epu32(a[0], b[7]);
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[1], b[6]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[2], b[5]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[3], b[4]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[4], b[3]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[5], b[2]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[6], b[1]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[7], b[0]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[8], b9_19));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a[9], b8_19));
+    c[8] = _mm256_mul_epu32(a[0], b[8]);
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a1_2, b[7]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a[2], b[6]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a3_2, b[5]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a[4], b[4]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a5_2, b[3]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a[6], b[2]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a7_2, b[1]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a[8], b[0]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a9_2, b9_19));
+    c[9] = _mm256_mul_epu32(a[0], b[9]);
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[1], b[8]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[2], b[7]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[3], b[6]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[4], b[5]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[5], b[4]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[6], b[3]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[7], b[2]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[8], b[1]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a[9], b[0]));
+
+    gf4_carry(cs, c);
+}
+
+/* 4-way square, with the same bounds as gf4_mul. */
+void gf4_sqr (gf4_25519_t *__restrict__ cs, const gf4_25519_t *as) {
+    RISTRETTO_COUNT(gf_sqr,4);
+    const __m256i *a = as->limb, nineteen = _mm256_set1_epi64x(19);
+    /* Cross terms appear twice, and odd*odd products double again */
+    const __m256i a0_2 = _mm256_add_epi64(a[0],a[0]), a1_2 = _mm256_add_epi64(a[1],a[1]), a2_2 = _mm256_add_epi64(a[2],a[2]), a3_2 = _mm256_add_epi64(a[3],a[3]), a4_2 = _mm256_add_epi64(a[4],a[4]),
+        a5_2 = _mm256_add_epi64(a[5],a[5]), a6_2 = _mm256_add_epi64(a[6],a[6]), a7_2 = _mm256_add_epi64(a[7],a[7]), a8_2 = _mm256_add_epi64(a[8],a[8]), a9_2 = _mm256_add_epi64(a[9],a[9]);
+    const __m256i a1_4 = _mm256_add_epi64(a1_2,a1_2), a3_4 = _mm256_add_epi64(a3_2,a3_2), a5_4 = _mm256_add_epi64(a5_2,a5_2), a7_4 = _mm256_add_epi64(a7_2,a7_2);
+    const __m256i a5_19 = _mm256_mul_epu32(a[5],nineteen), a6_19 = _mm256_mul_epu32(a[6],nineteen), a7_19 = _mm256_mul_epu32(a[7],nineteen);
+    const __m256i a8_19 = _mm256_mul_epu32(a[8],nineteen), a9_19 = _mm256_mul_epu32(a[9],nineteen);
+    __m256i c[10];
+
+    c[0] = _mm256_mul_epu32(a[0], a[0]);
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a1_4, a9_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a2_2, a8_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a3_4, a7_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a4_2, a6_19));
+    c[0] = _mm256_add_epi64(c[0], _mm256_mul_epu32(a5_2, a5_19));
+    c[1] = _mm256_mul_epu32(a0_2, a[1]);
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a2_2, a9_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a3_2, a8_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a4_2, a7_19));
+    c[1] = _mm256_add_epi64(c[1], _mm256_mul_epu32(a5_2, a6_19));
+    c[2] = _mm256_mul_epu32(a0_2, a[2]);
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a1_2, a[1]));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a3_4, a9_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a4_2, a8_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a5_4, a7_19));
+    c[2] = _mm256_add_epi64(c[2], _mm256_mul_epu32(a[6], a6_19));
+    c[3] = _mm256_mul_epu32(a0_2, a[3]);
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a1_2, a[2]));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a4_2, a9_19));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a5_2, a8_19));
+    c[3] = _mm256_add_epi64(c[3], _mm256_mul_epu32(a6_2, a7_19));
+    c[4] = _mm256_mul_epu32(a0_2, a[4]);
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a1_4, a[3]));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a[2], a[2]));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a5_4, a9_19));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a6_2, a8_19));
+    c[4] = _mm256_add_epi64(c[4], _mm256_mul_epu32(a7_2, a7_19));
+    c[5] = _mm256_mul_epu32(a0_2, a[5]);
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a1_2, a[4]));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a2_2, a[3]));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a6_2, a9_19));
+    c[5] = _mm256_add_epi64(c[5], _mm256_mul_epu32(a7_2, a8_19));
+    c[6] = _mm256_mul_epu32(a0_2, a[6]);
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a1_4, a[5]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a2_2, a[4]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a3_2, a[3]));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a7_4, a9_19));
+    c[6] = _mm256_add_epi64(c[6], _mm256_mul_epu32(a[8], a8_19));
+    c[7] = _mm256_mul_epu32(a0_2, a[7]);
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a1_2, a[6]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a2_2, a[5]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a3_2, a[4]));
+    c[7] = _mm256_add_epi64(c[7], _mm256_mul_epu32(a8_2, a9_19));
+    c[8] = _mm256_mul_epu32(a0_2, a[8]);
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a1_4, a[7]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a2_2, a[6]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a3_4, a[5]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a[4], a[4]));
+    c[8] = _mm256_add_epi64(c[8], _mm256_mul_epu32(a9_2, a9_19));
+    c[9] = _mm256_mul_epu32(a0_2, a[9]);
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a1_2, a[8]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a2_2, a[7]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a3_2, a[6]));
+    c[9] = _mm256_add_epi64(c[9], _mm256_mul_epu32(a4_2, a[5]));
+
+    gf4_carry(cs, c);
+}
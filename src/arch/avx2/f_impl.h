@@ -0,0 +1,180 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#include "../x86_64/f_impl.h"
+
+/* Four field elements computed in parallel, one per 64-bit lane.  Limbs are
+ * in radix 2^25.5 (26 bits even, 25 bits odd) so that the products fit
+ * vpmuludq's 32x32->64 multiplier; each 51-bit scalar limb splits evenly
+ * into an even/odd pair.
+ *
+ * An element is "reduced" if its limbs are within a hair of 2^{26,25}.
+ * That's what gf4_mul, gf4_sqr, gf4_reduce and gf4_pack produce, and
+ * any of those passed through one gf4_add or gf4_sub may be multiplied
+ * again without reducing.
+ */
+#define GF_HAS_GF4 1
+
+/* Compilers won't reliably unroll ten-limb loops at -O2, so spell them out */
+#define GF4_FOR_LIMBS(op) op(0) op(1) op(2) op(3) op(4) op(5) op(6) op(7) op(8) op(9)
+
+typedef struct {
+    __m256i limb[10];
+} gf4_25519_t;
+
+void gf4_mul (gf4_25519_t *__restrict__ out, const gf4_25519_t *a, const gf4_25519_t *b);
+void gf4_sqr (gf4_25519_t *__restrict__ out, const gf4_25519_t *a);
+
+/* out = (a[l0], a[l1], a[l2], a[l3]) lanewise.  The l's must be constants. */
+#define GF4_SHUFFLE(out, a, l0, l1, l2, l3) do { \
+    enum { gf4_imm_ = _MM_SHUFFLE(l3,l2,l1,l0) }; \
+    gf4_25519_t *gf4_out_ = (out); \
+    const gf4_25519_t *gf4_a_ = (a); \
+    GF4_FOR_LIMBS(GF4_SHUFFLE_LIMB_) \
+} while (0)
+#define GF4_SHUFFLE_LIMB_(i) \
+    gf4_out_->limb[i] = _mm256_permute4x64_epi64(gf4_a_->limb[i], gf4_imm_);
+
+/* Lane k of out = bk ? b[k] : a[k].  The b's must be constants. */
+#define GF4_BLEND(out, a, b, b0, b1, b2, b3) do { \
+    enum { gf4_imm_ = ((b0)*0x03) | ((b1)*0x0c) | ((b2)*0x30) | ((b3)*0xc0) }; \
+    gf4_25519_t *gf4_out_ = (out); \
+    const gf4_25519_t *gf4_a_ = (a), *gf4_b_ = (b); \
+    GF4_FOR_LIMBS(GF4_BLEND_LIMB_) \
+} while (0)
+#define GF4_BLEND_LIMB_(i) \
+    gf4_out_->limb[i] = _mm256_blend_epi32(gf4_a_->limb[i], gf4_b_->limb[i], gf4_imm_);
+
+#define GF4_CARRY(c, i, bits) do { \
+    __m256i gf4_carry_ = _mm256_srli_epi64((c)[i], bits); \
+    (c)[i] = _mm256_and_si256((c)[i], _mm256_set1_epi64x((1<<(bits))-1)); \
+    (c)[(i)+1] = _mm256_add_epi64((c)[(i)+1], gf4_carry_); \
+} while (0)
+
+static INLINE_UNUSED void gf4_carry (gf4_25519_t *out, __m256i c[10]) {
+    __m256i carry;
+
+    /* Two interleaved carry chains, as in ref10 */
+    GF4_CARRY(c, 0, 26); GF4_CARRY(c, 4, 26);
+    GF4_CARRY(c, 1, 25); GF4_CARRY(c, 5, 25);
+    GF4_CARRY(c, 2, 26); GF4_CARRY(c, 6, 26);
+    GF4_CARRY(c, 3, 25); GF4_CARRY(c, 7, 25);
+    GF4_CARRY(c, 4, 26); GF4_CARRY(c, 8, 26);
+
+    /* 2^255 = 19; the carry may exceed 32 bits, so no vpmuludq */
+    carry = _mm256_srli_epi64(c[9], 25);
+    c[9] = _mm256_and_si256(c[9], _mm256_set1_epi64x((1<<25)-1));
+    carry = _mm256_add_epi64(carry, _mm256_add_epi64(
+        _mm256_slli_epi64(carry, 4), _mm256_slli_epi64(carry, 1)));
+    c[0] = _mm256_add_epi64(c[0], carry);
+    GF4_CARRY(c, 0, 26);
+
+#define GF4_COPY_LIMB_(i) out->limb[i] = c[i];
+    GF4_FOR_LIMBS(GF4_COPY_LIMB_)
+#undef GF4_COPY_LIMB_
+}
+
+static INLINE_UNUSED void gf4_reduce (gf4_25519_t *a) {
+    gf4_carry(a, a->limb);
+}
+
+static INLINE_UNUSED void gf4_add (gf4_25519_t *out, const gf4_25519_t *a, const gf4_25519_t *b) {
+#define GF4_ADD_LIMB_(i) out->limb[i] = _mm256_add_epi64(a->limb[i], b->limb[i]);
+    GF4_FOR_LIMBS(GF4_ADD_LIMB_)
+#undef GF4_ADD_LIMB_
+}
+
+/** Subtract, biasing by 2p.  Requires b reduced. */
+static INLINE_UNUSED void gf4_sub (gf4_25519_t *out, const gf4_25519_t *a, const gf4_25519_t *b) {
+    const __m256i p2_0 = _mm256_set1_epi64x((1<<27)-38),
+        p2_even = _mm256_set1_epi64x((1<<27)-2), p2_odd = _mm256_set1_epi64x((1<<26)-2);
+#define GF4_SUB_LIMB_(i) out->limb[i] = _mm256_sub_epi64(_mm256_add_epi64(a->limb[i], \
+        ((i)==0) ? p2_0 : ((i)&1) ? p2_odd : p2_even), b->limb[i]);
+    GF4_FOR_LIMBS(GF4_SUB_LIMB_)
+#undef GF4_SUB_LIMB_
+}
+
+/** Negate, biasing by 2p.  Requires a reduced. */
+static INLINE_UNUSED void gf4_neg (gf4_25519_t *out, const gf4_25519_t *a) {
+    gf4_25519_t zero;
+#define GF4_ZERO_LIMB_(i) zero.limb[i] = _mm256_setzero_si256();
+    GF4_FOR_LIMBS(GF4_ZERO_LIMB_)
+#undef GF4_ZERO_LIMB_
+    gf4_sub(out, &zero, a);
+}
+
+/** Constant time, out = is_b ? b : a. */
+static INLINE_UNUSED void gf4_cond_sel (
+    gf4_25519_t *out,
+    const gf4_25519_t *a,
+    const gf4_25519_t *b,
+    mask_t is_b
+) {
+    const __m256i m = _mm256_set1_epi64x(is_b);
+#define GF4_SEL_LIMB_(i) out->limb[i] = _mm256_or_si256( \
+        _mm256_andnot_si256(m, a->limb[i]), _mm256_and_si256(m, b->limb[i]));
+    GF4_FOR_LIMBS(GF4_SEL_LIMB_)
+#undef GF4_SEL_LIMB_
+}
+
+/** Load (a,b,c,d) into the four lanes of out. */
+static INLINE_UNUSED void gf4_pack (
+    gf4_25519_t *out,
+    const gf_25519_t *a,
+    const gf_25519_t *b,
+    const gf_25519_t *c,
+    const gf_25519_t *d
+) {
+    const __m256i m26 = _mm256_set1_epi64x((1<<26)-1);
+    __m256i r0 = _mm256_loadu_si256((const __m256i *)a->limb),
+            r1 = _mm256_loadu_si256((const __m256i *)b->limb),
+            r2 = _mm256_loadu_si256((const __m256i *)c->limb),
+            r3 = _mm256_loadu_si256((const __m256i *)d->limb);
+    __m256i t0 = _mm256_unpacklo_epi64(r0, r1), t1 = _mm256_unpackhi_epi64(r0, r1),
+            t2 = _mm256_unpacklo_epi64(r2, r3), t3 = _mm256_unpackhi_epi64(r2, r3);
+    __m256i l[5];
+
+    l[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+    l[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+    l[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+    l[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+    l[4] = _mm256_set_epi64x(d->limb[4], c->limb[4], b->limb[4], a->limb[4]);
+
+#define GF4_SPLIT_LIMB_(i) out->limb[i] = ((i)&1) \
+        ? _mm256_srli_epi64(l[(i)/2], 26) : _mm256_and_si256(l[(i)/2], m26);
+    GF4_FOR_LIMBS(GF4_SPLIT_LIMB_)
+#undef GF4_SPLIT_LIMB_
+    gf4_reduce(out);
+}
+
+/** Store the four lanes of x into (a,b,c,d). */
+static INLINE_UNUSED void gf4_unpack (
+    gf_25519_t *a,
+    gf_25519_t *b,
+    gf_25519_t *c,
+    gf_25519_t *d,
+    const gf4_25519_t *x
+) {
+    gf4_25519_t y = *x;
+    __m256i l[5], t0, t1, t2, t3;
+
+    gf4_reduce(&y);
+#define GF4_MERGE_LIMB_(i) \
+    l[i] = _mm256_add_epi64(y.limb[2*(i)], _mm256_slli_epi64(y.limb[2*(i)+1], 26));
+    GF4_MERGE_LIMB_(0) GF4_MERGE_LIMB_(1) GF4_MERGE_LIMB_(2) GF4_MERGE_LIMB_(3) GF4_MERGE_LIMB_(4)
+#undef GF4_MERGE_LIMB_
+
+    t0 = _mm256_permute2x128_si256(l[0], l[2], 0x20);
+    t1 = _mm256_permute2x128_si256(l[1], l[3], 0x20);
+    t2 = _mm256_permute2x128_si256(l[0], l[2], 0x31);
+    t3 = _mm256_permute2x128_si256(l[1], l[3], 0x31);
+    _mm256_storeu_si256((__m256i *)a->limb, _mm256_unpacklo_epi64(t0, t1));
+    _mm256_storeu_si256((__m256i *)b->limb, _mm256_unpackhi_epi64(t0, t1));
+    _mm256_storeu_si256((__m256i *)c->limb, _mm256_unpacklo_epi64(t2, t3));
+    _mm256_storeu_si256((__m256i *)d->limb, _mm256_unpackhi_epi64(t2, t3));
+    a->limb[4] = _mm256_extract_epi64(l[4], 0);
+    b->limb[4] = _mm256_extract_epi64(l[4], 1);
+    c->limb[4] = _mm256_extract_epi64(l[4], 2);
+    d->limb[4] = _mm256_extract_epi64(l[4], 3);
+}
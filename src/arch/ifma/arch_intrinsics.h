@@ -0,0 +1,15 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#ifndef __ARCH_IFMA_ARCH_INTRINSICS_H__
+#define __ARCH_IFMA_ARCH_INTRINSICS_H__
+
+#if !defined(__AVX512F__) || !defined(__AVX512IFMA__)
+#error "ARCH=ifma requires a compiler targeting AVX-512 IFMA, eg -mavx512ifma or -march=icelake-client"
+#endif
+
+/* Every IFMA part also has AVX2, so the 4-way point arithmetic stays. */
+#include "../avx2/arch_intrinsics.h"
+
+#endif /* __ARCH_IFMA_ARCH_INTRINSICS_H__ */
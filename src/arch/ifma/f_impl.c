@@ -0,0 +1,180 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#include "../avx2/f_impl.c"
+
+#define GF8_MADDLO(acc, a, b) acc = _mm512_madd52lo_epu64(acc, a, b)
+#define GF8_MADDHI(acc, a, b) acc = _mm512_madd52hi_epu64(acc, a, b)
+
+static INLINE_UNUSED __m512i gf8_times19 (__m512i x) {
+    return _mm512_add_epi64(x, _mm512_add_epi64(_mm512_slli_epi64(x, 4), _mm512_slli_epi64(x, 1)));
+}
+
+/* vpmadd52huq returns bits 52..103 of each product, which in radix 2^51 is
+ * twice the weight of the next column up.  Fold columns 0..9 back into five
+ * using 2^255 = 19, then carry.  Every input column is below 15 * 2^52, so
+ * the folded sums stay below 2^61.
+ */
+static INLINE_UNUSED void gf8_finish (gf8_25519_t *out, const __m512i lo[9], const __m512i hi[9]) {
+    const __m512i mask = _mm512_set1_epi64((1ull<<51)-1);
+    __m512i c[5], z[5], carry;
+
+    z[0] = _mm512_add_epi64(lo[5], _mm512_add_epi64(hi[4], hi[4]));
+    z[1] = _mm512_add_epi64(lo[6], _mm512_add_epi64(hi[5], hi[5]));
+    z[2] = _mm512_add_epi64(lo[7], _mm512_add_epi64(hi[6], hi[6]));
+    z[3] = _mm512_add_epi64(lo[8], _mm512_add_epi64(hi[7], hi[7]));
+    z[4] = _mm512_add_epi64(hi[8], hi[8]);
+
+    c[0] = _mm512_add_epi64(lo[0], gf8_times19(z[0]));
+    c[1] = _mm512_add_epi64(_mm512_add_epi64(lo[1], _mm512_add_epi64(hi[0], hi[0])), gf8_times19(z[1]));
+    c[2] = _mm512_add_epi64(_mm512_add_epi64(lo[2], _mm512_add_epi64(hi[1], hi[1])), gf8_times19(z[2]));
+    c[3] = _mm512_add_epi64(_mm512_add_epi64(lo[3], _mm512_add_epi64(hi[2], hi[2])), gf8_times19(z[3]));
+    c[4] = _mm512_add_epi64(_mm512_add_epi64(lo[4], _mm512_add_epi64(hi[3], hi[3])), gf8_times19(z[4]));
+
+    for (unsigned int i=0; i<4; i++) {
+        c[i+1] = _mm512_add_epi64(c[i+1], _mm512_srli_epi64(c[i], 51));
+        c[i] = _mm512_and_si512(c[i], mask);
+    }
+    carry = _mm512_srli_epi64(c[4], 51);
+    c[4] = _mm512_and_si512(c[4], mask);
+    c[0] = _mm512_add_epi64(c[0], gf8_times19(carry));
+    c[1] = _mm512_add_epi64(c[1], _mm512_srli_epi64(c[0], 51));
+    c[0] = _mm512_and_si512(c[0], mask);
+
+    for (unsigned int i=0; i<5; i++) out->limb[i] = c[i];
+}
+
+/** 8-way multiply.  Requires: input limbs < 2^52. */
+void gf8_mul (gf8_25519_t *__restrict__ cs, const gf8_25519_t *as, const gf8_25519_t *bs) {
+    RISTRETTO_COUNT(gf_mul,8);
+    const __m512i *a = as->limb, *b = bs->limb;
+    __m512i lo[9], hi[9];
+
+    for (unsigned int k=0; k<9; k++) lo[k] = hi[k] = _mm512_setzero_si512();
+    GF8_MADDLO(lo[0], a[0], b[0]); GF8_MADDHI(hi[0], a[0], b[0]);
+    GF8_MADDLO(lo[1], a[0], b[1]); GF8_MADDHI(hi[1], a[0], b[1]);
+    GF8_MADDLO(lo[2], a[0], b[2]); GF8_MADDHI(hi[2], a[0], b[2]);
+    GF8_MADDLO(lo[3], a[0], b[3]); GF8_MADDHI(hi[3], a[0], b[3]);
+    GF8_MADDLO(lo[4], a[0], b[4]); GF8_MADDHI(hi[4], a[0], b[4]);
+    GF8_MADDLO(lo[1], a[1], b[0]); GF8_MADDHI(hi[1], a[1], b[0]);
+    GF8_MADDLO(lo[2], a[1], b[1]); GF8_MADDHI(hi[2], a[1], b[1]);
+    GF8_MADDLO(lo[3], a[1], b[2]); GF8_MADDHI(hi[3], a[1], b[2]);
+    GF8_MADDLO(lo[4], a[1], b[3]); GF8_MADDHI(hi[4], a[1], b[3]);
+    GF8_MADDLO(lo[5], a[1], b[4]); GF8_MADDHI(hi[5], a[1], b[4]);
+    GF8_MADDLO(lo[2], a[2], b[0]); GF8_MADDHI(hi[2], a[2], b[0]);
+    GF8_MADDLO(lo[3], a[2], b[1]); GF8_MADDHI(hi[3], a[2], b[1]);
+    GF8_MADDLO(lo[4], a[2], b[2]); GF8_MADDHI(hi[4], a[2], b[2]);
+    GF8_MADDLO(lo[5], a[2], b[3]); GF8_MADDHI(hi[5], a[2], b[3]);
+    GF8_MADDLO(lo[6], a[2], b[4]); GF8_MADDHI(hi[6], a[2], b[4]);
+    GF8_MADDLO(lo[3], a[3], b[0]); GF8_MADDHI(hi[3], a[3], b[0]);
+    GF8_MADDLO(lo[4], a[3], b[1]); GF8_MADDHI(hi[4], a[3], b[1]);
+    GF8_MADDLO(lo[5], a[3], b[2]); GF8_MADDHI(hi[5], a[3], b[2]);
+    GF8_MADDLO(lo[6], a[3], b[3]); GF8_MADDHI(hi[6], a[3], b[3]);
+    GF8_MADDLO(lo[7], a[3], b[4]); GF8_MADDHI(hi[7], a[3], b[4]);
+    GF8_MADDLO(lo[4], a[4], b[0]); GF8_MADDHI(hi[4], a[4], b[0]);
+    GF8_MADDLO(lo[5], a[4], b[1]); GF8_MADDHI(hi[5], a[4], b[1]);
+    GF8_MADDLO(lo[6], a[4], b[2]); GF8_MADDHI(hi[6], a[4], b[2]);
+    GF8_MADDLO(lo[7], a[4], b[3]); GF8_MADDHI(hi[7], a[4], b[3]);
+    GF8_MADDLO(lo[8], a[4], b[4]); GF8_MADDHI(hi[8], a[4], b[4]);
+
+    gf8_finish(cs, lo, hi);
+}
+
+/** 8-way square.  Requires: input limbs < 2^52. */
+void gf8_sqr (gf8_25519_t *__restrict__ cs, const gf8_25519_t *as) {
+    RISTRETTO_COUNT(gf_sqr,8);
+    const __m512i *a = as->limb;
+    __m512i lo[9], hi[9];
+
+    for (unsigned int k=0; k<9; k++) lo[k] = hi[k] = _mm512_setzero_si512();
+    GF8_MADDLO(lo[1], a[0], a[1]); GF8_MADDHI(hi[1], a[0], a[1]);
+    GF8_MADDLO(lo[2], a[0], a[2]); GF8_MADDHI(hi[2], a[0], a[2]);
+    GF8_MADDLO(lo[3], a[0], a[3]); GF8_MADDHI(hi[3], a[0], a[3]);
+    GF8_MADDLO(lo[4], a[0], a[4]); GF8_MADDHI(hi[4], a[0], a[4]);
+    GF8_MADDLO(lo[3], a[1], a[2]); GF8_MADDHI(hi[3], a[1], a[2]);
+    GF8_MADDLO(lo[4], a[1], a[3]); GF8_MADDHI(hi[4], a[1], a[3]);
+    GF8_MADDLO(lo[5], a[1], a[4]); GF8_MADDHI(hi[5], a[1], a[4]);
+    GF8_MADDLO(lo[5], a[2], a[3]); GF8_MADDHI(hi[5], a[2], a[3]);
+    GF8_MADDLO(lo[6], a[2], a[4]); GF8_MADDHI(hi[6], a[2], a[4]);
+    GF8_MADDLO(lo[7], a[3], a[4]); GF8_MADDHI(hi[7], a[3], a[4]);
+
+    /* Double the cross terms (2a_j may not fit 52 bits), then add the squares */
+    for (unsigned int k=1; k<8; k++) {
+        lo[k] = _mm512_add_epi64(lo[k], lo[k]);
+        hi[k] = _mm512_add_epi64(hi[k], hi[k]);
+    }
+    GF8_MADDLO(lo[0], a[0], a[0]); GF8_MADDHI(hi[0], a[0], a[0]);
+    GF8_MADDLO(lo[2], a[1], a[1]); GF8_MADDHI(hi[2], a[1], a[1]);
+    GF8_MADDLO(lo[4], a[2], a[2]); GF8_MADDHI(hi[4], a[2], a[2]);
+    GF8_MADDLO(lo[6], a[3], a[3]); GF8_MADDHI(hi[6], a[3], a[3]);
+    GF8_MADDLO(lo[8], a[4], a[4]); GF8_MADDHI(hi[8], a[4], a[4]);
+
+    gf8_finish(cs, lo, hi);
+}
+
+/** 8-way multiply by a small constant.  Requires: input limbs < 2^52. */
+void gf8_mulw_unsigned (gf8_25519_t *__restrict__ cs, const gf8_25519_t *as, uint32_t b) {
+    const __m512i *a = as->limb, w = _mm512_set1_epi64(b);
+    __m512i lo[9], hi[9];
+
+    for (unsigned int k=0; k<9; k++) lo[k] = hi[k] = _mm512_setzero_si512();
+    for (unsigned int i=0; i<5; i++) {
+        GF8_MADDLO(lo[i], a[i], w);
+        GF8_MADDHI(hi[i], a[i], w);
+    }
+    gf8_finish(cs, lo, hi);
+}
+
+static void gf8_sqrn (gf8_25519_t *__restrict__ y, const gf8_25519_t *x, int n) {
+    gf8_25519_t tmp;
+    assert(n>0);
+    if (n&1) {
+        gf8_sqr(y,x);
+        n--;
+    } else {
+        gf8_sqr(&tmp,x);
+        gf8_sqr(y,&tmp);
+        n-=2;
+    }
+    for (; n; n-=2) {
+        gf8_sqr(&tmp,y);
+        gf8_sqr(y,&tmp);
+    }
+}
+
+/* Same addition chain as gf_isr */
+void gf8_isr (mask_t succ[8], gf_25519_t *__restrict__ a, const gf_25519_t *x) {
+    RISTRETTO_COUNT(gf_isr,8);
+    gf8_25519_t L0, L1, L2, L3, X;
+    gf_25519_t r[8];
+
+    gf8_load(&X, x);
+    gf8_sqr (&L0, &X);
+    gf8_mul (&L1, &L0, &X);
+    gf8_sqr (&L0, &L1);
+    gf8_mul (&L1, &L0, &X);
+    gf8_sqrn(&L0, &L1, 3);
+    gf8_mul (&L2, &L0, &L1);
+    gf8_sqrn(&L0, &L2, 6);
+    gf8_mul (&L1, &L2, &L0);
+    gf8_sqr (&L2, &L1);
+    gf8_mul (&L0, &L2, &X);
+    gf8_sqrn(&L2, &L0, 12);
+    gf8_mul (&L0, &L2, &L1);
+    gf8_sqrn(&L2, &L0, 25);
+    gf8_mul (&L3, &L2, &L0);
+    gf8_sqrn(&L2, &L3, 25);
+    gf8_mul (&L1, &L2, &L0);
+    gf8_sqrn(&L2, &L1, 50);
+    gf8_mul (&L0, &L2, &L3);
+    gf8_sqrn(&L2, &L0, 125);
+    gf8_mul (&L3, &L2, &L0);
+    gf8_sqrn(&L2, &L3, 2);
+    gf8_mul (&L0, &L2, &X);
+    gf8_store(r, &L0);
+
+    for (unsigned int k=0; k<8; k++) {
+        succ[k] = gf_isr_finish(&a[k], &r[k], &x[k]);
+    }
+}
@@ -0,0 +1,88 @@
+/* Copyright (c) 2014-2018 Ristretto Developers, Cryptography Research, Inc.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+#include "../avx2/f_impl.h"
+
+/* Eight independent field elements, one per 64-bit lane of a zmm register.
+ * Limbs are in the same radix 2^51 as the x86_64 code, which leaves a bit of
+ * headroom under vpmadd52's 52-bit multiplier inputs.
+ *
+ * All gf8 inputs must have limbs < 2^52.  Everything here produces that,
+ * so unlike the scalar field there are no unreduced sums: gf8_add and
+ * gf8_sub reduce weakly as they go.  The customers are the exponentiation
+ * inside gf8_isr and the point arithmetic on ristretto255_point_batch_t.
+ */
+#define GF_HAS_GF8 1
+
+typedef struct {
+    __m512i limb[5];
+} gf8_25519_t;
+
+void gf8_mul (gf8_25519_t *__restrict__ out, const gf8_25519_t *a, const gf8_25519_t *b);
+void gf8_sqr (gf8_25519_t *__restrict__ out, const gf8_25519_t *a);
+void gf8_mulw_unsigned (gf8_25519_t *__restrict__ out, const gf8_25519_t *a, uint32_t b);
+
+/** Eight gf_isr's at once: succ[k] = gf_isr(&a[k], &x[k]).  No aliasing. */
+void gf8_isr (mask_t succ[8], gf_25519_t *__restrict__ a, const gf_25519_t *x);
+
+/* Lane k of the gather/scatter index is element k of a gf_25519_t[8] */
+#define GF8_STRIDE_ (sizeof(gf_25519_t) / sizeof(uint64_t))
+#define GF8_INDEX_ _mm512_setr_epi64(0, GF8_STRIDE_, 2*GF8_STRIDE_, 3*GF8_STRIDE_, \
+    4*GF8_STRIDE_, 5*GF8_STRIDE_, 6*GF8_STRIDE_, 7*GF8_STRIDE_)
+
+/* Same as gf_weak_reduce, on limbs of up to 62 bits */
+static INLINE_UNUSED void gf8_weak_reduce_ (gf8_25519_t *out, const __m512i l[5]) {
+    const __m512i mask = _mm512_set1_epi64((1ull<<51)-1);
+    __m512i top = _mm512_srli_epi64(l[4], 51);
+    for (unsigned int i=4; i>0; i--) {
+        out->limb[i] = _mm512_add_epi64(_mm512_and_si512(l[i], mask), _mm512_srli_epi64(l[i-1], 51));
+    }
+    top = _mm512_add_epi64(top, _mm512_add_epi64(_mm512_slli_epi64(top, 4), _mm512_slli_epi64(top, 1)));
+    out->limb[0] = _mm512_add_epi64(_mm512_and_si512(l[0], mask), top);
+}
+
+/** Load x[0..7] into the lanes of out, weakly reducing them. */
+static INLINE_UNUSED void gf8_load (gf8_25519_t *out, const gf_25519_t *x) {
+    const __m512i idx = GF8_INDEX_;
+    __m512i l[5];
+    for (unsigned int i=0; i<5; i++) {
+        l[i] = _mm512_i64gather_epi64(idx, (const void *)&x[0].limb[i], 8);
+    }
+    gf8_weak_reduce_(out, l);
+}
+
+/** out = a + b */
+static INLINE_UNUSED void gf8_add (gf8_25519_t *out, const gf8_25519_t *a, const gf8_25519_t *b) {
+    __m512i l[5];
+    for (unsigned int i=0; i<5; i++) l[i] = _mm512_add_epi64(a->limb[i], b->limb[i]);
+    gf8_weak_reduce_(out, l);
+}
+
+/** out = a - b, biased by 4p, which is more than any input limb */
+static INLINE_UNUSED void gf8_sub (gf8_25519_t *out, const gf8_25519_t *a, const gf8_25519_t *b) {
+    const __m512i bias0 = _mm512_set1_epi64((1ull<<53) - 76), bias = _mm512_set1_epi64((1ull<<53) - 4);
+    __m512i l[5];
+    for (unsigned int i=0; i<5; i++) {
+        l[i] = _mm512_sub_epi64(_mm512_add_epi64(a->limb[i], i ? bias : bias0), b->limb[i]);
+    }
+    gf8_weak_reduce_(out, l);
+}
+
+/** Lane k of out = bit k of pick ? b[k] : a[k] */
+static INLINE_UNUSED void gf8_cond_sel (
+    gf8_25519_t *out,
+    const gf8_25519_t *a,
+    const gf8_25519_t *b,
+    __mmask8 pick
+) {
+    for (unsigned int i=0; i<5; i++) out->limb[i] = _mm512_mask_blend_epi64(pick, a->limb[i], b->limb[i]);
+}
+
+/** Store the lanes of a into x[0..7]. */
+static INLINE_UNUSED void gf8_store (gf_25519_t *x, const gf8_25519_t *a) {
+    const __m512i idx = GF8_INDEX_;
+    for (unsigned int i=0; i<5; i++) {
+        _mm512_i64scatter_epi64((void *)&x[0].limb[i], idx, a->limb[i], 8);
+    }
+}
@@ -0,0 +1,6 @@
+/* Copyright (c) 2018 Ristretto Developers.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+/* Scalars use the x86_64 code unchanged. */
+#include "../x86_64/sc_impl.h"
@@ -2,10 +2,12 @@
  * Released under the MIT License.  See LICENSE.txt for license information.
  */
 
+#define _XOPEN_SOURCE 600 /* f_field.h pulls in word.h's posix_memalign, after <ristretto255.h> */
+
 #include <ristretto255.h>
 #include "f_field.h"
 
-void gf_mul (gf_25519_t *__restrict__ cs, const gf_25519_t *as, const gf_25519_t *bs) {
+static RISTRETTO_INLINE void gf_mul_inner (gf_25519_t *__restrict__ cs, const gf_25519_t *as, const gf_25519_t *bs) {
     const uint64_t *a = as->limb, *b = bs->limb, mask = ((1ull<<51)-1);
 
     uint64_t bh[4];
@@ -35,6 +37,11 @@ void gf_mul (gf_25519_t *__restrict__ cs, const gf_25519_t *as, const gf_25519_t
     c[1] += accum;
 }
 
+void gf_mul (gf_25519_t *__restrict__ cs, const gf_25519_t *as, const gf_25519_t *bs) {
+    RISTRETTO_COUNT(gf_mul,1);
+    gf_mul_inner(cs,as,bs);
+}
+
 void gf_mulw_unsigned (gf_25519_t *__restrict__ cs, const gf_25519_t *as, uint32_t b) {
     const uint64_t *a = as->limb, mask = ((1ull<<51)-1);
     int i;
@@ -58,5 +65,6 @@ void gf_mulw_unsigned (gf_25519_t *__restrict__ cs, const gf_25519_t *as, uint32
 }
 
 void gf_sqr (gf_25519_t *__restrict__ cs, const gf_25519_t *as) {
-    gf_mul(cs,as,as); /* Performs better with dedicated square */
+    RISTRETTO_COUNT(gf_sqr,1);
+    gf_mul_inner(cs,as,as); /* Performs better with dedicated square */
 }
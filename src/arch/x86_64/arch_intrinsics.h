@@ -7,6 +7,9 @@
 
 #define ARCH_WORD_BITS 64
 
+/* scalar.c should include sc_impl.h */
+#define ARCH_HAS_SC_IMPL 1
+
 #include <stdint.h>
 
 /* FUTURE: autogenerate */
@@ -7,6 +7,7 @@
 
 /** Requires: input limbs < 9*2^51 */
 void gf_mul (gf_25519_t *__restrict__ cs, const gf_25519_t *as, const gf_25519_t *bs) {
+    RISTRETTO_COUNT(gf_mul,1);
     const uint64_t *a = as->limb, *b = bs->limb, mask = ((1ull<<51)-1);
     uint64_t *c = cs->limb;
 
@@ -82,9 +83,8 @@ void gf_mul (gf_25519_t *__restrict__ cs, const gf_25519_t *as, const gf_25519_t
     c[1] = c1 + (accum1>>51);
 }
 
-void gf_sqr (gf_25519_t *__restrict__ cs, const gf_25519_t *as) {
-    const uint64_t *a = as->limb, mask = ((1ull<<51)-1);
-    uint64_t *c = cs->limb;
+static RISTRETTO_INLINE void gf_sqr_limbs (uint64_t *__restrict__ c, const uint64_t *a) {
+    const uint64_t mask = ((1ull<<51)-1);
 
     __uint128_t accum0, accum1, accum2;
 
@@ -141,6 +141,32 @@ void gf_sqr (gf_25519_t *__restrict__ cs, const gf_25519_t *as) {
     c[1] = c1 + (accum1>>51);
 }
 
+void gf_sqr (gf_25519_t *__restrict__ cs, const gf_25519_t *as) {
+    RISTRETTO_COUNT(gf_sqr,1);
+    gf_sqr_limbs(cs->limb, as->limb);
+}
+
+/* The squaring chains in gf_isr are most of its time, so keep them in one
+ * function instead of making a call per squaring.
+ */
+void gf_sqrn (gf_25519_t *__restrict__ ys, const gf_25519_t *xs, int n) {
+    uint64_t t[5];
+    assert(n>0);
+    RISTRETTO_COUNT(gf_sqr,n);
+    if (n&1) {
+        gf_sqr_limbs(ys->limb, xs->limb);
+        n--;
+    } else {
+        gf_sqr_limbs(t, xs->limb);
+        gf_sqr_limbs(ys->limb, t);
+        n-=2;
+    }
+    for (; n; n-=2) {
+        gf_sqr_limbs(t, ys->limb);
+        gf_sqr_limbs(ys->limb, t);
+    }
+}
+
 void gf_mulw_unsigned (gf_25519_t *__restrict__ cs, const gf_25519_t *as, uint32_t b) {
     const uint64_t *a = as->limb, mask = ((1ull<<51)-1);
     uint64_t *c = cs->limb;
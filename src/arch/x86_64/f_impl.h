@@ -7,6 +7,10 @@
 
 #define LIMB_PLACE_VALUE(i) 51
 
+/* Square x, n times, without a call per squaring */
+#define GF_HAS_SQRN 1
+void gf_sqrn (gf_25519_t *__restrict__ y, const gf_25519_t *x, int n);
+
 void gf_add_RAW (gf_25519_t *out, const gf_25519_t *a, const gf_25519_t *b) {
     for (unsigned int i=0; i<5; i++) {
         out->limb[i] = a->limb[i] + b->limb[i];
@@ -0,0 +1,301 @@
+/* Copyright (c) 2018 Ristretto Developers.
+ * Released under the MIT License.  See LICENSE.txt for license information.
+ */
+
+/* Montgomery multiplication mod the group order with MULX, ADCX and ADOX.
+ * Included by scalar.c after sc_p, MONTGOMERY_FACTOR and sc_subx, in place
+ * of the generic sc_montmul, sc_montmuladd and sc_montsqr.
+ *
+ * The product or square goes into t0..t7 with two carry chains in flight,
+ * and is then reduced one word at a time.  p = 2^252 + d where d is two
+ * words long, so each reduction step takes two multiplies and a shift
+ * rather than four multiplies.  The result is below 2p, even with an
+ * addend below p, so the top word never carries and one conditional
+ * subtraction finishes the job.  That is spelled out here rather than left
+ * to sc_subx: the call and its loops cost as much as a fifth of the
+ * multiply.
+ */
+#if defined(__BMI2__) && defined(__ADX__)
+#define SC_HAS_ARCH_MONTMUL 1
+
+static const ristretto_word_t sc_zero_word = 0;
+
+/* t += m_i*p << 64i for i = 0..3, with m_i chosen to clear t_i */
+#define SC_MONTGOMERY_REDUCE \
+        "movq %[t0], %%rdx\n\t" \
+        "imulq %[factor], %%rdx\n\t" \
+        "movq %%rdx, %%rcx\n\t" \
+        "shrq $4, %%rcx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq %[p0], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t0]\n\t" \
+        "adoxq %%rbx, %[t1]\n\t" \
+        "mulxq %[p1], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t1]\n\t" \
+        "adoxq %%rbx, %[t2]\n\t" \
+        "movl $60, %%ebx\n\t" \
+        "shlxq %%rbx, %%rdx, %%rax\n\t" \
+        "adcxq %[zero], %[t2]\n\t" \
+        "adoxq %[zero], %[t3]\n\t" \
+        "adcxq %%rax, %[t3]\n\t" \
+        "adoxq %[zero], %[t4]\n\t" \
+        "adcxq %%rcx, %[t4]\n\t" \
+        "adoxq %[zero], %[t5]\n\t" \
+        "adcxq %[zero], %[t5]\n\t" \
+        "adoxq %[zero], %[t6]\n\t" \
+        "adcxq %[zero], %[t6]\n\t" \
+        "adoxq %[zero], %[t7]\n\t" \
+        "adcxq %[zero], %[t7]\n\t" \
+        "movq %[t1], %%rdx\n\t" \
+        "imulq %[factor], %%rdx\n\t" \
+        "movq %%rdx, %%rcx\n\t" \
+        "shrq $4, %%rcx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq %[p0], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t1]\n\t" \
+        "adoxq %%rbx, %[t2]\n\t" \
+        "mulxq %[p1], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t2]\n\t" \
+        "adoxq %%rbx, %[t3]\n\t" \
+        "movl $60, %%ebx\n\t" \
+        "shlxq %%rbx, %%rdx, %%rax\n\t" \
+        "adcxq %[zero], %[t3]\n\t" \
+        "adoxq %[zero], %[t4]\n\t" \
+        "adcxq %%rax, %[t4]\n\t" \
+        "adoxq %[zero], %[t5]\n\t" \
+        "adcxq %%rcx, %[t5]\n\t" \
+        "adoxq %[zero], %[t6]\n\t" \
+        "adcxq %[zero], %[t6]\n\t" \
+        "adoxq %[zero], %[t7]\n\t" \
+        "adcxq %[zero], %[t7]\n\t" \
+        "movq %[t2], %%rdx\n\t" \
+        "imulq %[factor], %%rdx\n\t" \
+        "movq %%rdx, %%rcx\n\t" \
+        "shrq $4, %%rcx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq %[p0], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t2]\n\t" \
+        "adoxq %%rbx, %[t3]\n\t" \
+        "mulxq %[p1], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t3]\n\t" \
+        "adoxq %%rbx, %[t4]\n\t" \
+        "movl $60, %%ebx\n\t" \
+        "shlxq %%rbx, %%rdx, %%rax\n\t" \
+        "adcxq %[zero], %[t4]\n\t" \
+        "adoxq %[zero], %[t5]\n\t" \
+        "adcxq %%rax, %[t5]\n\t" \
+        "adoxq %[zero], %[t6]\n\t" \
+        "adcxq %%rcx, %[t6]\n\t" \
+        "adoxq %[zero], %[t7]\n\t" \
+        "adcxq %[zero], %[t7]\n\t" \
+        "movq %[t3], %%rdx\n\t" \
+        "imulq %[factor], %%rdx\n\t" \
+        "movq %%rdx, %%rcx\n\t" \
+        "shrq $4, %%rcx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq %[p0], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t3]\n\t" \
+        "adoxq %%rbx, %[t4]\n\t" \
+        "mulxq %[p1], %%rax, %%rbx\n\t" \
+        "adcxq %%rax, %[t4]\n\t" \
+        "adoxq %%rbx, %[t5]\n\t" \
+        "movl $60, %%ebx\n\t" \
+        "shlxq %%rbx, %%rdx, %%rax\n\t" \
+        "adcxq %[zero], %[t5]\n\t" \
+        "adoxq %[zero], %[t6]\n\t" \
+        "adcxq %%rax, %[t6]\n\t" \
+        "adoxq %[zero], %[t7]\n\t" \
+        "adcxq %%rcx, %[t7]\n\t"
+
+/* t = a*b, one row per word of b.  Low halves ride OF, high CF. */
+#define SC_ASM_PRODUCT \
+        "movq 0(%[b]), %%rdx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq 0(%[a]), %[t0], %[t1]\n\t" \
+        "mulxq 8(%[a]), %%rax, %[t2]\n\t" \
+        "adcxq %%rax, %[t1]\n\t" \
+        "mulxq 16(%[a]), %%rax, %[t3]\n\t" \
+        "adcxq %%rax, %[t2]\n\t" \
+        "mulxq 24(%[a]), %%rax, %[t4]\n\t" \
+        "adcxq %%rax, %[t3]\n\t" \
+        "adcxq %[zero], %[t4]\n\t" \
+        "movq 8(%[b]), %%rdx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq 0(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t1]\n\t" \
+        "adcxq %%rbx, %[t2]\n\t" \
+        "mulxq 8(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t2]\n\t" \
+        "adcxq %%rbx, %[t3]\n\t" \
+        "mulxq 16(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t3]\n\t" \
+        "adcxq %%rbx, %[t4]\n\t" \
+        "mulxq 24(%[a]), %%rax, %[t5]\n\t" \
+        "adoxq %%rax, %[t4]\n\t" \
+        "adcxq %[zero], %[t5]\n\t" \
+        "adoxq %[zero], %[t5]\n\t" \
+        "movq 16(%[b]), %%rdx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq 0(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t2]\n\t" \
+        "adcxq %%rbx, %[t3]\n\t" \
+        "mulxq 8(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t3]\n\t" \
+        "adcxq %%rbx, %[t4]\n\t" \
+        "mulxq 16(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t4]\n\t" \
+        "adcxq %%rbx, %[t5]\n\t" \
+        "mulxq 24(%[a]), %%rax, %[t6]\n\t" \
+        "adoxq %%rax, %[t5]\n\t" \
+        "adcxq %[zero], %[t6]\n\t" \
+        "adoxq %[zero], %[t6]\n\t" \
+        "movq 24(%[b]), %%rdx\n\t" \
+        "xorl %%eax, %%eax\n\t" \
+        "mulxq 0(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t3]\n\t" \
+        "adcxq %%rbx, %[t4]\n\t" \
+        "mulxq 8(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t4]\n\t" \
+        "adcxq %%rbx, %[t5]\n\t" \
+        "mulxq 16(%[a]), %%rax, %%rbx\n\t" \
+        "adoxq %%rax, %[t5]\n\t" \
+        "adcxq %%rbx, %[t6]\n\t" \
+        "mulxq 24(%[a]), %%rax, %[t7]\n\t" \
+        "adoxq %%rax, %[t6]\n\t" \
+        "adcxq %[zero], %[t7]\n\t" \
+        "adoxq %[zero], %[t7]\n\t"
+
+#define SC_ASM_OUTPUTS \
+    [t0]"=&r"(t[0]), [t1]"=&r"(t[1]), [t2]"=&r"(t[2]), [t3]"=&r"(t[3]), \
+    [t4]"=&r"(t[4]), [t5]"=&r"(t[5]), [t6]"=&r"(t[6]), [t7]"=&r"(t[7])
+
+#define SC_ASM_CONSTANTS \
+    [factor]"m"(MONTGOMERY_FACTOR), [p0]"m"(sc_p.limb[0]), [p1]"m"(sc_p.limb[1]), \
+    [zero]"m"(sc_zero_word)
+
+/* out = t - p, plus p again if that borrowed */
+static RISTRETTO_INLINE void sc_montfinish (
+    scalar_t *out,
+    const ristretto_word_t t[SCALAR_LIMBS]
+) {
+    ristretto_dsword_t chain = 0;
+    ristretto_word_t r0, r1, r2, r3, borrow;
+
+    chain = (chain + t[0]) - sc_p.limb[0]; r0 = chain; chain >>= WBITS;
+    chain = (chain + t[1]) - sc_p.limb[1]; r1 = chain; chain >>= WBITS;
+    chain = (chain + t[2]) - sc_p.limb[2]; r2 = chain; chain >>= WBITS;
+    chain = (chain + t[3]) - sc_p.limb[3]; r3 = chain; chain >>= WBITS;
+    borrow = chain; /* = 0 or -1 */
+
+    chain = 0;
+    chain = (chain + r0) + (sc_p.limb[0] & borrow); out->limb[0] = chain; chain >>= WBITS;
+    chain = (chain + r1) + (sc_p.limb[1] & borrow); out->limb[1] = chain; chain >>= WBITS;
+    chain = (chain + r2) + (sc_p.limb[2] & borrow); out->limb[2] = chain; chain >>= WBITS;
+    chain = (chain + r3) + (sc_p.limb[3] & borrow); out->limb[3] = chain;
+}
+
+static RISTRETTO_NOINLINE void sc_montmul (
+    scalar_t *out,
+    const scalar_t *a,
+    const scalar_t *b
+) {
+    ristretto_word_t t[8];
+    __asm__ (
+        SC_ASM_PRODUCT
+        SC_MONTGOMERY_REDUCE
+        : SC_ASM_OUTPUTS
+        : [a]"r"(a->limb), [b]"r"(b->limb), SC_ASM_CONSTANTS
+        : "rax", "rbx", "rcx", "rdx", "cc", "memory"
+    );
+    sc_montfinish(out, &t[4]);
+}
+
+/* out = (a*b + c)/R: c is added to the product before reducing */
+static RISTRETTO_NOINLINE void sc_montmuladd (
+    scalar_t *out,
+    const scalar_t *a,
+    const scalar_t *b,
+    const scalar_t *c
+) {
+    /* Passed in rcx, which the reduction is free to clobber once c has been
+     * added, so that debug builds with a frame pointer have enough registers.
+     */
+    const ristretto_word_t *cl = c->limb;
+    ristretto_word_t t[8];
+    __asm__ (
+        SC_ASM_PRODUCT
+        "addq 0(%[c]), %[t0]\n\t"
+        "adcq 8(%[c]), %[t1]\n\t"
+        "adcq 16(%[c]), %[t2]\n\t"
+        "adcq 24(%[c]), %[t3]\n\t"
+        "adcq %[zero], %[t4]\n\t"
+        "adcq %[zero], %[t5]\n\t"
+        "adcq %[zero], %[t6]\n\t"
+        "adcq %[zero], %[t7]\n\t"
+        SC_MONTGOMERY_REDUCE
+        : SC_ASM_OUTPUTS, [c]"+c"(cl)
+        : [a]"r"(a->limb), [b]"r"(b->limb), SC_ASM_CONSTANTS
+        : "rax", "rbx", "rdx", "cc", "memory"
+    );
+    sc_montfinish(out, &t[4]);
+}
+
+static RISTRETTO_NOINLINE void sc_montsqr (
+    scalar_t *out,
+    const scalar_t *a
+) {
+    ristretto_word_t t[8];
+    __asm__ (
+        /* Cross products a_i*a_j for i < j */
+        "movq 0(%[a]), %%rdx\n\t"
+        "xorl %%eax, %%eax\n\t"
+        "mulxq 8(%[a]), %[t1], %[t2]\n\t"
+        "mulxq 16(%[a]), %%rax, %[t3]\n\t"
+        "adcxq %%rax, %[t2]\n\t"
+        "mulxq 24(%[a]), %%rax, %[t4]\n\t"
+        "adcxq %%rax, %[t3]\n\t"
+        "movq 8(%[a]), %%rdx\n\t"
+        "mulxq 24(%[a]), %%rax, %[t5]\n\t"
+        "adcxq %%rax, %[t4]\n\t"
+        "adcxq %[zero], %[t5]\n\t"
+        "mulxq 16(%[a]), %%rax, %%rbx\n\t"
+        "adoxq %%rax, %[t3]\n\t"
+        "adoxq %%rbx, %[t4]\n\t"
+        "movq 16(%[a]), %%rdx\n\t"
+        "mulxq 24(%[a]), %%rax, %[t6]\n\t"
+        "adoxq %%rax, %[t5]\n\t"
+        "adoxq %[zero], %[t6]\n\t"
+        /* Double them on CF, and add the squares on OF */
+        "xorl %%eax, %%eax\n\t"
+        "movq 0(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %[t0], %%rbx\n\t"
+        "movq %[zero], %[t7]\n\t"
+        "adcxq %[t1], %[t1]\n\t"
+        "adcxq %[t2], %[t2]\n\t"
+        "adcxq %[t3], %[t3]\n\t"
+        "adcxq %[t4], %[t4]\n\t"
+        "adcxq %[t5], %[t5]\n\t"
+        "adcxq %[t6], %[t6]\n\t"
+        "adcxq %[zero], %[t7]\n\t"
+        "adoxq %%rbx, %[t1]\n\t"
+        "movq 8(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %%rax, %%rbx\n\t"
+        "adoxq %%rax, %[t2]\n\t"
+        "adoxq %%rbx, %[t3]\n\t"
+        "movq 16(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %%rax, %%rbx\n\t"
+        "adoxq %%rax, %[t4]\n\t"
+        "adoxq %%rbx, %[t5]\n\t"
+        "movq 24(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %%rax, %%rbx\n\t"
+        "adoxq %%rax, %[t6]\n\t"
+        "adoxq %%rbx, %[t7]\n\t"
+        SC_MONTGOMERY_REDUCE
+        : SC_ASM_OUTPUTS
+        : [a]"r"(a->limb), SC_ASM_CONSTANTS
+        : "rax", "rbx", "rcx", "rdx", "cc", "memory"
+    );
+    sc_montfinish(out, &t[4]);
+}
+
+#endif /* __BMI2__ && __ADX__ */
@@ -0,0 +1,129 @@
+/**
+ * @file batch.c
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Randomized batch verification of s*B == R + c*A equations.
+ */
+
+#define _XOPEN_SOURCE 600 /* for posix_memalign */
+
+#include <ristretto255.h>
+#include "word.h"
+
+#define scalar_t ristretto255_scalar_t
+#define point_t ristretto255_point_t
+
+/* Bytes of randomness in each weight */
+#define BATCH_WEIGHT_BYTES 16
+
+struct batch {
+    const scalar_t *s, *c;
+    const point_t *R, *A;
+    scalar_t *zs;        /* z[i]*s[i] */
+    scalar_t *weights;   /* z[i], z[i]*c[i] */
+    point_t *points;     /* R[i], A[i] */
+    const ristretto255_allocator_t *allocator;
+    const ristretto255_executor_t *executor;
+    int out_of_memory;
+};
+
+/* Check equations lo..hi-1, on their own and unweighted if there is only
+ * one.  Either way the right side is the same multiscalar product.
+ */
+static ristretto_bool_t batch_check(struct batch *b, size_t lo, size_t hi) {
+    point_t lhs, rhs;
+    scalar_t sum, single[2];
+    const scalar_t *weights = &b->weights[2*lo];
+    size_t i;
+
+    if (hi - lo == 1) {
+        ristretto255_scalar_copy(&sum, &b->s[lo]);
+        ristretto255_scalar_copy(&single[0], &ristretto255_scalar_one);
+        ristretto255_scalar_copy(&single[1], &b->c[lo]);
+        weights = single;
+    } else {
+        ristretto255_scalar_copy(&sum, &b->zs[lo]);
+        for (i=lo+1; i<hi; i++) ristretto255_scalar_add(&sum, &sum, &b->zs[i]);
+    }
+    ristretto255_precomputed_scalarmul_non_secret(&lhs, ristretto255_precomputed_base, &sum);
+
+    if (ristretto255_multiscalar_mul_non_secret_parallel(&rhs, weights, &b->points[2*lo],
+            2*(hi-lo), b->allocator, b->executor) != RISTRETTO_SUCCESS) {
+        b->out_of_memory = 1;
+        return RISTRETTO_FALSE;
+    }
+    return ristretto255_point_eq(&lhs, &rhs);
+}
+
+/* Find the false equations among lo..hi-1, which are known to contain one.
+ * If the left half holds then the right half can't, so it isn't checked.
+ */
+static void batch_bisect(struct batch *b, size_t lo, size_t hi, size_t *bad, size_t *nbad) {
+    if (b->out_of_memory) return;
+    if (hi - lo == 1) {
+        bad[(*nbad)++] = lo;
+        return;
+    }
+
+    size_t mid = lo + (hi-lo)/2;
+    if (batch_check(b, lo, mid)) {
+        batch_bisect(b, mid, hi, bad, nbad);
+    } else {
+        batch_bisect(b, lo, mid, bad, nbad);
+        if (!batch_check(b, mid, hi)) batch_bisect(b, mid, hi, bad, nbad);
+    }
+}
+
+ristretto_error_t ristretto255_batch_verify (
+    size_t *bad,
+    size_t *nbad,
+    const scalar_t *s,
+    const point_t *R,
+    const scalar_t *c,
+    const point_t *A,
+    size_t n,
+    const ristretto255_rng_t *rng,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) {
+    struct batch b;
+    unsigned char ser[BATCH_WEIGHT_BYTES];
+    size_t i;
+    ristretto_bool_t ok;
+
+    if (bad) *nbad = 0;
+    if (n == 0) return RISTRETTO_SUCCESS;
+
+    const size_t bytes = 2*n*sizeof(point_t) + 3*n*sizeof(scalar_t);
+    b.points = (point_t *)ristretto_alloc(allocator, bytes);
+    if (b.points == NULL) return RISTRETTO_FAILURE;
+    b.weights = (scalar_t *)&b.points[2*n];
+    b.zs = &b.weights[2*n];
+    b.s = s;
+    b.c = c;
+    b.R = R;
+    b.A = A;
+    b.allocator = allocator;
+    b.executor = executor;
+    b.out_of_memory = 0;
+
+    for (i=0; i<n; i++) {
+        rng->fill(rng->ctx, ser, sizeof(ser));
+        ristretto255_scalar_decode_long(&b.weights[2*i], ser, sizeof(ser));
+        ristretto255_scalar_mul(&b.weights[2*i+1], &b.weights[2*i], &c[i]);
+        ristretto255_scalar_mul(&b.zs[i], &b.weights[2*i], &s[i]);
+        ristretto255_point_copy(&b.points[2*i], &R[i]);
+        ristretto255_point_copy(&b.points[2*i+1], &A[i]);
+    }
+
+    ok = batch_check(&b, 0, n);
+    if (!ok && bad) {
+        batch_bisect(&b, 0, n, bad, nbad);
+        if (b.out_of_memory) *nbad = 0;
+    }
+
+    ristretto_bzero(ser, sizeof(ser));
+    ristretto_free(allocator, b.points, bytes);
+    return ristretto_succeed_if(ok);
+}
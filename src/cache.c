@@ -0,0 +1,283 @@
+/**
+ * @file cache.c
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Bounded, sharded cache of decoded points and their wNAF tables.
+ */
+
+#define _XOPEN_SOURCE 600 /* for posix_memalign and pthreads */
+
+#include <ristretto255.h>
+#include <ristretto255_cache.h>
+#include <pthread.h>
+#include "word.h"
+
+#define point_t ristretto255_point_t
+#define wnaf_t ristretto255_wnaf_precomputed_t
+
+/* Entries each encoding can use.  An encoding only ever lives in its own
+ * set, so a lookup reads at most this many, however the keys collide.
+ */
+#define CACHE_WAYS 8
+#define CACHE_MAX_SHARDS 64
+
+struct cache_entry {
+    unsigned char ser[RISTRETTO255_SER_BYTES];
+    point_t pt;
+    wnaf_t *table;
+    unsigned int pins;      /* callers holding the table, plus one while it is built */
+    unsigned char valid;    /* ser, pt and table are filled in */
+    unsigned char referenced;
+};
+
+struct cache_set {
+    struct cache_entry way[CACHE_WAYS];
+    unsigned int hand;
+};
+
+/* Space to build one table in, so that a miss never allocates.  Each shard
+ * has one, with its own lock so that a build doesn't block lookups.
+ */
+struct cache_scratch {
+    pthread_mutex_t lock;
+    unsigned char *mem;
+    size_t bytes;
+};
+
+struct ristretto255_point_cache_s {
+    size_t nsets, bytes, table_bytes;
+    unsigned int nshards, table_bits;
+    pthread_mutex_t *locks;
+    struct cache_scratch *scratch;
+    struct cache_set *sets;
+    unsigned char *tables;
+};
+
+/* The tables, then the scratch, each aligned for the vector types */
+#define CACHE_ALIGN 64
+
+static size_t cache_align(size_t x) {
+    return (x + CACHE_ALIGN-1) & ~(size_t)(CACHE_ALIGN-1);
+}
+
+static unsigned int cache_nshards(size_t nsets) {
+    return nsets < CACHE_MAX_SHARDS ? nsets : CACHE_MAX_SHARDS;
+}
+
+/* Everything a cache of nsets sets takes, in one allocation */
+static size_t cache_bytes(size_t nsets, size_t table_bytes, size_t scratch_bytes) {
+    const unsigned int nshards = cache_nshards(nsets);
+    return cache_align(nsets * CACHE_WAYS * table_bytes) + nshards * cache_align(scratch_bytes)
+        + nsets * sizeof(struct cache_set) + sizeof(ristretto255_point_cache_t)
+        + nshards * (sizeof(pthread_mutex_t) + sizeof(struct cache_scratch));
+}
+
+/* An allocator that hands out a shard's scratch, for ristretto255_wnaf_precompute */
+static void *cache_scratch_alloc(void *ctx, size_t size, size_t align) {
+    struct cache_scratch *scratch = (struct cache_scratch *)ctx;
+    if (size > scratch->bytes || (uintptr_t)scratch->mem % align) return NULL;
+    return scratch->mem;
+}
+
+static void cache_scratch_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx; (void)ptr; (void)size;
+}
+
+/* FNV-1a over the whole encoding.  Colliding keys only crowd one set. */
+static size_t cache_set_index(const ristretto255_point_cache_t *cache, const unsigned char *ser) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    unsigned int i;
+    for (i=0; i<RISTRETTO255_SER_BYTES; i++) {
+        h = (h ^ ser[i]) * 0x100000001b3ull;
+    }
+    return (size_t)(h ^ (h>>32)) & (cache->nsets-1);
+}
+
+static pthread_mutex_t *cache_lock(const ristretto255_point_cache_t *cache, size_t set) {
+    return &cache->locks[set % cache->nshards];
+}
+
+ristretto_error_t ristretto255_point_cache_create (
+    ristretto255_point_cache_t **out,
+    size_t max_bytes,
+    unsigned int table_bits,
+    const ristretto255_allocator_t *allocator
+) {
+    *out = NULL;
+    const size_t table_bytes = ristretto255_sizeof_wnaf_precomputed(table_bits),
+        scratch_bytes = ristretto255_wnaf_precompute_scratch_size(table_bits);
+    if (table_bytes == 0) return RISTRETTO_FAILURE;
+
+    /* The scratch for building tables counts against max_bytes too */
+    if (max_bytes < cache_bytes(1, table_bytes, scratch_bytes)) return RISTRETTO_FAILURE;
+    size_t nsets = 1;
+    while (nsets <= SIZE_MAX / 4 / (CACHE_WAYS * table_bytes)
+           && cache_bytes(nsets*2, table_bytes, scratch_bytes) <= max_bytes) {
+        nsets *= 2;
+    }
+    const unsigned int nshards = cache_nshards(nsets);
+
+    /* Tables and scratch come first, to keep their alignment */
+    const size_t bytes = cache_bytes(nsets, table_bytes, scratch_bytes),
+        tables_end = cache_align(nsets*CACHE_WAYS*table_bytes),
+        scratch_end = tables_end + nshards*cache_align(scratch_bytes);
+    unsigned char *mem = ristretto_alloc(allocator, bytes);
+    if (mem == NULL) return RISTRETTO_FAILURE;
+    memset(mem + scratch_end, 0, bytes - scratch_end);
+
+    ristretto255_point_cache_t *cache = (ristretto255_point_cache_t *)
+        (mem + scratch_end + nsets*sizeof(struct cache_set));
+    cache->nsets = nsets;
+    cache->bytes = bytes;
+    cache->table_bytes = table_bytes;
+    cache->nshards = nshards;
+    cache->table_bits = table_bits;
+    cache->tables = mem;
+    cache->sets = (struct cache_set *)(mem + scratch_end);
+    cache->locks = (pthread_mutex_t *)&cache[1];
+    cache->scratch = (struct cache_scratch *)&cache->locks[nshards];
+
+    size_t i;
+    unsigned int j;
+    for (i=0; i<nsets; i++) {
+        for (j=0; j<CACHE_WAYS; j++) {
+            cache->sets[i].way[j].table = (wnaf_t *)(mem + (i*CACHE_WAYS + j)*table_bytes);
+        }
+    }
+    for (j=0; j<nshards; j++) {
+        cache->scratch[j].mem = mem + tables_end + j*cache_align(scratch_bytes);
+        cache->scratch[j].bytes = scratch_bytes;
+        int err = pthread_mutex_init(&cache->locks[j], NULL);
+        if (!err && (err = pthread_mutex_init(&cache->scratch[j].lock, NULL))) {
+            pthread_mutex_destroy(&cache->locks[j]);
+        }
+        if (err) {
+            while (j--) {
+                pthread_mutex_destroy(&cache->locks[j]);
+                pthread_mutex_destroy(&cache->scratch[j].lock);
+            }
+            ristretto_free(allocator, mem, bytes);
+            return RISTRETTO_FAILURE;
+        }
+    }
+
+    *out = cache;
+    return RISTRETTO_SUCCESS;
+}
+
+void ristretto255_point_cache_destroy (
+    ristretto255_point_cache_t *cache,
+    const ristretto255_allocator_t *allocator
+) {
+    if (cache == NULL) return;
+    unsigned int j;
+    for (j=0; j<cache->nshards; j++) {
+        pthread_mutex_destroy(&cache->locks[j]);
+        pthread_mutex_destroy(&cache->scratch[j].lock);
+    }
+    ristretto_free(allocator, cache->tables, cache->bytes);
+}
+
+/* Find an entry to replace: a free one, or by CLOCK among those nobody holds */
+static struct cache_entry *cache_victim(struct cache_set *set) {
+    unsigned int i;
+    for (i=0; i<2*CACHE_WAYS; i++) {
+        struct cache_entry *e = &set->way[set->hand];
+        set->hand = (set->hand + 1) % CACHE_WAYS;
+        if (e->pins) continue;
+        if (e->valid && e->referenced) {
+            e->referenced = 0;
+            continue;
+        }
+        return e;
+    }
+    return NULL;
+}
+
+ristretto_error_t ristretto255_point_cache_decode (
+    point_t *pt,
+    const wnaf_t **table,
+    ristretto255_point_cache_t *cache,
+    const unsigned char ser[RISTRETTO255_SER_BYTES],
+    ristretto_bool_t allow_identity
+) {
+    const size_t index = cache_set_index(cache, ser);
+    struct cache_set *set = &cache->sets[index];
+    pthread_mutex_t *lock = cache_lock(cache, index);
+    struct cache_entry *e = NULL;
+    unsigned int i;
+
+    *table = NULL;
+
+    pthread_mutex_lock(lock);
+    for (i=0; i<CACHE_WAYS; i++) {
+        if (set->way[i].valid && !memcmp(set->way[i].ser, ser, RISTRETTO255_SER_BYTES)) {
+            e = &set->way[i];
+            break;
+        }
+    }
+    if (e) {
+        /* Only the identity encodes to zeros, and only it can be refused */
+        static const unsigned char zeros[RISTRETTO255_SER_BYTES] = {0};
+        ristretto_error_t ret = RISTRETTO_SUCCESS;
+        if (!allow_identity && !memcmp(ser, zeros, sizeof(zeros))) {
+            ret = RISTRETTO_FAILURE;
+        } else {
+            e->referenced = 1;
+            e->pins++;
+            ristretto255_point_copy(pt, &e->pt);
+            *table = e->table;
+        }
+        pthread_mutex_unlock(lock);
+        return ret;
+    }
+    pthread_mutex_unlock(lock);
+
+    ristretto_error_t ret = ristretto255_point_decode(pt, ser, allow_identity);
+    if (ret != RISTRETTO_SUCCESS) return ret;
+
+    /* Claim an entry, and build its table without holding the lock */
+    pthread_mutex_lock(lock);
+    e = cache_victim(set);
+    if (e) {
+        e->valid = 0;
+        e->pins = 1;
+    }
+    pthread_mutex_unlock(lock);
+    if (e == NULL) return RISTRETTO_SUCCESS;
+
+    struct cache_scratch *scratch = &cache->scratch[index % cache->nshards];
+    const ristretto255_allocator_t in_scratch = { cache_scratch_alloc, cache_scratch_free, scratch };
+    pthread_mutex_lock(&scratch->lock);
+    ristretto_error_t built = ristretto255_wnaf_precompute(e->table, pt, cache->table_bits, &in_scratch);
+    pthread_mutex_unlock(&scratch->lock);
+
+    pthread_mutex_lock(lock);
+    if (built == RISTRETTO_SUCCESS) {
+        memcpy(e->ser, ser, RISTRETTO255_SER_BYTES);
+        ristretto255_point_copy(&e->pt, pt);
+        e->valid = 1;
+        e->referenced = 1;
+        *table = e->table;
+    } else {
+        e->pins = 0;
+    }
+    pthread_mutex_unlock(lock);
+    return RISTRETTO_SUCCESS;
+}
+
+void ristretto255_point_cache_release (
+    ristretto255_point_cache_t *cache,
+    const wnaf_t *table
+) {
+    if (table == NULL) return;
+    const size_t slot = ((const unsigned char *)table - cache->tables) / cache->table_bytes,
+        index = slot / CACHE_WAYS;
+    pthread_mutex_t *lock = cache_lock(cache, index);
+
+    pthread_mutex_lock(lock);
+    assert(cache->sets[index].way[slot % CACHE_WAYS].pins > 0);
+    cache->sets[index].way[slot % CACHE_WAYS].pins--;
+    pthread_mutex_unlock(lock);
+}
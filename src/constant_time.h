@@ -181,6 +181,78 @@ constant_time_lookup (
     }
 }
 
+/*
+ * Lookups specialized to one shape of table.  The general lookup above ORs
+ * each entry into the output in memory, a word or a big register at a
+ * time, which the compiler can't keep in registers across entries.  These
+ * know their element type, so they accumulate a whole entry in registers
+ * and store it once, using 512-bit registers where AVX-512 has them.
+ * Each entry is still read in full and selected with a mask computed
+ * without branches.
+ */
+#if __AVX512F__
+typedef uint32_t lookup_register_t __attribute__((vector_size(64)));
+
+static RISTRETTO_INLINE lookup_register_t
+lr_set_to_mask(mask_t x) {
+    uint32_t y = (uint32_t)x;
+    lookup_register_t ret = {y,y,y,y,y,y,y,y,y,y,y,y,y,y,y,y};
+    return ret;
+}
+
+static RISTRETTO_INLINE lookup_register_t
+lr_is_zero(lookup_register_t x) {
+    return (lookup_register_t)(x == lr_set_to_mask(0));
+}
+#else
+typedef big_register_t lookup_register_t;
+#define lr_set_to_mask br_set_to_mask
+#define lr_is_zero br_is_zero
+#endif
+
+typedef struct {
+    lookup_register_t unaligned;
+} __attribute__((packed)) unaligned_lr_t;
+
+/* The accumulator only stays in registers if its loops are unrolled */
+#if defined(__clang__)
+#define LOOKUP_UNROLL _Pragma("clang loop unroll(full)")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#define LOOKUP_UNROLL _Pragma("GCC unroll 16")
+#else
+#define LOOKUP_UNROLL
+#endif
+
+/**
+ * @brief Define name(out, table, n_table, idx), a constant-time equivalent of
+ * *out = table[idx] for tables of elem_t.  The size of elem_t must be a
+ * multiple of the largest vector register.  The table and output must not
+ * alias.
+ */
+#define CONSTANT_TIME_LOOKUP_SHAPE(name, elem_t) \
+typedef char name##_is_whole_registers[sizeof(elem_t) % sizeof(lookup_register_t) ? -1 : 1]; \
+static RISTRETTO_INLINE void \
+name (elem_t *__restrict__ out, const elem_t *table, word_t n_table, word_t idx) { \
+    const unaligned_lr_t *in = (const unaligned_lr_t *)table; \
+    lookup_register_t acc[sizeof(elem_t)/sizeof(lookup_register_t)]; \
+    lookup_register_t lr_one = lr_set_to_mask(1), lr_i = lr_set_to_mask(idx); \
+    word_t j, k; \
+    LOOKUP_UNROLL for (k=0; k<sizeof(acc)/sizeof(acc[0]); k++) { \
+        acc[k] = lr_is_zero(lr_i) & in[k].unaligned; \
+    } \
+    for (j=1; j<n_table; j++) { \
+        lr_i -= lr_one; \
+        lookup_register_t lr_mask = lr_is_zero(lr_i); \
+        in += sizeof(acc)/sizeof(acc[0]); \
+        LOOKUP_UNROLL for (k=0; k<sizeof(acc)/sizeof(acc[0]); k++) { \
+            acc[k] |= lr_mask & in[k].unaligned; \
+        } \
+    } \
+    LOOKUP_UNROLL for (k=0; k<sizeof(acc)/sizeof(acc[0]); k++) { \
+        ((unaligned_lr_t *)out)[k].unaligned = acc[k]; \
+    } \
+}
+
 /**
  * @brief Constant-time equivalent of memcpy(table + elem_bytes*idx, in, elem_bytes);
  *
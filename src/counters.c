@@ -0,0 +1,34 @@
+/**
+ * @file counters.c
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Per-thread operation counters, for builds with COUNTERS=1.
+ */
+
+#define _XOPEN_SOURCE 600 /* word.h calls posix_memalign, but <ristretto255.h> comes first */
+
+#include <ristretto255.h>
+#include "word.h"
+
+#ifdef RISTRETTO_COUNTERS
+__thread ristretto255_counters_t ristretto_counters;
+#endif
+
+ristretto_error_t ristretto255_counters_get (
+    ristretto255_counters_t *counters
+) {
+#ifdef RISTRETTO_COUNTERS
+    *counters = ristretto_counters;
+    return RISTRETTO_SUCCESS;
+#else
+    memset(counters, 0, sizeof(*counters));
+    return RISTRETTO_FAILURE;
+#endif
+}
+
+void ristretto255_counters_reset (void) {
+#ifdef RISTRETTO_COUNTERS
+    memset(&ristretto_counters, 0, sizeof(ristretto_counters));
+#endif
+}
@@ -0,0 +1,56 @@
+/**
+ * @cond internal
+ * @file dispatch.c
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Load-time selection between field backends.
+ *
+ * Only built with DISPATCH=1.  The Makefile then compiles the field and
+ * point code once per backend, renames each copy's public functions to
+ * ristretto255_foo_ref64, ristretto255_foo_x86_64 and so on, and lists them
+ * in dispatch_syms.h.  Here every ristretto255_foo becomes a GNU ifunc
+ * whose resolver picks the best copy this CPU can run, once, when the
+ * library is loaded.  Scalars, tables and the other shared code are
+ * built once for the baseline target and are not dispatched.
+ */
+
+#include <ristretto255.h>
+
+#if !defined(__x86_64__) || !defined(__ELF__)
+#error "DISPATCH=1 needs ifunc support and an x86_64 ELF target"
+#endif
+
+enum backend { BACKEND_REF64, BACKEND_X86_64, BACKEND_AVX2, BACKEND_IFMA };
+
+/* Must agree with ARCHFLAGS_* in the Makefile.  libgcc's checks include
+ * OS support for the AVX and AVX-512 register state.
+ */
+static enum backend dispatch_backend(void) {
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("bmi2")) return BACKEND_REF64;
+    if (!__builtin_cpu_supports("avx2")) return BACKEND_X86_64;
+    if (!__builtin_cpu_supports("avx512f")
+        || !__builtin_cpu_supports("avx512ifma")) return BACKEND_AVX2;
+    return BACKEND_IFMA;
+}
+
+/* The copies are declared hidden, which the linker applies to their
+ * definitions too, so the shared library only exports the ifuncs.
+ */
+#define RISTRETTO_DISPATCH(name) \
+    extern __attribute__((visibility("hidden"))) __typeof__(ristretto255_##name) \
+        ristretto255_##name##_ref64, ristretto255_##name##_x86_64, \
+        ristretto255_##name##_avx2, ristretto255_##name##_ifma; \
+    static __typeof__(ristretto255_##name) *resolve_##name(void) { \
+        switch (dispatch_backend()) { \
+        case BACKEND_IFMA:   return ristretto255_##name##_ifma; \
+        case BACKEND_AVX2:   return ristretto255_##name##_avx2; \
+        case BACKEND_X86_64: return ristretto255_##name##_x86_64; \
+        default:             return ristretto255_##name##_ref64; \
+        } \
+    } \
+    __typeof__(ristretto255_##name) ristretto255_##name \
+        __attribute__((ifunc("resolve_" #name)));
+
+#include "dispatch_syms.h"
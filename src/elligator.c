@@ -9,6 +9,8 @@
  * @brief Elligator high-level functions.
  */
 
+#define _XOPEN_SOURCE 600 /* for word.h's malloc_vector; word.h is too late to define it */
+
 #include <ristretto255.h>
 #include "word.h"
 #include "field.h"
@@ -30,44 +32,62 @@ extern mask_t ristretto255_deisogenize (
     mask_t toggle_rotation
 );
 
-void ristretto255_point_from_hash_nonuniform (
-    point_t *p,
+/* The map is split around its gf_isr, so that the batch version can run
+ * several of them side by side.  In between, the isr input is
+ * (dr+a-d)(dr-ar-d)(r+1)(a-2d).
+ */
+static RISTRETTO_INLINE void elligator_pre (
+    gf_25519_t *__restrict__ r0,
+    gf_25519_t *__restrict__ r,
+    gf_25519_t *__restrict__ N,
+    gf_25519_t *__restrict__ isr_in,
     const unsigned char ser[SER_BYTES]
 ) {
-    gf_25519_t r0,r,a,b,c,N,e;
+    gf_25519_t a,b,c;
     const uint8_t mask = (uint8_t)(0xFE<<(6));
-    ignore_result(gf_deserialize(&r0,ser,0,mask));
-    gf_strong_reduce(&r0);
-    gf_sqr(&a,&r0);
-    gf_mul_qnr(&r,&a);
+    ignore_result(gf_deserialize(r0,ser,0,mask));
+    gf_strong_reduce(r0);
+    gf_sqr(&a,r0);
+    gf_mul_qnr(r,&a);
 
     /* Compute D@c := (dr+a-d)(dr-ar-d) with a=1 */
-    gf_sub(&a,&r,&ONE);
+    gf_sub(&a,r,&ONE);
     gf_mulw(&b,&a,EDWARDS_D); /* dr-d */
     gf_add(&a,&b,&ONE);
-    gf_sub(&b,&b,&r);
+    gf_sub(&b,&b,r);
     gf_mul(&c,&a,&b);
 
     /* compute N := (r+1)(a-2d) */
-    gf_add(&a,&r,&ONE);
-    gf_mulw(&N,&a,1-2*EDWARDS_D);
+    gf_add(&a,r,&ONE);
+    gf_mulw(N,&a,1-2*EDWARDS_D);
+
+    gf_mul(isr_in,&c,N);
+}
+
+static RISTRETTO_INLINE void elligator_post (
+    point_t *p,
+    const gf_25519_t *r0,
+    const gf_25519_t *r,
+    const gf_25519_t *N,
+    const gf_25519_t *isr,
+    mask_t square
+) {
+    gf_25519_t a,b,c,e;
 
     /* e = +-sqrt(1/ND) or +-r0 * sqrt(qnr/ND) */
-    gf_mul(&a,&c,&N);
-    mask_t square = gf_isr(&b,&a);
-    gf_cond_sel(&c,&r0,&ONE,square); /* r? = square ? 1 : r0 */
-    gf_mul(&e,&b,&c);
+    gf_cond_sel(&c,r0,&ONE,square); /* r? = square ? 1 : r0 */
+    gf_mul(&e,isr,&c);
 
     /* s@a = +-|N.e| */
-    gf_mul(&a,&N,&e);
+    gf_mul(&a,N,&e);
     gf_cond_neg(&a,gf_lobit(&a) ^ ~square);
 
     /* t@b = -+ cN(r-1)((a-2d)e)^2 - 1 */
     gf_mulw(&c,&e,1-2*EDWARDS_D); /* (a-2d)e */
     gf_sqr(&b,&c);
-    gf_sub(&e,&r,&ONE);
+    gf_sub(&e,r,&ONE);
     gf_mul(&c,&b,&e);
-    gf_mul(&b,&c,&N);
+    gf_mul(&b,&c,N);
     gf_cond_neg(&b,square);
     gf_sub(&b,&b,&ONE);
 
@@ -87,6 +107,16 @@ void ristretto255_point_from_hash_nonuniform (
     assert(ristretto255_point_valid(p));
 }
 
+void ristretto255_point_from_hash_nonuniform (
+    point_t *p,
+    const unsigned char ser[SER_BYTES]
+) {
+    gf_25519_t r0,r,N,isr_in,isr;
+    elligator_pre(&r0,&r,&N,&isr_in,ser);
+    mask_t square = gf_isr(&isr,&isr_in);
+    elligator_post(p,&r0,&r,&N,&isr,square);
+}
+
 void ristretto255_point_from_hash_uniform (
     point_t *pt,
     const unsigned char hashed_data[2*SER_BYTES]
@@ -97,6 +127,55 @@ void ristretto255_point_from_hash_uniform (
     ristretto255_point_add(pt,pt,&pt2);
 }
 
+void ristretto255_point_from_hash_uniform_batch (
+    point_t *pts,
+    const unsigned char *hashed_data,
+    size_t n
+) {
+    /* As with ristretto255_point_encode_batch, every map needs its own
+     * gf_isr.  With a multi-lane field, run the two halves of
+     * GF_ISR_LANES/2 inputs through one gf_isr_lanes.
+     */
+    size_t i=0;
+#ifdef GF_ISR_LANES
+    gf_25519_t r0[GF_ISR_LANES], r[GF_ISR_LANES], N[GF_ISR_LANES], isr_in[GF_ISR_LANES], isr[GF_ISR_LANES];
+    mask_t square[GF_ISR_LANES];
+    point_t pt2;
+    for (; i+GF_ISR_LANES/2<=n; i+=GF_ISR_LANES/2) {
+        unsigned int k;
+        for (k=0; k<GF_ISR_LANES; k++) {
+            elligator_pre(&r0[k],&r[k],&N[k],&isr_in[k],&hashed_data[(2*i+k)*SER_BYTES]);
+        }
+        gf_isr_lanes(square,isr,isr_in);
+        for (k=0; k<GF_ISR_LANES/2; k++) {
+            elligator_post(&pts[i+k],&r0[2*k],&r[2*k],&N[2*k],&isr[2*k],square[2*k]);
+            elligator_post(&pt2,&r0[2*k+1],&r[2*k+1],&N[2*k+1],&isr[2*k+1],square[2*k+1]);
+            ristretto255_point_add(&pts[i+k],&pts[i+k],&pt2);
+        }
+    }
+#endif
+    for (; i<n; i++) {
+        ristretto255_point_from_hash_uniform(&pts[i],&hashed_data[2*i*SER_BYTES]);
+    }
+}
+
+void ristretto255_point_batch_from_hash_uniform (
+    ristretto255_point_batch_t *batch,
+    const unsigned char *hashed_data
+) {
+    /* Map a block at a time on the stack, then pack it */
+    point_t pts[RISTRETTO255_POINT_BATCH_LANES];
+    const size_t n = ristretto255_point_batch_count(batch);
+    size_t i, m;
+    for (i=0; i<n; i+=m) {
+        m = n-i < RISTRETTO255_POINT_BATCH_LANES ? n-i : RISTRETTO255_POINT_BATCH_LANES;
+        ristretto255_point_from_hash_uniform_batch(pts, &hashed_data[2*i*SER_BYTES], m);
+        ristretto_error_t ret = ristretto255_point_batch_pack(batch, i, pts, m);
+        assert(ret == RISTRETTO_SUCCESS); (void)ret;
+    }
+    ristretto_bzero(pts, sizeof(pts));
+}
+
 /* Elligator_onto:
  * Make elligator-inverse onto at the cost of roughly halving the success probability.
  * Currently no effect for curves with field size 1 bit mod 8 (where the top bit
@@ -8,6 +8,8 @@
  * @brief Field arithmetic.
  */
 
+#define _XOPEN_SOURCE 600 /* field.h reaches posix_memalign in word.h after <ristretto255.h> */
+
 #include <ristretto255.h>
 #include "field.h"
 #include "constant_time.h"
@@ -22,6 +24,7 @@ const gf_25519_t SQRT_MINUS_ONE = FIELD_LITERAL(
 
 /* Guarantee: a^2 x = 0 if x = 0; else a^2 x = 1 or SQRT_MINUS_ONE; */
 mask_t gf_isr (gf_25519_t *a, const gf_25519_t *x) {
+    RISTRETTO_COUNT(gf_isr,1);
     gf_25519_t L0, L1, L2, L3;
 
     gf_sqr (&L0, x);
@@ -47,7 +50,14 @@ mask_t gf_isr (gf_25519_t *a, const gf_25519_t *x) {
     gf_sqrn(&L2, &L3, 2);
     gf_mul (&L0, &L2, x);
 
-    gf_sqr (&L2, &L0);
+    return gf_isr_finish(a, &L0, x);
+}
+
+/* Given r = x^((p-5)/8), fix up the sign so that a^2 x = 1 or SQRT_MINUS_ONE */
+mask_t gf_isr_finish (gf_25519_t *__restrict__ a, const gf_25519_t *r, const gf_25519_t *x) {
+    gf_25519_t L1, L2, L3;
+
+    gf_sqr (&L2, r);
     gf_mul (&L3, &L2, x);
     gf_add(&L1,&L3,&ONE);
     mask_t one = gf_eq(&L3,&ONE);
@@ -55,7 +65,7 @@ mask_t gf_isr (gf_25519_t *a, const gf_25519_t *x) {
     mask_t qr   = one | gf_eq(&L3, &SQRT_MINUS_ONE);
 
     constant_time_select(&L2, &SQRT_MINUS_ONE, &ONE, sizeof(L2), qr, 0);
-    gf_mul (a,&L2,&L0);
+    gf_mul (a,&L2,r);
     return succ;
 }
 
@@ -42,6 +42,7 @@ void gf_mul (gf_25519_t *__restrict__ out, const gf_25519_t *a, const gf_25519_t
 void gf_mulw_unsigned (gf_25519_t *__restrict__ out, const gf_25519_t *a, uint32_t b);
 void gf_sqr (gf_25519_t *__restrict__ out, const gf_25519_t *a);
 mask_t gf_isr(gf_25519_t *a, const gf_25519_t *x); /** a^2 x = 1, QNR, or 0 if x=0.  Return true if successful */
+mask_t gf_isr_finish(gf_25519_t *__restrict__ a, const gf_25519_t *r, const gf_25519_t *x); /** gf_isr's tail, given r = x^((p-5)/8) */
 mask_t gf_eq (const gf_25519_t *x, const gf_25519_t *y);
 mask_t gf_lobit (const gf_25519_t *x);
 mask_t gf_hibit (const gf_25519_t *x);
@@ -63,6 +64,17 @@ extern const gf_25519_t SQRT_MINUS_ONE;
 #endif
 #define LIMB_MASK(i) (((1ull)<<LIMB_PLACE_VALUE(i))-1)
 
+/* Backends that can run several gf_isr's side by side, for the batch
+ * encoders and decoders: gf_isr_lanes(succ, a, x) does GF_ISR_LANES of them.
+ */
+#if GF_HAS_GF8
+  #define GF_ISR_LANES 8
+  #define gf_isr_lanes gf8_isr
+#elif GF_HAS_GF2
+  #define GF_ISR_LANES 2
+  #define gf_isr_lanes gf2_isr
+#endif
+
 static const gf_25519_t ZERO = {{0}}, ONE = {{ [LIMBPERM(0)] = 1 }};
 
 #endif /* __P25519_F_FIELD_H__ */
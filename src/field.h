@@ -14,6 +14,7 @@
 #include "f_field.h"
 #include <string.h>
 
+#if !GF_HAS_SQRN
 /** Square x, n times. */
 static RISTRETTO_INLINE void gf_sqrn (
     gf_25519_t *__restrict__ y,
@@ -35,6 +36,7 @@ static RISTRETTO_INLINE void gf_sqrn (
         gf_sqr(y,&tmp);
     }
 }
+#endif
 
 #define gf_add_nr gf_add_RAW
 
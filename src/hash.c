@@ -0,0 +1,203 @@
+/**
+ * @file hash.c
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief SHA-512, and hashing a message to the group as it streams in.
+ */
+
+#include <ristretto255.h>
+#include <ristretto255_hash.h>
+#include <string.h>
+
+#define SHA512_BLOCK 128
+
+/* SHA-512 digests are exactly the input of ristretto255_point_from_hash_uniform */
+typedef char sha512_digest_is_uniform_input[
+    (RISTRETTO255_SHA512_BYTES == 2*RISTRETTO255_HASH_BYTES) ? 1 : -1];
+
+static const uint64_t sha512_k[80] = {
+    0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+    0x3956c25bf348b538ull, 0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+    0xd807aa98a3030242ull, 0x12835b0145706fbeull, 0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+    0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+    0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+    0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+    0x983e5152ee66dfabull, 0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+    0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull, 0x06ca6351e003826full, 0x142929670a0e6e70ull,
+    0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+    0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+    0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+    0xd192e819d6ef5218ull, 0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+    0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull, 0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+    0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+    0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+    0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+    0xca273eceea26619cull, 0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+    0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull, 0x113f9804bef90daeull, 0x1b710b35131c471bull,
+    0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+    0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull
+};
+
+static const uint64_t sha512_iv[8] = {
+    0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+    0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull
+};
+
+static RISTRETTO_INLINE uint64_t ror64(uint64_t x, int n) {
+    return (x >> n) | (x << (64-n));
+}
+
+static RISTRETTO_INLINE uint64_t load_be64(const unsigned char *p) {
+    uint64_t x = 0;
+    int i;
+    for (i=0; i<8; i++) x = x<<8 | p[i];
+    return x;
+}
+
+static RISTRETTO_INLINE void store_be64(unsigned char *p, uint64_t x) {
+    int i;
+    for (i=7; i>=0; i--, x>>=8) p[i] = (unsigned char)x;
+}
+
+#define SHA512_S0(w) (ror64(w,1) ^ ror64(w,8) ^ ((w)>>7))
+#define SHA512_S1(w) (ror64(w,19) ^ ror64(w,61) ^ ((w)>>6))
+
+/* One round, with the working variables renamed instead of moved */
+#define SHA512_ROUND(a,b,c,d,e,f,g,h,i) do { \
+    uint64_t t1_ = h + (ror64(e,14) ^ ror64(e,18) ^ ror64(e,41)) \
+        + (g ^ (e & (f ^ g))) + sha512_k[i] + w[(i)&15]; \
+    d += t1_; \
+    h = t1_ + (ror64(a,28) ^ ror64(a,34) ^ ror64(a,39)) + ((a & b) | (c & (a | b))); \
+} while (0)
+
+/* Compress nblocks whole blocks, straight from the caller's buffer.  The
+ * schedule is kept as a rolling window of 16 words.
+ */
+static void sha512_blocks(uint64_t state[8], const unsigned char *p, size_t nblocks) {
+    uint64_t w[16];
+    for (; nblocks; nblocks--, p += SHA512_BLOCK) {
+        uint64_t a=state[0], b=state[1], c=state[2], d=state[3],
+                 e=state[4], f=state[5], g=state[6], h=state[7];
+        int i;
+        for (i=0; i<16; i++) w[i] = load_be64(&p[8*i]);
+        for (i=0; i<80; i+=8) {
+            if (i >= 16) {
+                int j;
+                for (j=i; j<i+8; j++) {
+                    w[j&15] += SHA512_S0(w[(j-15)&15]) + w[(j-7)&15] + SHA512_S1(w[(j-2)&15]);
+                }
+            }
+            SHA512_ROUND(a,b,c,d,e,f,g,h,i);
+            SHA512_ROUND(h,a,b,c,d,e,f,g,i+1);
+            SHA512_ROUND(g,h,a,b,c,d,e,f,i+2);
+            SHA512_ROUND(f,g,h,a,b,c,d,e,i+3);
+            SHA512_ROUND(e,f,g,h,a,b,c,d,i+4);
+            SHA512_ROUND(d,e,f,g,h,a,b,c,i+5);
+            SHA512_ROUND(c,d,e,f,g,h,a,b,i+6);
+            SHA512_ROUND(b,c,d,e,f,g,h,a,i+7);
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+    ristretto_bzero(w,sizeof(w));
+}
+
+void ristretto255_sha512_init (
+    ristretto255_sha512_ctx_t *ctx
+) {
+    memcpy(ctx->state, sha512_iv, sizeof(ctx->state));
+    ctx->bytes = 0;
+}
+
+void ristretto255_sha512_update (
+    ristretto255_sha512_ctx_t *ctx,
+    const unsigned char *data,
+    size_t len
+) {
+    size_t have = ctx->bytes % SHA512_BLOCK;
+    ctx->bytes += len;
+
+    if (have) {
+        size_t take = SHA512_BLOCK - have;
+        if (take > len) take = len;
+        memcpy(&ctx->block[have], data, take);
+        data += take;
+        len -= take;
+        if (have + take < SHA512_BLOCK) return;
+        sha512_blocks(ctx->state, ctx->block, 1);
+    }
+
+    sha512_blocks(ctx->state, data, len / SHA512_BLOCK);
+    data += len - len % SHA512_BLOCK;
+    memcpy(ctx->block, data, len % SHA512_BLOCK);
+}
+
+void ristretto255_sha512_final (
+    ristretto255_sha512_ctx_t *ctx,
+    unsigned char out[RISTRETTO255_SHA512_BYTES]
+) {
+    size_t have = ctx->bytes % SHA512_BLOCK;
+    int i;
+
+    /* A 1 bit, zeros, then the length in bits as a 128-bit number */
+    ctx->block[have++] = 0x80;
+    if (have > SHA512_BLOCK - 16) {
+        memset(&ctx->block[have], 0, SHA512_BLOCK - have);
+        sha512_blocks(ctx->state, ctx->block, 1);
+        have = 0;
+    }
+    memset(&ctx->block[have], 0, SHA512_BLOCK - 16 - have);
+    store_be64(&ctx->block[SHA512_BLOCK-16], ctx->bytes >> 61);
+    store_be64(&ctx->block[SHA512_BLOCK-8], ctx->bytes << 3);
+    sha512_blocks(ctx->state, ctx->block, 1);
+
+    for (i=0; i<8; i++) store_be64(&out[8*i], ctx->state[i]);
+    ristretto_bzero(ctx, sizeof(*ctx));
+}
+
+void ristretto255_hash_to_point_init (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    const ristretto255_hash_t *hash
+) {
+    ctx->hash = hash;
+    if (hash) {
+        hash->init(hash->ctx);
+    } else {
+        ristretto255_sha512_init(&ctx->sha512);
+    }
+}
+
+void ristretto255_hash_to_point_update (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    const unsigned char *data,
+    size_t len
+) {
+    if (ctx->hash) {
+        ctx->hash->update(ctx->hash->ctx, data, len);
+    } else {
+        ristretto255_sha512_update(&ctx->sha512, data, len);
+    }
+}
+
+void ristretto255_hash_to_point_final_digest (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    unsigned char out[2*RISTRETTO255_HASH_BYTES]
+) {
+    if (ctx->hash) {
+        ctx->hash->final(ctx->hash->ctx, out);
+    } else {
+        ristretto255_sha512_final(&ctx->sha512, out);
+    }
+    ristretto_bzero(ctx, sizeof(*ctx));
+}
+
+void ristretto255_hash_to_point_final (
+    ristretto255_hash_to_point_ctx_t *ctx,
+    ristretto255_point_t *pt
+) {
+    unsigned char digest[2*RISTRETTO255_HASH_BYTES];
+    ristretto255_hash_to_point_final_digest(ctx, digest);
+    ristretto255_point_from_hash_uniform(pt, digest);
+    ristretto_bzero(digest, sizeof(digest));
+}
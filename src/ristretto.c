@@ -22,20 +22,68 @@
 #define point_t ristretto255_point_t
 #define precomputed_s ristretto255_precomputed_s
 
-/* Comb config: number of combs, n, t, s. */
+/* Comb config: number of combs, n, t, s.  The Makefile's COMBS= profile
+ * may override these; ristretto_gen_tables then bakes a matching table.
+ */
+#ifndef COMBS_N
 #define COMBS_N 3
 #define COMBS_T 5
 #define COMBS_S 17
+#endif
+#if COMBS_N*COMBS_T*COMBS_S < RISTRETTO255_SCALAR_BITS
+#error "The comb must cover the scalar: COMBS_N*COMBS_T*COMBS_S >= 253"
+#endif
+/* Fixed window for the variable-base constant-time multiplies: 4, 5 or 6
+ * bits, from the Makefile's WINDOW=.  Each table holds 2^(w-1) points.
+ */
+#ifndef RISTRETTO_WINDOW_BITS
 #define RISTRETTO_WINDOW_BITS 4
+#endif
+#if RISTRETTO_WINDOW_BITS < 4 || RISTRETTO_WINDOW_BITS > 6
+#error "RISTRETTO_WINDOW_BITS must be 4, 5 or 6"
+#endif
 #define RISTRETTO_WNAF_FIXED_TABLE_BITS 5
 #define RISTRETTO_WNAF_VAR_TABLE_BITS 3
 
+/* Multiscalar config: variable-time Straus below the threshold, Pippenger above.
+ * Constant-time Straus has a table per term, so it keeps a 4-bit window
+ * whatever RISTRETTO_WINDOW_BITS is.
+ */
+#define RISTRETTO_MSM_WINDOW_BITS 4
+#define RISTRETTO_MSM_PIPPENGER_THRESHOLD 190
+#define RISTRETTO_MSM_PIPPENGER_MIN_BITS 4
+#define RISTRETTO_MSM_PIPPENGER_MAX_BITS 15
+/* Terms per task when a multiscalar multiply runs on an executor */
+#define RISTRETTO_MSM_PARALLEL_CHUNK 64
+/* Points per shared inversion in ristretto255_point_canonical_batch */
+#define RISTRETTO_CANONICAL_CHUNK 64
+/* Generators per pass of ristretto255_generators_mul, and table entries per
+ * shared inversion when building their tables */
+#define RISTRETTO_GENERATORS_CHUNK 64
+#define RISTRETTO_GENERATORS_NORMALIZE 256
+
 const int RISTRETTO255_EDWARDS_D = -121665;
-static const scalar_t point_scalarmul_adjustment = {{
+
+/* 2^FIXED_WINDOW_BITS(w) - 1 for each window width */
+static const scalar_t fixed_window_adjustment_4 = {{
     SC_LIMB(0xd6ec31748d98951c), SC_LIMB(0xc6ef5bf4737dcf70), SC_LIMB(0xfffffffffffffffe), SC_LIMB(0x0fffffffffffffff)
-}}, precomputed_scalarmul_adjustment = {{
+}};
+#if RISTRETTO_WINDOW_BITS == 4
+#define point_scalarmul_adjustment fixed_window_adjustment_4
+#elif RISTRETTO_WINDOW_BITS == 5
+static const scalar_t point_scalarmul_adjustment = {{
     SC_LIMB(0x977f4a4775473484), SC_LIMB(0x6de72ae98b3ab623), SC_LIMB(0xffffffffffffffff), SC_LIMB(0x0fffffffffffffff)
 }};
+#else
+static const scalar_t point_scalarmul_adjustment = {{
+    SC_LIMB(0x53799c831f80d8ac), SC_LIMB(0xdd208235e5106740), SC_LIMB(0xfffffffffffffffa), SC_LIMB(0x0fffffffffffffff)
+}};
+#endif
+
+/* 2^(COMBS_N*COMBS_T*COMBS_S) - 1, computed by ristretto_gen_tables */
+extern const scalar_t ristretto255_precomputed_scalarmul_adjustment;
+const unsigned int ristretto255_comb_bits = COMBS_N*COMBS_T*COMBS_S;
+const unsigned int ristretto255_comb_geometry[3] = { COMBS_N, COMBS_T, COMBS_S };
 
 const gf_25519_t RISTRETTO255_FACTOR = FIELD_LITERAL(
     0x702557fa2bf03, 0x514b7d1a82cc6, 0x7f89efd8b43a7, 0x1aef49ec23700, 0x079376fa30500
@@ -53,6 +101,11 @@ extern const point_t ristretto255_point_base;
 typedef struct { gf_25519_t a, b, c; } niels_t;
 typedef struct { niels_t n; gf_25519_t z; } VECTOR_ALIGNED pniels_t;
 
+/* Constant-time lookups into tables of each kind */
+CONSTANT_TIME_LOOKUP_SHAPE(constant_time_lookup_niels, niels_t)
+CONSTANT_TIME_LOOKUP_SHAPE(constant_time_lookup_pniels, pniels_t)
+CONSTANT_TIME_LOOKUP_SHAPE(constant_time_lookup_point, point_t)
+
 /* Precomputed base */
 struct precomputed_s { niels_t table [COMBS_N<<(COMBS_T-1)]; };
 
@@ -90,28 +143,41 @@ void ristretto255_deisogenize (
     mask_t toggle_rotation
 );
 
-void ristretto255_deisogenize (
+/* deisogenize is split around its gf_isr so that the batch encoder can do
+ * several of them at once.  t1 is the isr input, t2 = den and t3 = num.
+ */
+static RISTRETTO_INLINE void deisogenize_pre (
+    gf_25519_t *__restrict__ t1,
+    gf_25519_t *__restrict__ t2,
+    gf_25519_t *__restrict__ t3,
+    const point_t *p
+) {
+    gf_25519_t t4;
+    gf_add(t1,&p->z,&p->y);
+    gf_sub(t2,&p->z,&p->y);
+    gf_mul(t3,t1,t2);       /* t3 = num */
+    gf_mul(t2,&p->x,&p->y); /* t2 = den */
+    gf_sqr(t1,t2);
+    gf_mul(&t4,t1,t3);
+    gf_mulw(t1,&t4,-1-TWISTED_D); /* num*(a-d)*den^2 */
+}
+
+static RISTRETTO_INLINE void deisogenize_post (
     gf_25519_t *__restrict__ s,
     gf_25519_t *__restrict__ inv_el_sum,
     gf_25519_t *__restrict__ inv_el_m1,
     const point_t *p,
     mask_t toggle_s,
     mask_t toggle_altx,
-    mask_t toggle_rotation
+    mask_t toggle_rotation,
+    const gf_25519_t *den,
+    const gf_25519_t *num,
+    const gf_25519_t *isr
 ) {
-    /* More complicated because of rotation */
     gf_25519_t t1,t2,t3,t4,t5;
-    gf_add(&t1,&p->z,&p->y);
-    gf_sub(&t2,&p->z,&p->y);
-    gf_mul(&t3,&t1,&t2);     /* t3 = num */
-    gf_mul(&t2,&p->x,&p->y); /* t2 = den */
-    gf_sqr(&t1,&t2);
-    gf_mul(&t4,&t1,&t3);
-    gf_mulw(&t1,&t4,-1-TWISTED_D);
-    gf_isr(&t4,&t1);         /* isqrt(num*(a-d)*den^2) */
-    gf_mul(&t1,&t2,&t4);
+    gf_mul(&t1,den,isr);
     gf_mul(&t2,&t1,&RISTRETTO255_FACTOR); /* t2 = "iden" in ristretto.sage */
-    gf_mul(&t1,&t3,&t4);                  /* t1 = "inum" in ristretto.sage */
+    gf_mul(&t1,num,isr);                  /* t1 = "inum" in ristretto.sage */
 
     /* Calculate altxy = iden*inum*i*t^2*(d-a) */
     gf_mul(&t3,&t1,&t2);
@@ -147,47 +213,114 @@ void ristretto255_deisogenize (
     gf_sub(inv_el_m1,inv_el_m1,&t4);
 }
 
+void ristretto255_deisogenize (
+    gf_25519_t *__restrict__ s,
+    gf_25519_t *__restrict__ inv_el_sum,
+    gf_25519_t *__restrict__ inv_el_m1,
+    const point_t *p,
+    mask_t toggle_s,
+    mask_t toggle_altx,
+    mask_t toggle_rotation
+) {
+    /* More complicated because of rotation */
+    gf_25519_t t1,t2,t3,t4;
+    deisogenize_pre(&t1,&t2,&t3,p);
+    gf_isr(&t4,&t1);         /* isqrt(num*(a-d)*den^2) */
+    deisogenize_post(s,inv_el_sum,inv_el_m1,p,toggle_s,toggle_altx,toggle_rotation,&t2,&t3,&t4);
+}
+
 void ristretto255_point_encode( unsigned char ser[SER_BYTES], const point_t *p ) {
     gf_25519_t s,ie1,ie2;
     ristretto255_deisogenize(&s,&ie1,&ie2,p,0,0,0);
     gf_serialize(ser,&s,1);
 }
 
-ristretto_error_t ristretto255_point_decode (
+void ristretto255_point_encode_batch (
+    unsigned char (*out)[SER_BYTES],
+    const point_t *pts,
+    size_t n
+) {
+    /* Unlike inversion, the inverse square roots of unrelated elements can't
+     * be folded into a single exponentiation, so each point pays for its own
+     * gf_isr.  Backends with a multi-lane field (8-way on IFMA, 2-way on
+     * NEON) can at least run several side by side; otherwise this just saves
+     * the caller the loop.
+     */
+    gf_25519_t s,ie1,ie2;
+    size_t i=0;
+#ifdef GF_ISR_LANES
+    gf_25519_t isr_in[GF_ISR_LANES], den[GF_ISR_LANES], num[GF_ISR_LANES], isr[GF_ISR_LANES];
+    mask_t ok[GF_ISR_LANES];
+    for (; i+GF_ISR_LANES<=n; i+=GF_ISR_LANES) {
+        unsigned int k;
+        for (k=0; k<GF_ISR_LANES; k++) {
+            deisogenize_pre(&isr_in[k],&den[k],&num[k],&pts[i+k]);
+        }
+        gf_isr_lanes(ok,isr,isr_in);
+        for (k=0; k<GF_ISR_LANES; k++) {
+            deisogenize_post(&s,&ie1,&ie2,&pts[i+k],0,0,0,&den[k],&num[k],&isr[k]);
+            gf_serialize(out[i+k],&s,1);
+        }
+    }
+#endif
+    for (; i<n; i++) {
+        ristretto255_deisogenize(&s,&ie1,&ie2,&pts[i],0,0,0);
+        gf_serialize(out[i],&s,1);
+    }
+}
+
+/* Likewise, decoding is split around its gf_isr.  In between, p->t = den,
+ * p->z = ynum and the isr goes in p->x.
+ */
+static RISTRETTO_INLINE mask_t point_decode_pre (
     point_t *p,
+    gf_25519_t *__restrict__ s,
+    gf_25519_t *__restrict__ num,
+    gf_25519_t *__restrict__ isr_in,
     const unsigned char ser[SER_BYTES],
     ristretto_bool_t allow_identity
 ) {
-    gf_25519_t s, s2, num, tmp;
-    gf_25519_t *tmp2=&s2, *ynum=&p->z, *isr=&p->x, *den=&p->t;
+    gf_25519_t s2, tmp;
+    gf_25519_t *ynum=&p->z, *den=&p->t;
 
-    mask_t succ = gf_deserialize(&s, ser, 1, 0);
-    succ &= bool_to_mask(allow_identity) | ~gf_eq(&s, &ZERO);
-    succ &= ~gf_lobit(&s);
+    mask_t succ = gf_deserialize(s, ser, 1, 0);
+    succ &= bool_to_mask(allow_identity) | ~gf_eq(s, &ZERO);
+    succ &= ~gf_lobit(s);
 
-    gf_sqr(&s2,&s);                  /* s^2 = -as^2 */
+    gf_sqr(&s2,s);                   /* s^2 = -as^2 */
     gf_sub(&s2,&ZERO,&s2);           /* -as^2 */
     gf_sub(den,&ONE,&s2);            /* 1+as^2 */
     gf_add(ynum,&ONE,&s2);           /* 1-as^2 */
-    gf_mulw(&num,&s2,-4*TWISTED_D);
+    gf_mulw(num,&s2,-4*TWISTED_D);
     gf_sqr(&tmp,den);                /* tmp = den^2 */
-    gf_add(&num,&tmp,&num);          /* num = den^2 - 4*d*s^2 */
-    gf_mul(tmp2,&num,&tmp);          /* tmp2 = num*den^2 */
-    succ &= gf_isr(isr,tmp2);        /* isr = 1/sqrt(num*den^2) */
+    gf_add(num,&tmp,num);            /* num = den^2 - 4*d*s^2 */
+    gf_mul(isr_in,num,&tmp);         /* num*den^2 */
+    return succ;
+}
+
+static RISTRETTO_INLINE mask_t point_decode_post (
+    point_t *p,
+    const gf_25519_t *s,
+    const gf_25519_t *num
+) {
+    gf_25519_t tmp, tmp2;
+    gf_25519_t *ynum=&p->z, *isr=&p->x, *den=&p->t;
+    mask_t succ;
+
     gf_mul(&tmp,isr,den);            /* isr*den */
     gf_mul(&p->y,&tmp,ynum);         /* isr*den*(1-as^2) */
-    gf_mul(tmp2,&tmp,&s);            /* s*isr*den */
-    gf_add(tmp2,tmp2,tmp2);          /* 2*s*isr*den */
-    gf_mul(&tmp,tmp2,isr);           /* 2*s*isr^2*den */
-    gf_mul(&p->x,&tmp,&num);         /* 2*s*isr^2*den*num */
-    gf_mul(&tmp,tmp2,&RISTRETTO255_FACTOR); /* 2*s*isr*den*magic */
+    gf_mul(&tmp2,&tmp,s);            /* s*isr*den */
+    gf_add(&tmp2,&tmp2,&tmp2);       /* 2*s*isr*den */
+    gf_mul(&tmp,&tmp2,isr);          /* 2*s*isr^2*den */
+    gf_mul(&p->x,&tmp,num);          /* 2*s*isr^2*den*num */
+    gf_mul(&tmp,&tmp2,&RISTRETTO255_FACTOR); /* 2*s*isr*den*magic */
     gf_cond_neg(&p->x,gf_lobit(&tmp)); /* flip x */
 
     /* Additionally check y != 0 and x*y*isomagic nonegative */
-    succ &= ~gf_eq(&p->y,&ZERO);
+    succ = ~gf_eq(&p->y,&ZERO);
     gf_mul(&tmp,&p->x,&p->y);
-    gf_mul(tmp2,&tmp,&RISTRETTO255_FACTOR);
-    succ &= ~gf_lobit(tmp2);
+    gf_mul(&tmp2,&tmp,&RISTRETTO255_FACTOR);
+    succ &= ~gf_lobit(&tmp2);
 
     gf_copy(&tmp,&p->x);
     gf_mul_i(&p->x,&tmp);
@@ -195,16 +328,205 @@ ristretto_error_t ristretto255_point_decode (
     /* Fill in z and t */
     gf_copy(&p->z,&ONE);
     gf_mul(&p->t,&p->x,&p->y);
+    return succ;
+}
+
+static RISTRETTO_INLINE mask_t point_decode (
+    point_t *p,
+    const unsigned char ser[SER_BYTES],
+    ristretto_bool_t allow_identity
+) {
+    gf_25519_t s, num, isr_in;
+    mask_t succ = point_decode_pre(p, &s, &num, &isr_in, ser, allow_identity);
+    succ &= gf_isr(&p->x, &isr_in);  /* isr = 1/sqrt(num*den^2) */
+    succ &= point_decode_post(p, &s, &num);
 
     assert(ristretto255_point_valid(p) | ~succ);
-    return ristretto_succeed_if(mask_to_bool(succ));
+    return succ;
+}
+
+ristretto_error_t ristretto255_point_decode (
+    point_t *p,
+    const unsigned char ser[SER_BYTES],
+    ristretto_bool_t allow_identity
+) {
+    return ristretto_succeed_if(mask_to_bool(point_decode(p,ser,allow_identity)));
+}
+
+ristretto_error_t ristretto255_point_decode_batch (
+    point_t *pts,
+    ristretto_error_t *results,
+    const unsigned char *ser,
+    size_t n,
+    ristretto_bool_t allow_identity
+) {
+    /* As with encoding, every element needs its own gf_isr, so there's
+     * no shared exponentiation to be had.  Use the multi-lane field if there
+     * is one, else decode two at a time so that the compiler can interleave
+     * the independent field pipelines.
+     */
+    mask_t all = -(mask_t)1, succ;
+    size_t i=0;
+#ifdef GF_ISR_LANES
+    gf_25519_t s[GF_ISR_LANES], num[GF_ISR_LANES], isr_in[GF_ISR_LANES], isr[GF_ISR_LANES];
+    mask_t ok[GF_ISR_LANES];
+    for (; i+GF_ISR_LANES<=n; i+=GF_ISR_LANES) {
+        unsigned int k;
+        for (k=0; k<GF_ISR_LANES; k++) {
+            ok[k] = point_decode_pre(&pts[i+k],&s[k],&num[k],&isr_in[k],
+                &ser[(i+k)*SER_BYTES],allow_identity);
+        }
+        {
+            mask_t isr_ok[GF_ISR_LANES];
+            gf_isr_lanes(isr_ok,isr,isr_in);
+            for (k=0; k<GF_ISR_LANES; k++) ok[k] &= isr_ok[k];
+        }
+        for (k=0; k<GF_ISR_LANES; k++) {
+            gf_copy(&pts[i+k].x,&isr[k]);
+            succ = ok[k] & point_decode_post(&pts[i+k],&s[k],&num[k]);
+            assert(ristretto255_point_valid(&pts[i+k]) | ~succ);
+            results[i+k] = ristretto_succeed_if(mask_to_bool(succ));
+            all &= succ;
+        }
+    }
+#endif
+    for (; i+1<n; i+=2) {
+        mask_t succ2;
+        succ  = point_decode(&pts[i],  &ser[i*SER_BYTES],    allow_identity);
+        succ2 = point_decode(&pts[i+1],&ser[(i+1)*SER_BYTES],allow_identity);
+        results[i]   = ristretto_succeed_if(mask_to_bool(succ));
+        results[i+1] = ristretto_succeed_if(mask_to_bool(succ2));
+        all &= succ & succ2;
+    }
+    if (i<n) {
+        succ = point_decode(&pts[i],&ser[i*SER_BYTES],allow_identity);
+        results[i] = ristretto_succeed_if(mask_to_bool(succ));
+        all &= succ;
+    }
+    return ristretto_succeed_if(mask_to_bool(all));
+}
+
+#if GF_HAS_GF4
+/* Parallel Edwards formulas in the style of Hisil-Wong-Carter-Dawson and
+ * curve25519-dalek's AVX2 backend.  The four coordinates of one point live
+ * in the four lanes of a gf4, so each round of multiplies is one gf4_mul.
+ */
+
+/* Lanes hold (X, Y, Z, T) */
+typedef struct { gf4_25519_t xyzt; } point4_t;
+
+/* Lanes hold (Y-X, Y+X, 2dT, 2Z), the same values as a pniels_t */
+typedef struct { gf4_25519_t c; } pniels4_t;
+
+CONSTANT_TIME_LOOKUP_SHAPE(constant_time_lookup_pniels4, pniels4_t)
+CONSTANT_TIME_LOOKUP_SHAPE(constant_time_lookup_point4, point4_t)
+
+static RISTRETTO_INLINE void pt_to_point4 (point4_t *out, const point_t *p) {
+    gf4_pack(&out->xyzt, &p->x, &p->y, &p->z, &p->t);
+}
+
+static RISTRETTO_INLINE void point4_to_pt (point_t *out, const point4_t *p) {
+    gf4_unpack(&out->x, &out->y, &out->z, &out->t, &p->xyzt);
+}
+
+static RISTRETTO_INLINE void pniels_to_pniels4 (pniels4_t *out, const pniels_t *pn) {
+    gf4_pack(&out->c, &pn->n.a, &pn->n.b, &pn->n.c, &pn->z);
 }
 
+static RISTRETTO_INLINE void pt_to_pniels4 (pniels4_t *out, const point_t *p) {
+    gf_25519_t a, b, c, z;
+    gf_sub ( &a, &p->y, &p->x );
+    gf_add ( &b, &p->x, &p->y );
+    gf_mulw ( &c, &p->t, 2*TWISTED_D );
+    gf_add ( &z, &p->z, &p->z );
+    gf4_pack(&out->c, &a, &b, &c, &z);
+}
+
+static RISTRETTO_INLINE void cond_neg_pniels4 (pniels4_t *pn, mask_t neg) {
+    /* -(Y-X, Y+X, 2dT, 2Z) = (Y+X, Y-X, -2dT, 2Z) */
+    gf4_25519_t swapped, negated;
+    GF4_SHUFFLE(&swapped, &pn->c, 1,0,2,3);
+    gf4_neg(&negated, &swapped);
+    GF4_BLEND(&swapped, &swapped, &negated, 0,0,1,0);
+    gf4_cond_sel(&pn->c, &pn->c, &swapped, neg);
+}
+
+static RISTRETTO_NOINLINE void point4_double (point4_t *p, const point4_t *q) {
+    RISTRETTO_COUNT(point_double,1);
+    gf4_25519_t a, b, s;
+
+    /* a = (X, Y, Z, X+Y) */
+    GF4_SHUFFLE(&a, &q->xyzt, 0,1,2,0);
+    GF4_SHUFFLE(&b, &q->xyzt, 1,1,1,1);
+    gf4_add(&b, &a, &b);
+    GF4_BLEND(&a, &a, &b, 0,0,0,1);
+    gf4_sqr(&s, &a); /* (S1, S2, S3, S4) = (X^2, Y^2, Z^2, (X+Y)^2) */
+
+    /* a = (S1+S2, S1-S2, S1-S2+2*S3, S1+S2-S4) */
+    GF4_SHUFFLE(&a, &s, 0,0,0,0);
+    GF4_SHUFFLE(&b, &s, 1,1,1,1);
+    gf4_add(&p->xyzt, &a, &b);
+    gf4_sub(&a, &a, &b);
+    GF4_BLEND(&a, &p->xyzt, &a, 0,1,1,0);
+    gf4_add(&b, &s, &s);
+    gf4_neg(&s, &s);
+    GF4_BLEND(&b, &b, &s, 0,0,0,1);
+    gf4_add(&b, &a, &b);
+    GF4_BLEND(&a, &a, &b, 0,0,1,1);
+    gf4_reduce(&a);
+
+    /* The negation of Hisil et al's (EF, GH, FG, EH), which is the same point */
+    GF4_SHUFFLE(&b, &a, 2,0,2,0);
+    GF4_SHUFFLE(&s, &a, 3,1,1,3);
+    gf4_mul(&p->xyzt, &b, &s);
+}
+
+static RISTRETTO_NOINLINE void point4_add_pniels4 (
+    point4_t *p,
+    const point4_t *q,
+    const pniels4_t *pn
+) {
+    RISTRETTO_COUNT(point_add,1);
+    gf4_25519_t a, b, c;
+
+    /* a = (Y-X, Y+X, T, Z) */
+    GF4_SHUFFLE(&b, &q->xyzt, 1,1,3,2);
+    GF4_SHUFFLE(&c, &q->xyzt, 0,0,0,0);
+    gf4_sub(&a, &b, &c);
+    gf4_add(&c, &b, &c);
+    GF4_BLEND(&a, &a, &c, 0,1,0,0);
+    GF4_BLEND(&a, &a, &b, 0,0,1,1);
+    gf4_mul(&b, &a, &pn->c); /* (A, B, C, D) */
+
+    /* a = (B-A, B+A, D-C, D+C) = (E, H, F, G) */
+    GF4_SHUFFLE(&a, &b, 1,1,3,3);
+    GF4_SHUFFLE(&c, &b, 0,0,2,2);
+    gf4_sub(&b, &a, &c);
+    gf4_add(&a, &a, &c);
+    GF4_BLEND(&a, &b, &a, 0,1,0,1);
+
+    /* (X3, Y3, Z3, T3) = (EF, GH, FG, EH) */
+    GF4_SHUFFLE(&b, &a, 0,3,2,0);
+    GF4_SHUFFLE(&c, &a, 2,1,3,1);
+    gf4_mul(&p->xyzt, &b, &c);
+}
+#endif /* GF_HAS_GF4 */
+
 void ristretto255_point_sub (
     point_t *p,
     const point_t *q,
     const point_t *r
 ) {
+#if GF_HAS_GF4
+    point4_t q4;
+    pniels4_t r4;
+    pt_to_point4(&q4, q);
+    pt_to_pniels4(&r4, r);
+    cond_neg_pniels4(&r4, -1);
+    point4_add_pniels4(&q4, &q4, &r4);
+    point4_to_pt(p, &q4);
+#else
+    RISTRETTO_COUNT(point_add,1);
     gf_25519_t a, b, c, d;
     gf_sub_nr ( &b, &q->y, &q->x ); /* 3+e */
     gf_sub_nr ( &d, &r->y, &r->x ); /* 3+e */
@@ -225,6 +547,7 @@ void ristretto255_point_sub (
     gf_mul ( &p->x, &p->y, &c );
     gf_mul ( &p->y, &a, &b );
     gf_mul ( &p->t, &b, &c );
+#endif
 }
 
 void ristretto255_point_add (
@@ -232,6 +555,15 @@ void ristretto255_point_add (
     const point_t *q,
     const point_t *r
 ) {
+#if GF_HAS_GF4
+    point4_t q4;
+    pniels4_t r4;
+    pt_to_point4(&q4, q);
+    pt_to_pniels4(&r4, r);
+    point4_add_pniels4(&q4, &q4, &r4);
+    point4_to_pt(p, &q4);
+#else
+    RISTRETTO_COUNT(point_add,1);
     gf_25519_t a, b, c, d;
     gf_sub_nr ( &b, &q->y, &q->x ); /* 3+e */
     gf_sub_nr ( &c, &r->y, &r->x ); /* 3+e */
@@ -252,6 +584,7 @@ void ristretto255_point_add (
     gf_mul ( &p->x, &p->y, &c );
     gf_mul ( &p->y, &a, &b );
     gf_mul ( &p->t, &b, &c );
+#endif
 }
 
 static RISTRETTO_NOINLINE void
@@ -260,6 +593,7 @@ point_double_internal (
     const point_t *q,
     int before_double
 ) {
+    RISTRETTO_COUNT(point_double,1);
     gf_25519_t a, b, c, d;
     gf_sqr ( &c, &q->x );
     gf_sqr ( &a, &q->y );
@@ -279,7 +613,14 @@ point_double_internal (
 }
 
 void ristretto255_point_double(point_t *p, const point_t *q) {
+#if GF_HAS_GF4
+    point4_t q4;
+    pt_to_point4(&q4, q);
+    point4_double(&q4, &q4);
+    point4_to_pt(p, &q4);
+#else
     point_double_internal(p,q,0);
+#endif
 }
 
 void ristretto255_point_negate (
@@ -342,6 +683,7 @@ add_niels_to_pt (
     const niels_t *e,
     int before_double
 ) {
+    RISTRETTO_COUNT(point_add,1);
     gf_25519_t a, b, c;
     gf_sub_nr ( &b, &d->y, &d->x ); /* 3+e */
     gf_mul ( &a, &e->a, &b );
@@ -364,6 +706,7 @@ sub_niels_from_pt (
     const niels_t *e,
     int before_double
 ) {
+    RISTRETTO_COUNT(point_add,1);
     gf_25519_t a, b, c;
     gf_sub_nr ( &b, &d->y, &d->x ); /* 3+e */
     gf_mul ( &a, &e->b, &b );
@@ -427,19 +770,50 @@ prepare_fixed_window(
     ristretto_bzero(&tmp,sizeof(tmp));
 }
 
+/* Bits of a scalar covered by windows of width w */
+#define FIXED_WINDOW_BITS(w) ((w) * ((SCALAR_BITS-1)/(w) + 1))
+
+/* Signed fixed-window recoding.  A scalar k becomes
+ * (k + 2^FIXED_WINDOW_BITS(w) - 1)/2, whose w-bit window at bit i, of
+ * value v, stands for the odd digit 2v - (2^w - 1).  No digit is zero, so
+ * a table of the 2^(w-1) odd multiples 1..2^w-1 covers every one, and the
+ * index and sign fall out of v without branches.
+ */
+static RISTRETTO_INLINE void fixed_window_recode (
+    scalar_t *scalar1x,
+    const scalar_t *scalar,
+    const scalar_t *adjustment
+) {
+    ristretto255_scalar_add(scalar1x, scalar, adjustment);
+    ristretto255_scalar_halve(scalar1x, scalar1x);
+}
+
+/* The table index of the digit at bit i, with *neg set if it is negative */
+static RISTRETTO_INLINE word_t fixed_window_digit (
+    mask_t *neg,
+    const scalar_t *scalar1x,
+    int i,
+    int w
+) {
+    word_t bits = scalar1x->limb[i/WBITS] >> (i%WBITS);
+    if (i%WBITS >= WBITS-w && i/WBITS<SCALAR_LIMBS-1) {
+        bits ^= scalar1x->limb[i/WBITS+1] << (WBITS - (i%WBITS));
+    }
+    bits &= ((word_t)1<<w) - 1;
+    *neg = (bits>>(w-1)) - 1;
+    return (bits ^ *neg) & (((word_t)1<<(w-1)) - 1);
+}
+
 void ristretto255_point_scalarmul (
     point_t *a,
     const point_t *b,
     const scalar_t *scalar
 ) {
     const int WINDOW = RISTRETTO_WINDOW_BITS,
-        WINDOW_MASK = (1<<WINDOW)-1,
-        WINDOW_T_MASK = WINDOW_MASK >> 1,
         NTABLE = 1<<(WINDOW-1);
 
     scalar_t scalar1x;
-    ristretto255_scalar_add(&scalar1x, scalar, &point_scalarmul_adjustment);
-    ristretto255_scalar_halve(&scalar1x,&scalar1x);
+    fixed_window_recode(&scalar1x, scalar, &point_scalarmul_adjustment);
 
     /* Set up a precomputed table with odd multiples of b. */
     pniels_t pn, multiples[1<<((int)(RISTRETTO_WINDOW_BITS)-1)];  // == NTABLE (MSVC compatibility issue)
@@ -448,20 +822,36 @@ void ristretto255_point_scalarmul (
 
     /* Initialize. */
     int i,j,first=1;
+
+#if GF_HAS_GF4
+    pniels4_t pn4, multiples4[1<<((int)(RISTRETTO_WINDOW_BITS)-1)];
+    point4_t tmp4;
+    for (i=0; i<NTABLE; i++) pniels_to_pniels4(&multiples4[i], &multiples[i]);
+    pt_to_point4(&tmp4, &ristretto255_point_identity);
+#endif
+
     i = SCALAR_BITS - ((SCALAR_BITS-1) % WINDOW) - 1;
 
     for (; i>=0; i-=WINDOW) {
-        /* Fetch another block of bits */
-        word_t bits = scalar1x.limb[i/WBITS] >> (i%WBITS);
-        if (i%WBITS >= WBITS-WINDOW && i/WBITS<SCALAR_LIMBS-1) {
-            bits ^= scalar1x.limb[i/WBITS+1] << (WBITS - (i%WBITS));
+        mask_t inv;
+        word_t idx = fixed_window_digit(&inv, &scalar1x, i, WINDOW);
+
+#if GF_HAS_GF4
+        /* The parallel formulas always produce t, and the first add goes
+         * into the identity.
+         */
+        constant_time_lookup_pniels4(&pn4, multiples4, NTABLE, idx);
+        cond_neg_pniels4(&pn4, inv);
+        if (first) {
+            first = 0;
+        } else {
+            for (j=0; j<WINDOW; j++)
+                point4_double(&tmp4, &tmp4);
         }
-        bits &= WINDOW_MASK;
-        mask_t inv = (bits>>(WINDOW-1))-1;
-        bits ^= inv;
-
+        point4_add_pniels4(&tmp4, &tmp4, &pn4);
+#else
         /* Add in from table.  Compute t only on last iteration. */
-        constant_time_lookup(&pn, multiples, sizeof(pn), NTABLE, bits & WINDOW_T_MASK);
+        constant_time_lookup_pniels(&pn, multiples, NTABLE, idx);
         cond_neg_niels(&pn.n, inv);
         if (first) {
             pniels_to_pt(&tmp, &pn);
@@ -476,8 +866,16 @@ void ristretto255_point_scalarmul (
             point_double_internal(&tmp, &tmp, 0);
             add_pniels_to_pt(&tmp, &pn, i ? -1 : 0);
         }
+#endif
     }
 
+#if GF_HAS_GF4
+    point4_to_pt(&tmp, &tmp4);
+    ristretto_bzero(&pn4,sizeof(pn4));
+    ristretto_bzero(&multiples4,sizeof(multiples4));
+    ristretto_bzero(&tmp4,sizeof(tmp4));
+#endif
+
     /* Write out the answer */
     ristretto255_point_copy(a,&tmp);
 
@@ -496,15 +894,11 @@ void ristretto255_point_double_scalarmul (
 ) {
 
     const int WINDOW = RISTRETTO_WINDOW_BITS,
-        WINDOW_MASK = (1<<WINDOW)-1,
-        WINDOW_T_MASK = WINDOW_MASK >> 1,
         NTABLE = 1<<(WINDOW-1);
 
     scalar_t scalar1x, scalar2x;
-    ristretto255_scalar_add(&scalar1x, scalarb, &point_scalarmul_adjustment);
-    ristretto255_scalar_halve(&scalar1x,&scalar1x);
-    ristretto255_scalar_add(&scalar2x, scalarc, &point_scalarmul_adjustment);
-    ristretto255_scalar_halve(&scalar2x,&scalar2x);
+    fixed_window_recode(&scalar1x, scalarb, &point_scalarmul_adjustment);
+    fixed_window_recode(&scalar2x, scalarc, &point_scalarmul_adjustment);
 
     /* Set up a precomputed table with odd multiples of b. */
     pniels_t pn, multiples1[1<<((int)(RISTRETTO_WINDOW_BITS)-1)], multiples2[1<<((int)(RISTRETTO_WINDOW_BITS)-1)];
@@ -515,25 +909,41 @@ void ristretto255_point_double_scalarmul (
 
     /* Initialize. */
     int i,j,first=1;
+
+#if GF_HAS_GF4
+    pniels4_t pn4, multiples4_1[1<<((int)(RISTRETTO_WINDOW_BITS)-1)], multiples4_2[1<<((int)(RISTRETTO_WINDOW_BITS)-1)];
+    point4_t tmp4;
+    for (i=0; i<NTABLE; i++) {
+        pniels_to_pniels4(&multiples4_1[i], &multiples1[i]);
+        pniels_to_pniels4(&multiples4_2[i], &multiples2[i]);
+    }
+    pt_to_point4(&tmp4, &ristretto255_point_identity);
+#endif
+
     i = SCALAR_BITS - ((SCALAR_BITS-1) % WINDOW) - 1;
 
     for (; i>=0; i-=WINDOW) {
-        /* Fetch another block of bits */
-        word_t bits1 = scalar1x.limb[i/WBITS] >> (i%WBITS),
-                     bits2 = scalar2x.limb[i/WBITS] >> (i%WBITS);
-        if (i%WBITS >= WBITS-WINDOW && i/WBITS<SCALAR_LIMBS-1) {
-            bits1 ^= scalar1x.limb[i/WBITS+1] << (WBITS - (i%WBITS));
-            bits2 ^= scalar2x.limb[i/WBITS+1] << (WBITS - (i%WBITS));
+        mask_t inv1, inv2;
+        word_t idx1 = fixed_window_digit(&inv1, &scalar1x, i, WINDOW),
+               idx2 = fixed_window_digit(&inv2, &scalar2x, i, WINDOW);
+
+#if GF_HAS_GF4
+        /* As in ristretto255_point_scalarmul */
+        constant_time_lookup_pniels4(&pn4, multiples4_1, NTABLE, idx1);
+        cond_neg_pniels4(&pn4, inv1);
+        if (first) {
+            first = 0;
+        } else {
+            for (j=0; j<WINDOW; j++)
+                point4_double(&tmp4, &tmp4);
         }
-        bits1 &= WINDOW_MASK;
-        bits2 &= WINDOW_MASK;
-        mask_t inv1 = (bits1>>(WINDOW-1))-1;
-        mask_t inv2 = (bits2>>(WINDOW-1))-1;
-        bits1 ^= inv1;
-        bits2 ^= inv2;
-
+        point4_add_pniels4(&tmp4, &tmp4, &pn4);
+        constant_time_lookup_pniels4(&pn4, multiples4_2, NTABLE, idx2);
+        cond_neg_pniels4(&pn4, inv2);
+        point4_add_pniels4(&tmp4, &tmp4, &pn4);
+#else
         /* Add in from table.  Compute t only on last iteration. */
-        constant_time_lookup(&pn, multiples1, sizeof(pn), NTABLE, bits1 & WINDOW_T_MASK);
+        constant_time_lookup_pniels(&pn, multiples1, NTABLE, idx1);
         cond_neg_niels(&pn.n, inv1);
         if (first) {
             pniels_to_pt(&tmp, &pn);
@@ -548,11 +958,20 @@ void ristretto255_point_double_scalarmul (
             point_double_internal(&tmp, &tmp, 0);
             add_pniels_to_pt(&tmp, &pn, 0);
         }
-        constant_time_lookup(&pn, multiples2, sizeof(pn), NTABLE, bits2 & WINDOW_T_MASK);
+        constant_time_lookup_pniels(&pn, multiples2, NTABLE, idx2);
         cond_neg_niels(&pn.n, inv2);
         add_pniels_to_pt(&tmp, &pn, i?-1:0);
+#endif
     }
 
+#if GF_HAS_GF4
+    point4_to_pt(&tmp, &tmp4);
+    ristretto_bzero(&pn4,sizeof(pn4));
+    ristretto_bzero(&multiples4_1,sizeof(multiples4_1));
+    ristretto_bzero(&multiples4_2,sizeof(multiples4_2));
+    ristretto_bzero(&tmp4,sizeof(tmp4));
+#endif
+
     /* Write out the answer */
     ristretto255_point_copy(a,&tmp);
 
@@ -574,16 +993,12 @@ void ristretto255_point_dual_scalarmul (
 ) {
 
     const int WINDOW = RISTRETTO_WINDOW_BITS,
-        WINDOW_MASK = (1<<WINDOW)-1,
-        WINDOW_T_MASK = WINDOW_MASK >> 1,
         NTABLE = 1<<(WINDOW-1);
 
 
     scalar_t scalar1x, scalar2x;
-    ristretto255_scalar_add(&scalar1x, scalar1, &point_scalarmul_adjustment);
-    ristretto255_scalar_halve(&scalar1x,&scalar1x);
-    ristretto255_scalar_add(&scalar2x, scalar2, &point_scalarmul_adjustment);
-    ristretto255_scalar_halve(&scalar2x,&scalar2x);
+    fixed_window_recode(&scalar1x, scalar1, &point_scalarmul_adjustment);
+    fixed_window_recode(&scalar2x, scalar2, &point_scalarmul_adjustment);
 
     /* Set up a precomputed table with odd multiples of b. */
     point_t multiples1[1<<((int)(RISTRETTO_WINDOW_BITS)-1)], multiples2[1<<((int)(RISTRETTO_WINDOW_BITS)-1)], working, tmp;
@@ -601,43 +1016,77 @@ void ristretto255_point_dual_scalarmul (
         ristretto255_point_copy(&multiples2[i], &ristretto255_point_identity);
     }
 
+#if GF_HAS_GF4
+    point4_t working4, tmp4, multiples4_1[1<<((int)(RISTRETTO_WINDOW_BITS)-1)], multiples4_2[1<<((int)(RISTRETTO_WINDOW_BITS)-1)];
+    pniels4_t pn4;
+    pt_to_point4(&working4, &working);
+    for (i=0; i<NTABLE; i++) {
+        pt_to_point4(&multiples4_1[i], &multiples1[i]);
+        pt_to_point4(&multiples4_2[i], &multiples2[i]);
+    }
+#endif
+
     for (i=0; i<SCALAR_BITS; i+=WINDOW) {
+        mask_t inv1, inv2;
+        word_t idx1 = fixed_window_digit(&inv1, &scalar1x, i, WINDOW),
+               idx2 = fixed_window_digit(&inv2, &scalar2x, i, WINDOW);
+
+#if GF_HAS_GF4
+        /* The same bucket adds, with the buckets and the running multiple
+         * of b kept four lanes wide.
+         */
+        if (i) {
+            for (j=0; j<WINDOW; j++)
+                point4_double(&working4, &working4);
+        }
+        point4_to_pt(&working, &working4);
+        pt_to_pniels4(&pn4, &working);
+
+        constant_time_lookup_point4(&tmp4, multiples4_1, NTABLE, idx1);
+        cond_neg_pniels4(&pn4, inv1);
+        point4_add_pniels4(&tmp4, &tmp4, &pn4);
+        constant_time_insert(multiples4_1, &tmp4, sizeof(tmp4), NTABLE, idx1);
+
+        constant_time_lookup_point4(&tmp4, multiples4_2, NTABLE, idx2);
+        cond_neg_pniels4(&pn4, inv1^inv2);
+        point4_add_pniels4(&tmp4, &tmp4, &pn4);
+        constant_time_insert(multiples4_2, &tmp4, sizeof(tmp4), NTABLE, idx2);
+#else
         if (i) {
             for (j=0; j<WINDOW-1; j++)
                 point_double_internal(&working, &working, -1);
             point_double_internal(&working, &working, 0);
         }
 
-        /* Fetch another block of bits */
-        word_t bits1 = scalar1x.limb[i/WBITS] >> (i%WBITS),
-               bits2 = scalar2x.limb[i/WBITS] >> (i%WBITS);
-        if (i%WBITS >= WBITS-WINDOW && i/WBITS<SCALAR_LIMBS-1) {
-            bits1 ^= scalar1x.limb[i/WBITS+1] << (WBITS - (i%WBITS));
-            bits2 ^= scalar2x.limb[i/WBITS+1] << (WBITS - (i%WBITS));
-        }
-        bits1 &= WINDOW_MASK;
-        bits2 &= WINDOW_MASK;
-        mask_t inv1 = (bits1>>(WINDOW-1))-1;
-        mask_t inv2 = (bits2>>(WINDOW-1))-1;
-        bits1 ^= inv1;
-        bits2 ^= inv2;
-
         pt_to_pniels(&pn, &working);
 
-        constant_time_lookup(&tmp, &multiples1, sizeof(tmp), NTABLE, bits1 & WINDOW_T_MASK);
+        constant_time_lookup_point(&tmp, multiples1, NTABLE, idx1);
         cond_neg_niels(&pn.n, inv1);
-        /* add_pniels_to_pt(multiples1[bits1 & WINDOW_T_MASK], pn, 0); */
+        /* add_pniels_to_pt(multiples1[idx1], pn, 0); */
         add_pniels_to_pt(&tmp, &pn, 0);
-        constant_time_insert(multiples1, &tmp, sizeof(tmp), NTABLE, bits1 & WINDOW_T_MASK);
+        constant_time_insert(multiples1, &tmp, sizeof(tmp), NTABLE, idx1);
 
 
-        constant_time_lookup(&tmp, multiples2, sizeof(tmp), NTABLE, bits2 & WINDOW_T_MASK);
+        constant_time_lookup_point(&tmp, multiples2, NTABLE, idx2);
         cond_neg_niels(&pn.n, inv1^inv2);
-        /* add_pniels_to_pt(multiples2[bits2 & WINDOW_T_MASK], pn, 0); */
+        /* add_pniels_to_pt(multiples2[idx2], pn, 0); */
         add_pniels_to_pt(&tmp, &pn, 0);
-        constant_time_insert(&multiples2, &tmp, sizeof(tmp), NTABLE, bits2 & WINDOW_T_MASK);
+        constant_time_insert(&multiples2, &tmp, sizeof(tmp), NTABLE, idx2);
+#endif
     }
 
+#if GF_HAS_GF4
+    for (i=0; i<NTABLE; i++) {
+        point4_to_pt(&multiples1[i], &multiples4_1[i]);
+        point4_to_pt(&multiples2[i], &multiples4_2[i]);
+    }
+    ristretto_bzero(&pn4,sizeof(pn4));
+    ristretto_bzero(&multiples4_1,sizeof(multiples4_1));
+    ristretto_bzero(&multiples4_2,sizeof(multiples4_2));
+    ristretto_bzero(&tmp4,sizeof(tmp4));
+    ristretto_bzero(&working4,sizeof(working4));
+#endif
+
     if (NTABLE > 1) {
         ristretto255_point_copy(&working, &multiples1[NTABLE-1]);
         ristretto255_point_copy(&tmp    , &multiples2[NTABLE-1]);
@@ -763,6 +1212,92 @@ static void gf_batch_invert (
     }
 }
 
+/* Two points are equal when x1*y2 == y1*x2 or y1*y2 == x1*x2, so the class of
+ * a point is the pair {x/y, y/x}.  It is determined by x/y + y/x, and so by
+ * key = xy/(x^2+y^2), which is 0 for the identity.  If x^2+y^2 == 0 the key
+ * is infinite, and is marked by setting every byte, which no canonical field
+ * element does.
+ */
+void ristretto255_point_canonical_batch (
+    unsigned char (*keys)[SER_BYTES],
+    const point_t *pts,
+    size_t n
+) {
+    gf_25519_t num[RISTRETTO_CANONICAL_CHUNK], den[RISTRETTO_CANONICAL_CHUNK],
+        inv[RISTRETTO_CANONICAL_CHUNK], t;
+    mask_t inf[RISTRETTO_CANONICAL_CHUNK];
+    size_t i, j, m;
+
+    for (i=0; i<n; i+=m) {
+        m = n-i < RISTRETTO_CANONICAL_CHUNK ? n-i : RISTRETTO_CANONICAL_CHUNK;
+        for (j=0; j<m; j++) {
+            gf_mul(&num[j], &pts[i+j].x, &pts[i+j].y);
+            gf_sqr(&den[j], &pts[i+j].x);
+            gf_sqr(&t, &pts[i+j].y);
+            gf_add(&den[j], &den[j], &t);
+            inf[j] = gf_eq(&den[j], &ZERO);
+            gf_cond_sel(&den[j], &den[j], &ONE, inf[j]);
+        }
+        if (m > 1) {
+            gf_batch_invert(inv, den, m);
+        } else {
+            gf_invert(&inv[0], &den[0], 1);
+        }
+        for (j=0; j<m; j++) {
+            unsigned int k;
+            gf_mul(&t, &num[j], &inv[j]);
+            gf_serialize(keys[i+j], &t, 1);
+            for (k=0; k<SER_BYTES; k++) keys[i+j][k] |= (unsigned char)inf[j];
+        }
+    }
+}
+
+struct dedup_entry {
+    unsigned char key[SER_BYTES];
+    size_t index;
+};
+
+static int dedup_cmp(const void *a, const void *b) {
+    const struct dedup_entry *x = a, *y = b;
+    int c = memcmp(x->key, y->key, SER_BYTES);
+    if (c) return c;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+ristretto_error_t ristretto255_point_dedup (
+    size_t *first,
+    const point_t *pts,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) {
+    unsigned char keys[RISTRETTO_CANONICAL_CHUNK][SER_BYTES];
+    size_t i, j, m;
+
+    if (n == 0) return RISTRETTO_SUCCESS;
+    struct dedup_entry *entries = ristretto_alloc(allocator, n*sizeof(*entries));
+    if (entries == NULL) return RISTRETTO_FAILURE;
+
+    for (i=0; i<n; i+=m) {
+        m = n-i < RISTRETTO_CANONICAL_CHUNK ? n-i : RISTRETTO_CANONICAL_CHUNK;
+        ristretto255_point_canonical_batch(keys, &pts[i], m);
+        for (j=0; j<m; j++) {
+            memcpy(entries[i+j].key, keys[j], SER_BYTES);
+            entries[i+j].index = i+j;
+        }
+    }
+
+    /* Equal points sort together, earliest first */
+    qsort(entries, n, sizeof(*entries), dedup_cmp);
+    for (i=0; i<n; i=j) {
+        for (j=i; j<n && !memcmp(entries[j].key, entries[i].key, SER_BYTES); j++) {
+            first[entries[j].index] = entries[i].index;
+        }
+    }
+
+    ristretto_free(allocator, entries, n*sizeof(*entries));
+    return RISTRETTO_SUCCESS;
+}
+
 static void batch_normalize_niels (
     niels_t *table,
     const gf_25519_t *zs,
@@ -771,7 +1306,11 @@ static void batch_normalize_niels (
 ) {
     int i;
     gf_25519_t product;
-    gf_batch_invert(zis, zs, n);
+    if (n > 1) {
+        gf_batch_invert(zis, zs, n);
+    } else {
+        gf_invert(&zis[0], &zs[0], 1);
+    }
 
     for (i=0; i<n; i++) {
         gf_mul(&product, &table[i].a, &zis[i]);
@@ -790,19 +1329,30 @@ static void batch_normalize_niels (
     ristretto_bzero(&product,sizeof(product));
 }
 
-void ristretto255_precompute (
-    precomputed_s *table,
-    const point_t *base
+/* The most teeth any comb here has: the base table's or a generator's */
+#if COMBS_T > RISTRETTO255_GENERATORS_MAX_TEETH
+#define COMB_MAX_TEETH COMBS_T
+#else
+#define COMB_MAX_TEETH RISTRETTO255_GENERATORS_MAX_TEETH
+#endif
+
+/* Fill in n combs of base with t teeth spaced s bits apart, with their
+ * z coordinates in zs to be normalized away by the caller.
+ */
+static void comb_precompute (
+    niels_t *table,
+    gf_25519_t *zs,
+    const point_t *base,
+    unsigned int n,
+    unsigned int t,
+    unsigned int s
 ) {
-    const unsigned int n = COMBS_N, t = COMBS_T, s = COMBS_S;
-    assert(n*t*s >= SCALAR_BITS);
+    assert(t >= 1 && t <= COMB_MAX_TEETH);
 
-    point_t working, start, doubles[COMBS_T-1];
+    point_t working, start, doubles[COMB_MAX_TEETH-1];
     ristretto255_point_copy(&working, base);
     pniels_t pn_tmp;
 
-    gf_25519_t zs[(unsigned int)(COMBS_N)<<(unsigned int)(COMBS_T-1)], zis[(unsigned int)(COMBS_N)<<(unsigned int)(COMBS_T-1)];
-
     unsigned int i,j,k;
 
     /* Compute n tables */
@@ -828,7 +1378,7 @@ void ristretto255_precompute (
             int idx = (((i+1)<<(t-1))-1) ^ gray;
 
             pt_to_pniels(&pn_tmp, &start);
-            memcpy(&table->table[idx], &pn_tmp.n, sizeof(pn_tmp.n));
+            memcpy(&table[idx], &pn_tmp.n, sizeof(pn_tmp.n));
             gf_copy(&zs[idx], &pn_tmp.z);
 
             if (j >= (1u<<(t-1)) - 1) break;
@@ -845,24 +1395,37 @@ void ristretto255_precompute (
         }
     }
 
-    batch_normalize_niels(table->table,zs,zis,n<<(t-1));
-
-    ristretto_bzero(&zs,sizeof(zs));
-    ristretto_bzero(&zis,sizeof(zis));
     ristretto_bzero(&pn_tmp,sizeof(pn_tmp));
     ristretto_bzero(&working,sizeof(working));
     ristretto_bzero(&start,sizeof(start));
     ristretto_bzero(&doubles,sizeof(doubles));
 }
 
-static RISTRETTO_INLINE void
-constant_time_lookup_niels (
-    niels_t *__restrict__ ni,
-    const niels_t *table,
-    int nelts,
-    int idx
+void ristretto255_precompute (
+    precomputed_s *table,
+    const point_t *base
+) {
+    const unsigned int n = COMBS_N, t = COMBS_T, s = COMBS_S;
+    assert(n*t*s >= SCALAR_BITS);
+
+    gf_25519_t zs[(unsigned int)(COMBS_N)<<(unsigned int)(COMBS_T-1)], zis[(unsigned int)(COMBS_N)<<(unsigned int)(COMBS_T-1)];
+
+    comb_precompute(table->table,zs,base,n,t,s);
+    batch_normalize_niels(table->table,zs,zis,n<<(t-1));
+
+    ristretto_bzero(&zs,sizeof(zs));
+    ristretto_bzero(&zis,sizeof(zis));
+}
+
+ristretto_error_t ristretto255_precomputed_create (
+    precomputed_s **pre,
+    const point_t *base,
+    const ristretto255_allocator_t *allocator
 ) {
-    constant_time_lookup(ni, table, sizeof(niels_t), nelts, idx);
+    *pre = ristretto_alloc(allocator, sizeof(precomputed_s));
+    if (*pre == NULL) return RISTRETTO_FAILURE;
+    ristretto255_precompute(*pre, base);
+    return RISTRETTO_SUCCESS;
 }
 
 void ristretto255_precomputed_scalarmul (
@@ -875,7 +1438,7 @@ void ristretto255_precomputed_scalarmul (
     const unsigned int n = COMBS_N, t = COMBS_T, s = COMBS_S;
 
     scalar_t scalar1x;
-    ristretto255_scalar_add(&scalar1x, scalar, &precomputed_scalarmul_adjustment);
+    ristretto255_scalar_add(&scalar1x, scalar, &ristretto255_precomputed_scalarmul_adjustment);
     ristretto255_scalar_halve(&scalar1x,&scalar1x);
 
     niels_t ni;
@@ -912,6 +1475,50 @@ void ristretto255_precomputed_scalarmul (
     ristretto_bzero(&scalar1x,sizeof(scalar1x));
 }
 
+void ristretto255_precomputed_scalarmul_non_secret (
+    point_t *out,
+    const precomputed_s *table,
+    const scalar_t *scalar
+) {
+    int i;
+    unsigned j,k;
+    const unsigned int n = COMBS_N, t = COMBS_T, s = COMBS_S;
+
+    scalar_t scalar1x;
+    ristretto255_scalar_add(&scalar1x, scalar, &ristretto255_precomputed_scalarmul_adjustment);
+    ristretto255_scalar_halve(&scalar1x,&scalar1x);
+
+    /* Same comb as ristretto255_precomputed_scalarmul, but index the table
+     * directly and subtract instead of conditionally negating. */
+    for (i=s-1; i>=0; i--) {
+        if (i != (int)s-1) point_double_internal(out,out,0);
+
+        for (j=0; j<n; j++) {
+            int tab = 0;
+
+            for (k=0; k<t; k++) {
+                unsigned int bit = i + s*(k + j*t);
+                if (bit < SCALAR_BITS) {
+                    tab |= (scalar1x.limb[bit/WBITS] >> (bit%WBITS) & 1) << k;
+                }
+            }
+
+            int invert = !(tab>>(t-1));
+            if (invert) tab = ~tab;
+            tab &= (1<<(t-1)) - 1;
+
+            const niels_t *ni = &table->table[(j<<(t-1)) + tab];
+            if ((i!=(int)s-1)||j) {
+                if (invert) sub_niels_from_pt(out, ni, j==n-1 && i);
+                else add_niels_to_pt(out, ni, j==n-1 && i);
+            } else {
+                niels_to_pt(out, ni);
+                if (invert) ristretto255_point_negate(out, out);
+            }
+        }
+    }
+}
+
 void ristretto255_point_cond_sel (
     point_t *out,
     const point_t *a,
@@ -947,6 +1554,8 @@ struct smvt_control {
   int power, addend;
 };
 
+#define WNAF_CONTROL_SIZE(tbits) (SCALAR_BITS/((tbits)+1) + 3)
+
 static int recode_wnaf (
     struct smvt_control *control, /* [nbits/(table_bits+1) + 3] */
     const scalar_t *scalar,
@@ -1073,33 +1682,58 @@ void ristretto255_precompute_wnafs (
     ristretto_bzero(zis,sizeof(zis));
 }
 
-void ristretto255_base_double_scalarmul_non_secret (
+/* Add or subtract entry addend of the variable base's table, which is
+ * either projective (pvar) or affine (nvar)
+ */
+static RISTRETTO_INLINE void wnaf_add_var (
+    point_t *combo,
+    const pniels_t *pvar,
+    const niels_t *nvar,
+    int addend,
+    int before_double
+) {
+    if (pvar && addend > 0) {
+        add_pniels_to_pt(combo, &pvar[addend >> 1], before_double);
+    } else if (pvar) {
+        sub_pniels_from_pt(combo, &pvar[(-addend) >> 1], before_double);
+    } else if (addend > 0) {
+        add_niels_to_pt(combo, &nvar[addend >> 1], before_double);
+    } else {
+        sub_niels_from_pt(combo, &nvar[(-addend) >> 1], before_double);
+    }
+}
+
+/* combo = scalar1*base + scalar2*base2, interleaving the wNAFs of the
+ * scalars.  Exactly one of pvar and nvar is base2's table.
+ */
+static RISTRETTO_INLINE void wnaf_double_scalarmul (
     point_t *combo,
     const scalar_t *scalar1,
-    const point_t *base2,
+    const pniels_t *pvar,
+    const niels_t *nvar,
+    int table_bits_var,
     const scalar_t *scalar2
 ) {
-    const int table_bits_var = RISTRETTO_WNAF_VAR_TABLE_BITS,
-        table_bits_pre = RISTRETTO_WNAF_FIXED_TABLE_BITS;
-    struct smvt_control control_var[SCALAR_BITS/((int)(RISTRETTO_WNAF_VAR_TABLE_BITS)+1)+3];
-    struct smvt_control control_pre[SCALAR_BITS/((int)(RISTRETTO_WNAF_FIXED_TABLE_BITS)+1)+3];
+    const int table_bits_pre = RISTRETTO_WNAF_FIXED_TABLE_BITS;
+    struct smvt_control control_var[WNAF_CONTROL_SIZE(1)];
+    struct smvt_control control_pre[WNAF_CONTROL_SIZE(RISTRETTO_WNAF_FIXED_TABLE_BITS)];
 
     int ncb_pre = recode_wnaf(control_pre, scalar1, table_bits_pre);
     int ncb_var = recode_wnaf(control_var, scalar2, table_bits_var);
 
-    pniels_t precmp_var[1<<(int)(RISTRETTO_WNAF_VAR_TABLE_BITS)];
-    prepare_wnaf_table(precmp_var, base2, table_bits_var);
-
     int contp=0, contv=0, i = control_var[0].power;
 
-    if (i < 0) {
+    /* An empty control list means that scalar is zero, not the whole sum */
+    if (i < 0 && control_pre[0].power < 0) {
         ristretto255_point_copy(combo, &ristretto255_point_identity);
         return;
     } else if (i > control_pre[0].power) {
-        pniels_to_pt(combo, &precmp_var[control_var[0].addend >> 1]);
+        if (pvar) pniels_to_pt(combo, &pvar[control_var[0].addend >> 1]);
+        else niels_to_pt(combo, &nvar[control_var[0].addend >> 1]);
         contv++;
     } else if (i == control_pre[0].power && i >=0 ) {
-        pniels_to_pt(combo, &precmp_var[control_var[0].addend >> 1]);
+        if (pvar) pniels_to_pt(combo, &pvar[control_var[0].addend >> 1]);
+        else niels_to_pt(combo, &nvar[control_var[0].addend >> 1]);
         add_niels_to_pt(combo, &ristretto255_wnaf_base[control_pre[0].addend >> 1], i);
         contv++; contp++;
     } else {
@@ -1114,12 +1748,7 @@ void ristretto255_base_double_scalarmul_non_secret (
 
         if (cv) {
             assert(control_var[contv].addend);
-
-            if (control_var[contv].addend > 0) {
-                add_pniels_to_pt(combo, &precmp_var[control_var[contv].addend >> 1], i&&!cp);
-            } else {
-                sub_pniels_from_pt(combo, &precmp_var[(-control_var[contv].addend) >> 1], i&&!cp);
-            }
+            wnaf_add_var(combo, pvar, nvar, control_var[contv].addend, i&&!cp);
             contv++;
         }
 
@@ -1138,12 +1767,1375 @@ void ristretto255_base_double_scalarmul_non_secret (
     /* This function is non-secret, but whatever this is cheap. */
     ristretto_bzero(&control_var,sizeof(control_var));
     ristretto_bzero(&control_pre,sizeof(control_pre));
-    ristretto_bzero(&precmp_var,sizeof(precmp_var));
 
     assert(contv == ncb_var); (void)ncb_var;
     assert(contp == ncb_pre); (void)ncb_pre;
 }
 
+void ristretto255_base_double_scalarmul_non_secret (
+    point_t *combo,
+    const scalar_t *scalar1,
+    const point_t *base2,
+    const scalar_t *scalar2
+) {
+    pniels_t precmp_var[1<<(int)(RISTRETTO_WNAF_VAR_TABLE_BITS)];
+    prepare_wnaf_table(precmp_var, base2, RISTRETTO_WNAF_VAR_TABLE_BITS);
+    wnaf_double_scalarmul(combo, scalar1, precmp_var, NULL, RISTRETTO_WNAF_VAR_TABLE_BITS, scalar2);
+    ristretto_bzero(&precmp_var,sizeof(precmp_var));
+}
+
+struct ristretto255_wnaf_precomputed_s {
+    unsigned int table_bits;
+    niels_t table[];
+};
+
+size_t ristretto255_sizeof_wnaf_precomputed (
+    unsigned int table_bits
+) {
+    if (table_bits < 1 || table_bits > RISTRETTO255_WNAF_MAX_TABLE_BITS) return 0;
+    return sizeof(ristretto255_wnaf_precomputed_t) + (sizeof(niels_t)<<table_bits);
+}
+
+unsigned int ristretto255_wnaf_precomputed_table_bits (
+    const ristretto255_wnaf_precomputed_t *pre
+) {
+    return pre->table_bits;
+}
+
+size_t ristretto255_wnaf_precompute_scratch_size (
+    unsigned int table_bits
+) {
+    if (table_bits < 1 || table_bits > RISTRETTO255_WNAF_MAX_TABLE_BITS) return 0;
+    return ((size_t)1<<table_bits) * (sizeof(pniels_t) + 2*sizeof(gf_25519_t));
+}
+
+ristretto_error_t ristretto255_wnaf_precompute (
+    ristretto255_wnaf_precomputed_t *out,
+    const point_t *base,
+    unsigned int table_bits,
+    const ristretto255_allocator_t *allocator
+) {
+    const size_t tmp_bytes = ristretto255_wnaf_precompute_scratch_size(table_bits);
+    if (tmp_bytes == 0) return RISTRETTO_FAILURE;
+
+    const int n = 1<<table_bits;
+    pniels_t *tmp = ristretto_alloc(allocator, tmp_bytes);
+    if (tmp == NULL) return RISTRETTO_FAILURE;
+    gf_25519_t *zs = (gf_25519_t *)&tmp[n], *zis = &zs[n];
+
+    int i;
+    prepare_wnaf_table(tmp,base,table_bits);
+    for (i=0; i<n; i++) {
+        memcpy(&out->table[i], &tmp[i].n, sizeof(niels_t));
+        gf_copy(&zs[i], &tmp[i].z);
+    }
+    batch_normalize_niels(out->table, zs, zis, n);
+    out->table_bits = table_bits;
+
+    ristretto_bzero(tmp,tmp_bytes);
+    ristretto_free(allocator, tmp, tmp_bytes);
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_wnaf_precomputed_create (
+    ristretto255_wnaf_precomputed_t **pre,
+    const point_t *base,
+    unsigned int table_bits,
+    const ristretto255_allocator_t *allocator
+) {
+    *pre = NULL;
+    const size_t bytes = ristretto255_sizeof_wnaf_precomputed(table_bits);
+    if (bytes == 0) return RISTRETTO_FAILURE;
+
+    ristretto255_wnaf_precomputed_t *out = ristretto_alloc(allocator, bytes);
+    if (out == NULL) return RISTRETTO_FAILURE;
+    if (ristretto255_wnaf_precompute(out, base, table_bits, allocator) != RISTRETTO_SUCCESS) {
+        ristretto_free(allocator, out, bytes);
+        return RISTRETTO_FAILURE;
+    }
+    *pre = out;
+    return RISTRETTO_SUCCESS;
+}
+
+void ristretto255_wnaf_precomputed_destroy (
+    ristretto255_wnaf_precomputed_t *pre,
+    const ristretto255_allocator_t *allocator
+) {
+    if (pre == NULL) return;
+    const size_t bytes = sizeof(*pre) + (sizeof(niels_t)<<pre->table_bits);
+    ristretto_bzero(pre, bytes);
+    ristretto_free(allocator, pre, bytes);
+}
+
+void ristretto255_base_double_scalarmul_non_secret_precomputed (
+    point_t *combo,
+    const scalar_t *scalar1,
+    const ristretto255_wnaf_precomputed_t *base2,
+    const scalar_t *scalar2
+) {
+    wnaf_double_scalarmul(combo, scalar1, NULL, base2->table, base2->table_bits, scalar2);
+}
+
+/* Point batches.  Limb i of coordinate c of the k'th point of a block is
+ * limb[c][i][k], so with an 8-way field each limb of a coordinate is one
+ * row, and blocks are worked on without transposing them.  Lanes past the
+ * end of the batch hold the identity.
+ */
+#define BATCH_LANES RISTRETTO255_POINT_BATCH_LANES
+
+typedef struct {
+    word_t limb[4][RISTRETTO255_FIELD_LIMBS][BATCH_LANES];
+} point_block_t;
+
+struct ristretto255_point_batch_s {
+    size_t n;
+    point_block_t block[];
+};
+
+#define BATCH_NBLOCKS(n) (((n) + BATCH_LANES - 1) / BATCH_LANES)
+
+static size_t point_batch_bytes(size_t n) {
+    return sizeof(ristretto255_point_batch_t) + BATCH_NBLOCKS(n)*sizeof(point_block_t);
+}
+
+/* The number of points in block j that are in the batch */
+static RISTRETTO_INLINE unsigned int point_batch_lanes(const ristretto255_point_batch_t *batch, size_t j) {
+    size_t left = batch->n - j*BATCH_LANES;
+    return left < BATCH_LANES ? (unsigned int)left : BATCH_LANES;
+}
+
+static RISTRETTO_INLINE void point_block_get(point_t *p, const point_block_t *b, unsigned int k) {
+    gf_25519_t *const out[4] = { &p->x, &p->y, &p->z, &p->t };
+    unsigned int c, i;
+    for (c=0; c<4; c++) {
+        for (i=0; i<RISTRETTO255_FIELD_LIMBS; i++) out[c]->limb[i] = b->limb[c][i][k];
+    }
+}
+
+/* Store weakly reduced limbs, which is what the 8-way field takes */
+static RISTRETTO_INLINE void point_block_put(point_block_t *b, unsigned int k, const point_t *p) {
+    const gf_25519_t *const in[4] = { &p->x, &p->y, &p->z, &p->t };
+    gf_25519_t tmp;
+    unsigned int c, i;
+    for (c=0; c<4; c++) {
+        gf_copy(&tmp, in[c]);
+        gf_weak_reduce(&tmp);
+        for (i=0; i<RISTRETTO255_FIELD_LIMBS; i++) b->limb[c][i][k] = tmp.limb[i];
+    }
+}
+
+static RISTRETTO_INLINE void point_batch_get(point_t *p, const ristretto255_point_batch_t *batch, size_t i) {
+    point_block_get(p, &batch->block[i/BATCH_LANES], i%BATCH_LANES);
+}
+
+#if GF_HAS_GF8
+/* Eight points, one per lane of a gf8 */
+typedef struct { gf8_25519_t x, y, z, t; } point8_t;
+
+static RISTRETTO_INLINE void point8_load(point8_t *p, const point_block_t *b) {
+    gf8_25519_t *const out[4] = { &p->x, &p->y, &p->z, &p->t };
+    unsigned int c, i;
+    for (c=0; c<4; c++) {
+        for (i=0; i<5; i++) out[c]->limb[i] = _mm512_loadu_si512((const void *)b->limb[c][i]);
+    }
+}
+
+static RISTRETTO_INLINE void point8_store(point_block_t *b, const point8_t *p) {
+    const gf8_25519_t *const in[4] = { &p->x, &p->y, &p->z, &p->t };
+    unsigned int c, i;
+    for (c=0; c<4; c++) {
+        for (i=0; i<5; i++) _mm512_storeu_si512((void *)b->limb[c][i], in[c]->limb[i]);
+    }
+}
+
+/* As ristretto255_point_add */
+static void point8_add(point8_t *p, const point8_t *q, const point8_t *r) {
+    gf8_25519_t a, b, c, d, x, y;
+    gf8_sub(&b, &q->y, &q->x);
+    gf8_sub(&c, &r->y, &r->x);
+    gf8_add(&d, &r->y, &r->x);
+    gf8_mul(&a, &c, &b);
+    gf8_add(&b, &q->y, &q->x);
+    gf8_mul(&y, &d, &b);
+    gf8_mul(&b, &r->t, &q->t);
+    gf8_mulw_unsigned(&x, &b, 2*TWISTED_D);
+    gf8_add(&b, &a, &y);
+    gf8_sub(&c, &y, &a);
+    gf8_mul(&a, &q->z, &r->z);
+    gf8_add(&a, &a, &a);
+    gf8_sub(&y, &a, &x);
+    gf8_add(&a, &a, &x);
+    gf8_mul(&p->z, &a, &y);
+    gf8_mul(&p->x, &y, &c);
+    gf8_mul(&p->y, &a, &b);
+    gf8_mul(&p->t, &b, &c);
+}
+
+/* As point_double_internal */
+static void point8_double(point8_t *p, const point8_t *q, int before_double) {
+    gf8_25519_t a, b, c, d, t, z;
+    gf8_sqr(&c, &q->x);
+    gf8_sqr(&a, &q->y);
+    gf8_add(&d, &c, &a);
+    gf8_add(&t, &q->y, &q->x);
+    gf8_sqr(&b, &t);
+    gf8_sub(&b, &b, &d);
+    gf8_sub(&t, &a, &c);
+    gf8_sqr(&a, &q->z);
+    gf8_add(&z, &a, &a);
+    gf8_sub(&a, &z, &t);
+    gf8_mul(&p->x, &a, &b);
+    gf8_mul(&p->z, &t, &a);
+    gf8_mul(&p->y, &t, &d);
+    if (!before_double) gf8_mul(&p->t, &b, &d);
+}
+
+/* Negate the lanes selected by neg */
+static RISTRETTO_INLINE void point8_cond_neg(point8_t *p, __mmask8 neg) {
+    gf8_25519_t zero, m;
+    memset(&zero, 0, sizeof(zero));
+    gf8_sub(&m, &zero, &p->x);
+    gf8_cond_sel(&p->x, &p->x, &m, neg);
+    gf8_sub(&m, &zero, &p->t);
+    gf8_cond_sel(&p->t, &p->t, &m, neg);
+}
+
+static RISTRETTO_INLINE void point8_cond_sel(point8_t *out, const point8_t *a, const point8_t *b, __mmask8 pick) {
+    gf8_cond_sel(&out->x, &a->x, &b->x, pick);
+    gf8_cond_sel(&out->y, &a->y, &b->y, pick);
+    gf8_cond_sel(&out->z, &a->z, &b->z, pick);
+    gf8_cond_sel(&out->t, &a->t, &b->t, pick);
+}
+
+/* out = table[idx[k]] in lane k, reading every entry */
+static RISTRETTO_INLINE void point8_lookup(point8_t *out, const point8_t *table, int ntable, __m512i idx) {
+    int j;
+    *out = table[0];
+    for (j=1; j<ntable; j++) {
+        point8_cond_sel(out, out, &table[j], _mm512_cmpeq_epi64_mask(idx, _mm512_set1_epi64(j)));
+    }
+}
+
+/* As ristretto255_point_scalarmul in each lane, with a 4-bit window */
+static void point8_scalarmul(point8_t *out, const point8_t *base, const scalar_t scalars[BATCH_LANES]) {
+    const int WINDOW = 4, NTABLE = 1<<(WINDOW-1);
+    scalar_t scalar1x[BATCH_LANES];
+    point8_t multiples[1<<(4-1)], pn, tmp;
+    unsigned int k;
+    int i, j;
+
+    for (k=0; k<BATCH_LANES; k++) {
+        fixed_window_recode(&scalar1x[k], &scalars[k], &fixed_window_adjustment_4);
+    }
+
+    /* Odd multiples of each lane's base */
+    point8_double(&tmp, base, 0);
+    multiples[0] = *base;
+    for (j=1; j<NTABLE; j++) point8_add(&multiples[j], &multiples[j-1], &tmp);
+
+    i = SCALAR_BITS - ((SCALAR_BITS-1) % WINDOW) - 1;
+    for (; i>=0; i-=WINDOW) {
+        uint64_t idx[BATCH_LANES];
+        __mmask8 neg = 0;
+        for (k=0; k<BATCH_LANES; k++) {
+            mask_t inv;
+            idx[k] = fixed_window_digit(&inv, &scalar1x[k], i, WINDOW);
+            neg |= (__mmask8)((inv & 1) << k);
+        }
+
+        point8_lookup(&pn, multiples, NTABLE, _mm512_loadu_si512((const void *)idx));
+        point8_cond_neg(&pn, neg);
+        if (i == (int)(SCALAR_BITS - ((SCALAR_BITS-1) % WINDOW) - 1)) {
+            tmp = pn;
+        } else {
+            for (j=0; j<WINDOW-1; j++) point8_double(&tmp, &tmp, -1);
+            point8_double(&tmp, &tmp, 0);
+            point8_add(&tmp, &tmp, &pn);
+        }
+    }
+
+    *out = tmp;
+    ristretto_bzero(scalar1x, sizeof(scalar1x));
+    ristretto_bzero(multiples, sizeof(multiples));
+    ristretto_bzero(&pn, sizeof(pn));
+    ristretto_bzero(&tmp, sizeof(tmp));
+}
+#endif /* GF_HAS_GF8 */
+
+ristretto_error_t ristretto255_point_batch_create (
+    ristretto255_point_batch_t **batch,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) {
+    *batch = NULL;
+    if (n > (SIZE_MAX/2 - sizeof(ristretto255_point_batch_t)) / sizeof(point_block_t) * BATCH_LANES) {
+        return RISTRETTO_FAILURE;
+    }
+    ristretto255_point_batch_t *out = ristretto_alloc(allocator, point_batch_bytes(n));
+    if (out == NULL) return RISTRETTO_FAILURE;
+
+    size_t j;
+    unsigned int k;
+    out->n = n;
+    for (j=0; j<BATCH_NBLOCKS(n); j++) {
+        for (k=0; k<BATCH_LANES; k++) point_block_put(&out->block[j], k, &ristretto255_point_identity);
+    }
+    *batch = out;
+    return RISTRETTO_SUCCESS;
+}
+
+void ristretto255_point_batch_destroy (
+    ristretto255_point_batch_t *batch,
+    const ristretto255_allocator_t *allocator
+) {
+    if (batch == NULL) return;
+    const size_t bytes = point_batch_bytes(batch->n);
+    ristretto_bzero(batch, bytes);
+    ristretto_free(allocator, batch, bytes);
+}
+
+size_t ristretto255_point_batch_count (
+    const ristretto255_point_batch_t *batch
+) {
+    return batch->n;
+}
+
+ristretto_error_t ristretto255_point_batch_pack (
+    ristretto255_point_batch_t *batch,
+    size_t first,
+    const point_t *pts,
+    size_t n
+) {
+    size_t i;
+    if (first > batch->n || n > batch->n - first) return RISTRETTO_FAILURE;
+    for (i=0; i<n; i++) {
+        point_block_put(&batch->block[(first+i)/BATCH_LANES], (first+i)%BATCH_LANES, &pts[i]);
+    }
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_point_batch_unpack (
+    point_t *pts,
+    const ristretto255_point_batch_t *batch,
+    size_t first,
+    size_t n
+) {
+    size_t i;
+    if (first > batch->n || n > batch->n - first) return RISTRETTO_FAILURE;
+    for (i=0; i<n; i++) point_batch_get(&pts[i], batch, first+i);
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_point_batch_add (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a,
+    const ristretto255_point_batch_t *b
+) {
+    if (a->n != out->n || b->n != out->n) return RISTRETTO_FAILURE;
+    size_t j;
+    for (j=0; j<BATCH_NBLOCKS(out->n); j++) {
+#if GF_HAS_GF8
+        point8_t p, q;
+        point8_load(&p, &a->block[j]);
+        point8_load(&q, &b->block[j]);
+        point8_add(&p, &p, &q);
+        point8_store(&out->block[j], &p);
+#else
+        point_t p, q;
+        unsigned int k;
+        for (k=0; k<point_batch_lanes(out, j); k++) {
+            point_block_get(&p, &a->block[j], k);
+            point_block_get(&q, &b->block[j], k);
+            ristretto255_point_add(&p, &p, &q);
+            point_block_put(&out->block[j], k, &p);
+        }
+#endif
+    }
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_point_batch_double (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a
+) {
+    if (a->n != out->n) return RISTRETTO_FAILURE;
+    size_t j;
+    for (j=0; j<BATCH_NBLOCKS(out->n); j++) {
+#if GF_HAS_GF8
+        point8_t p;
+        point8_load(&p, &a->block[j]);
+        point8_double(&p, &p, 0);
+        point8_store(&out->block[j], &p);
+#else
+        point_t p;
+        unsigned int k;
+        for (k=0; k<point_batch_lanes(out, j); k++) {
+            point_block_get(&p, &a->block[j], k);
+            ristretto255_point_double(&p, &p);
+            point_block_put(&out->block[j], k, &p);
+        }
+#endif
+    }
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_point_batch_negate (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a
+) {
+    if (a->n != out->n) return RISTRETTO_FAILURE;
+    size_t j;
+    for (j=0; j<BATCH_NBLOCKS(out->n); j++) {
+#if GF_HAS_GF8
+        point8_t p;
+        point8_load(&p, &a->block[j]);
+        point8_cond_neg(&p, 0xff);
+        point8_store(&out->block[j], &p);
+#else
+        point_t p;
+        unsigned int k;
+        for (k=0; k<point_batch_lanes(out, j); k++) {
+            point_block_get(&p, &a->block[j], k);
+            ristretto255_point_negate(&p, &p);
+            point_block_put(&out->block[j], k, &p);
+        }
+#endif
+    }
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_point_batch_cond_sel (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a,
+    const ristretto255_point_batch_t *b,
+    const ristretto_bool_t *pick_b
+) {
+    if (a->n != out->n || b->n != out->n) return RISTRETTO_FAILURE;
+    size_t j;
+    unsigned int k;
+    for (j=0; j<BATCH_NBLOCKS(out->n); j++) {
+#if GF_HAS_GF8
+        point8_t p, q;
+        __mmask8 pick = 0;
+        for (k=0; k<point_batch_lanes(out, j); k++) {
+            pick |= (__mmask8)((bool_to_mask(pick_b[j*BATCH_LANES+k]) & 1) << k);
+        }
+        point8_load(&p, &a->block[j]);
+        point8_load(&q, &b->block[j]);
+        point8_cond_sel(&p, &p, &q, pick);
+        point8_store(&out->block[j], &p);
+#else
+        point_t p, q;
+        for (k=0; k<point_batch_lanes(out, j); k++) {
+            point_block_get(&p, &a->block[j], k);
+            point_block_get(&q, &b->block[j], k);
+            ristretto255_point_cond_sel(&p, &p, &q, pick_b[j*BATCH_LANES+k]);
+            point_block_put(&out->block[j], k, &p);
+        }
+#endif
+    }
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_point_batch_scalarmul (
+    ristretto255_point_batch_t *out,
+    const ristretto255_point_batch_t *a,
+    const scalar_t *scalars
+) {
+    if (a->n != out->n) return RISTRETTO_FAILURE;
+    size_t j;
+    unsigned int k;
+    for (j=0; j<BATCH_NBLOCKS(out->n); j++) {
+        const unsigned int m = point_batch_lanes(out, j);
+#if GF_HAS_GF8
+        /* The lanes past the end multiply the identity by zero */
+        scalar_t s[BATCH_LANES];
+        point8_t p;
+        for (k=0; k<BATCH_LANES; k++) s[k] = k<m ? scalars[j*BATCH_LANES+k] : ristretto255_scalar_zero;
+        point8_load(&p, &a->block[j]);
+        point8_scalarmul(&p, &p, s);
+        point8_store(&out->block[j], &p);
+        ristretto_bzero(s, sizeof(s));
+#else
+        point_t p;
+        for (k=0; k<m; k++) {
+            point_block_get(&p, &a->block[j], k);
+            ristretto255_point_scalarmul(&p, &p, &scalars[j*BATCH_LANES+k]);
+            point_block_put(&out->block[j], k, &p);
+        }
+#endif
+    }
+    return RISTRETTO_SUCCESS;
+}
+
+void ristretto255_point_batch_encode (
+    uint8_t (*out)[SER_BYTES],
+    const ristretto255_point_batch_t *batch
+) {
+    point_t pts[BATCH_LANES];
+    size_t j;
+    unsigned int k;
+    for (j=0; j<BATCH_NBLOCKS(batch->n); j++) {
+        const unsigned int m = point_batch_lanes(batch, j);
+        for (k=0; k<m; k++) point_block_get(&pts[k], &batch->block[j], k);
+        ristretto255_point_encode_batch(&out[j*BATCH_LANES], pts, m);
+    }
+}
+
+ristretto_error_t ristretto255_point_batch_decode (
+    ristretto255_point_batch_t *batch,
+    ristretto_error_t *results,
+    const uint8_t *ser,
+    ristretto_bool_t allow_identity
+) {
+    point_t pts[BATCH_LANES];
+    mask_t all = -(mask_t)1;
+    size_t j;
+    unsigned int k;
+    for (j=0; j<BATCH_NBLOCKS(batch->n); j++) {
+        const unsigned int m = point_batch_lanes(batch, j);
+        all &= bool_to_mask(ristretto_successful(ristretto255_point_decode_batch(pts,
+            &results[j*BATCH_LANES], &ser[j*BATCH_LANES*SER_BYTES], m, allow_identity)));
+        for (k=0; k<m; k++) point_block_put(&batch->block[j], k, &pts[k]);
+    }
+    ristretto_bzero(pts, sizeof(pts));
+    return ristretto_succeed_if(mask_to_bool(all));
+}
+
+/* Number of signed digits of a scalar in radix 2^c (the top one absorbs the carry) */
+#define PIPPENGER_NWINDOWS(c) (SCALAR_BITS/(c) + 1)
+
+/* Choose the Pippenger window size which minimizes the number of additions. */
+static unsigned int pippenger_window_bits(size_t n) {
+    unsigned int c, best = RISTRETTO_MSM_PIPPENGER_MIN_BITS;
+    size_t best_cost = (size_t)-1;
+    for (c=RISTRETTO_MSM_PIPPENGER_MIN_BITS; c<=RISTRETTO_MSM_PIPPENGER_MAX_BITS; c++) {
+        size_t cost = PIPPENGER_NWINDOWS(c) * (n + ((size_t)1<<c));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = c;
+        }
+    }
+    return best;
+}
+
+#define MSM_NCHUNKS(n) (((n) + RISTRETTO_MSM_PARALLEL_CHUNK - 1) / RISTRETTO_MSM_PARALLEL_CHUNK)
+
+/* Scratch space needed by the multiscalar algorithms for n terms.  Run in
+ * parallel, the constant-time one also keeps a partial sum per chunk, and
+ * Pippenger keeps a set of buckets and a partial sum per window.
+ */
+static size_t multiscalar_scratch_bytes(size_t n, int non_secret, int parallel) {
+    if (!non_secret) {
+        return n * (sizeof(pniels_t)<<(RISTRETTO_MSM_WINDOW_BITS-1))
+            + n * sizeof(scalar_t)
+            + (parallel ? MSM_NCHUNKS(n) * sizeof(point_t) : 0);
+    } else if (n < RISTRETTO_MSM_PIPPENGER_THRESHOLD) {
+        return n * (sizeof(pniels_t)<<RISTRETTO_WNAF_VAR_TABLE_BITS)
+            + n * WNAF_CONTROL_SIZE(RISTRETTO_WNAF_VAR_TABLE_BITS) * sizeof(struct smvt_control)
+            + n * sizeof(int);
+    } else {
+        unsigned int c = pippenger_window_bits(n);
+        size_t nwindows = parallel ? PIPPENGER_NWINDOWS(c) : 1;
+        return n * sizeof(pniels_t)
+            + nwindows * (sizeof(point_t) << (c-1))
+            + (parallel ? nwindows * sizeof(point_t) : 0)
+            + n * PIPPENGER_NWINDOWS(c) * sizeof(int16_t);
+    }
+}
+
+/* Run task(arg,0..ntasks-1) on executor, or here if it's NULL */
+static void executor_run (
+    const ristretto255_executor_t *executor,
+    void (*task)(void *arg, size_t i),
+    void *arg,
+    size_t ntasks
+) {
+    size_t i;
+    if (executor == NULL) {
+        for (i=0; i<ntasks; i++) task(arg, i);
+    } else {
+        executor->run(executor->ctx, task, arg, ntasks);
+    }
+}
+
+/* The largest of the above per term.  Pippenger only runs on batches big
+ * enough for its buckets to cost less per term than Straus's tables.
+ */
+const size_t ristretto255_multiscalar_scratch_bytes_per_term
+    = (sizeof(pniels_t)<<RISTRETTO_WNAF_VAR_TABLE_BITS)
+    + WNAF_CONTROL_SIZE(RISTRETTO_WNAF_VAR_TABLE_BITS) * sizeof(struct smvt_control)
+    + sizeof(int);
+
+/* The bases of a multiscalar multiply, either an array or a slice of a
+ * point batch.  Each is read once, while building the tables.
+ */
+struct msm_bases {
+    const point_t *pts;
+    const ristretto255_point_batch_t *batch;
+    size_t first;
+};
+
+/* Base k, unpacked into *tmp if it has to be */
+static RISTRETTO_INLINE const point_t *msm_base(point_t *tmp, const struct msm_bases *bases, size_t k) {
+    if (bases->pts) return &bases->pts[bases->first + k];
+    point_batch_get(tmp, bases->batch, bases->first + k);
+    return tmp;
+}
+
+/* Constant-time interleaved fixed-window (Straus) multiscalar multiply. */
+static void multiscalar_straus (
+    point_t *out,
+    const scalar_t *scalars,
+    const struct msm_bases *bases,
+    size_t n,
+    void *scratch
+) {
+    const int WINDOW = RISTRETTO_MSM_WINDOW_BITS,
+        NTABLE = 1<<(WINDOW-1);
+
+    pniels_t *multiples = (pniels_t *)scratch, pn;
+    scalar_t *scalarsx = (scalar_t *)&multiples[n*NTABLE];
+    point_t tmp;
+    size_t k;
+
+    for (k=0; k<n; k++) {
+        fixed_window_recode(&scalarsx[k], &scalars[k], &fixed_window_adjustment_4);
+        prepare_fixed_window(&multiples[k*NTABLE], msm_base(&tmp, bases, k), NTABLE);
+    }
+
+    int i,j,first=1;
+    i = SCALAR_BITS - ((SCALAR_BITS-1) % WINDOW) - 1;
+
+    for (; i>=0; i-=WINDOW) {
+        if (!first) {
+            for (j=0; j<WINDOW-1; j++)
+                point_double_internal(&tmp, &tmp, -1);
+            point_double_internal(&tmp, &tmp, 0);
+        }
+
+        for (k=0; k<n; k++) {
+            mask_t inv;
+            word_t idx = fixed_window_digit(&inv, &scalarsx[k], i, WINDOW);
+
+            /* Add in from table.  Compute t only on last iteration. */
+            constant_time_lookup_pniels(&pn, &multiples[k*NTABLE], NTABLE, idx);
+            cond_neg_niels(&pn.n, inv);
+            if (first) {
+                pniels_to_pt(&tmp, &pn);
+                first = 0;
+            } else {
+                add_pniels_to_pt(&tmp, &pn, (i && k==n-1) ? -1 : 0);
+            }
+        }
+    }
+
+    ristretto255_point_copy(out,&tmp);
+
+    ristretto_bzero(scratch, multiscalar_scratch_bytes(n,0,0));
+    ristretto_bzero(&pn,sizeof(pn));
+    ristretto_bzero(&tmp,sizeof(tmp));
+}
+
+/* Variable-time interleaved wNAF (Straus) multiscalar multiply. */
+static void multiscalar_straus_non_secret (
+    point_t *out,
+    const scalar_t *scalars,
+    const struct msm_bases *bases,
+    size_t n,
+    void *scratch
+) {
+    const int table_bits = RISTRETTO_WNAF_VAR_TABLE_BITS,
+        control_size = WNAF_CONTROL_SIZE(RISTRETTO_WNAF_VAR_TABLE_BITS);
+
+    pniels_t *precmp = (pniels_t *)scratch;
+    struct smvt_control *control = (struct smvt_control *)&precmp[n<<table_bits];
+    int *cont = (int *)&control[n*control_size];
+    point_t tmp;
+    size_t k, last;
+    int i = -1, first = 1;
+
+    for (k=0; k<n; k++) {
+        recode_wnaf(&control[k*control_size], &scalars[k], table_bits);
+        prepare_wnaf_table(&precmp[k<<table_bits], msm_base(&tmp, bases, k), table_bits);
+        cont[k] = 0;
+        if (control[k*control_size].power > i) i = control[k*control_size].power;
+    }
+
+    if (i < 0) {
+        ristretto255_point_copy(out, &ristretto255_point_identity);
+        return;
+    }
+
+    for (; i >= 0; i--) {
+        /* Find the last term which adds at this power, so that it alone computes t */
+        last = n;
+        for (k=0; k<n; k++) {
+            if (control[k*control_size + cont[k]].power == i) last = k;
+        }
+
+        if (!first) point_double_internal(out,out,i && last==n);
+
+        for (k=0; k<n && last<n; k++) {
+            const struct smvt_control *ctl = &control[k*control_size + cont[k]];
+            if (ctl->power != i) continue;
+            assert(ctl->addend);
+
+            const pniels_t *pn = &precmp[(k<<table_bits) + (abs(ctl->addend) >> 1)];
+            int before_double = i && k==last;
+            if (first) {
+                pniels_to_pt(out, pn);
+                if (ctl->addend < 0) ristretto255_point_negate(out, out);
+                first = 0;
+            } else if (ctl->addend > 0) {
+                add_pniels_to_pt(out, pn, before_double);
+            } else {
+                sub_pniels_from_pt(out, pn, before_double);
+            }
+            cont[k]++;
+        }
+    }
+}
+
+/* Constant-time multiscalar multiply of one chunk of terms, as a task.  Each
+ * chunk has its own slice of the scratch space and its own partial sum.
+ */
+struct straus_job {
+    const scalar_t *scalars;
+    const struct msm_bases *bases;
+    size_t n;
+    unsigned char *scratch;
+    point_t *partials;
+};
+
+static void multiscalar_straus_task(void *arg, size_t i) {
+    const struct straus_job *job = (const struct straus_job *)arg;
+    size_t begin = i*RISTRETTO_MSM_PARALLEL_CHUNK, len = job->n - begin;
+    struct msm_bases bases = *job->bases;
+    if (len > RISTRETTO_MSM_PARALLEL_CHUNK) len = RISTRETTO_MSM_PARALLEL_CHUNK;
+    bases.first += begin;
+    multiscalar_straus(&job->partials[i], &job->scalars[begin], &bases, len,
+        job->scratch + multiscalar_scratch_bytes(begin,0,0));
+}
+
+/* State shared by the Pippenger tasks.  Run serially, there is just one set
+ * of buckets and no stored partial sums.
+ */
+struct pippenger_job {
+    const scalar_t *scalars;
+    const struct msm_bases *bases;
+    size_t n;
+    unsigned int c, nwindows, nbuckets;
+    pniels_t *pn;
+    int16_t *digits;
+    point_t *buckets, *partials;
+};
+
+/* Recode one chunk of scalars into signed digits in (-2^(c-1), 2^(c-1)] */
+static void pippenger_recode_task(void *arg, size_t chunk) {
+    const struct pippenger_job *job = (const struct pippenger_job *)arg;
+    const unsigned int c = job->c, nwindows = job->nwindows;
+    size_t k, end = (chunk+1)*RISTRETTO_MSM_PARALLEL_CHUNK;
+    unsigned int w;
+    point_t tmp;
+    if (end > job->n) end = job->n;
+
+    for (k=chunk*RISTRETTO_MSM_PARALLEL_CHUNK; k<end; k++) {
+        const scalar_t *s = &job->scalars[k];
+        word_t carry = 0;
+        pt_to_pniels(&job->pn[k], msm_base(&tmp, job->bases, k));
+        for (w=0; w<nwindows; w++) {
+            unsigned int b = w*c;
+            word_t bits = 0;
+            if (b/WBITS < SCALAR_LIMBS) {
+                bits = s->limb[b/WBITS] >> (b%WBITS);
+                if (b%WBITS + c > WBITS && b/WBITS < SCALAR_LIMBS-1) {
+                    bits |= s->limb[b/WBITS+1] << (WBITS - b%WBITS);
+                }
+            }
+            bits = (bits & ((1u<<c)-1)) + carry;
+            carry = bits > job->nbuckets;
+            job->digits[k*nwindows + w] = (int16_t)((int)bits - (int)(carry<<c));
+        }
+        assert(carry == 0);
+    }
+}
+
+/* partial = sum_j (j+1)*buckets[j], where bucket j collects the bases whose
+ * digit in window i is +-(j+1).
+ */
+static void pippenger_window (
+    const struct pippenger_job *job,
+    point_t *partial,
+    point_t *buckets,
+    unsigned int i
+) {
+    const unsigned int nwindows = job->nwindows, nbuckets = job->nbuckets;
+    point_t sum;
+    unsigned int j;
+    size_t k;
+
+    for (j=0; j<nbuckets; j++) {
+        ristretto255_point_copy(&buckets[j], &ristretto255_point_identity);
+    }
+
+    for (k=0; k<job->n; k++) {
+        int d = job->digits[k*nwindows + i];
+        if (d > 0) {
+            add_pniels_to_pt(&buckets[d-1], &job->pn[k], 0);
+        } else if (d < 0) {
+            sub_pniels_from_pt(&buckets[-d-1], &job->pn[k], 0);
+        }
+    }
+
+    ristretto255_point_copy(&sum, &buckets[nbuckets-1]);
+    ristretto255_point_copy(partial, &sum);
+    for (j=nbuckets-1; j>0; j--) {
+        ristretto255_point_add(&sum, &sum, &buckets[j-1]);
+        ristretto255_point_add(partial, partial, &sum);
+    }
+}
+
+static void pippenger_window_task(void *arg, size_t i) {
+    const struct pippenger_job *job = (const struct pippenger_job *)arg;
+    pippenger_window(job, &job->partials[i], &job->buckets[i*job->nbuckets], i);
+}
+
+/* Variable-time Pippenger bucket multiscalar multiply.  With an executor,
+ * the windows are accumulated in parallel and then combined here in order,
+ * which gives exactly the same result as running them one by one.
+ */
+static void multiscalar_pippenger_non_secret (
+    point_t *out,
+    const scalar_t *scalars,
+    const struct msm_bases *bases,
+    size_t n,
+    void *scratch,
+    const ristretto255_executor_t *executor
+) {
+    struct pippenger_job job;
+    const unsigned int c = pippenger_window_bits(n),
+        nwindows = PIPPENGER_NWINDOWS(c),
+        nbuckets = 1u<<(c-1),
+        nsets = executor ? nwindows : 1;
+    point_t partial;
+    unsigned int j;
+    int i;
+
+    job.scalars = scalars;
+    job.bases = bases;
+    job.n = n;
+    job.c = c;
+    job.nwindows = nwindows;
+    job.nbuckets = nbuckets;
+    job.pn = (pniels_t *)scratch;
+    job.buckets = (point_t *)&job.pn[n];
+    job.partials = &job.buckets[nsets*nbuckets];
+    job.digits = (int16_t *)&job.partials[executor ? nwindows : 0];
+
+    executor_run(executor, pippenger_recode_task, &job, MSM_NCHUNKS(n));
+    if (executor) executor_run(executor, pippenger_window_task, &job, nwindows);
+
+    for (i=nwindows-1; i>=0; i--) {
+        if (executor) {
+            ristretto255_point_copy(&partial, &job.partials[i]);
+        } else {
+            pippenger_window(&job, &partial, job.buckets, i);
+        }
+
+        if (i == (int)nwindows-1) {
+            ristretto255_point_copy(out, &partial);
+        } else {
+            for (j=0; j<c; j++)
+                point_double_internal(out, out, j<c-1);
+            ristretto255_point_add(out, out, &partial);
+        }
+    }
+}
+
+ristretto_error_t ristretto255_multiscalar_mul_with_allocator (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) {
+    return ristretto255_multiscalar_mul_parallel(combo, scalars, bases, n, allocator, NULL);
+}
+
+ristretto_error_t ristretto255_multiscalar_mul_non_secret_with_allocator (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator
+) {
+    return ristretto255_multiscalar_mul_non_secret_parallel(combo, scalars, bases, n, allocator, NULL);
+}
+
+/* The multiplications proper, on scratch of multiscalar_scratch_bytes(n,...) */
+static void multiscalar_mul_scratch (
+    point_t *combo,
+    const scalar_t *scalars,
+    const struct msm_bases *bases,
+    size_t n,
+    void *scratch,
+    const ristretto255_executor_t *executor
+) {
+    if (executor == NULL) {
+        multiscalar_straus(combo, scalars, bases, n, scratch);
+    } else {
+        struct straus_job job;
+        size_t i, nchunks = MSM_NCHUNKS(n);
+        job.scalars = scalars;
+        job.bases = bases;
+        job.n = n;
+        job.scratch = (unsigned char *)scratch;
+        job.partials = (point_t *)(job.scratch + multiscalar_scratch_bytes(n,0,0));
+
+        executor_run(executor, multiscalar_straus_task, &job, nchunks);
+
+        ristretto255_point_copy(combo, &job.partials[0]);
+        for (i=1; i<nchunks; i++) {
+            ristretto255_point_add(combo, combo, &job.partials[i]);
+        }
+        ristretto_bzero(job.partials, nchunks*sizeof(point_t));
+    }
+}
+
+static void multiscalar_mul_non_secret_scratch (
+    point_t *combo,
+    const scalar_t *scalars,
+    const struct msm_bases *bases,
+    size_t n,
+    void *scratch,
+    const ristretto255_executor_t *executor
+) {
+    if (n < RISTRETTO_MSM_PIPPENGER_THRESHOLD) {
+        multiscalar_straus_non_secret(combo, scalars, bases, n, scratch);
+    } else {
+        multiscalar_pippenger_non_secret(combo, scalars, bases, n, scratch, executor);
+    }
+}
+
+static ristretto_error_t multiscalar_mul (
+    point_t *combo,
+    const scalar_t *scalars,
+    const struct msm_bases *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) {
+    if (n == 0) {
+        ristretto255_point_copy(combo, &ristretto255_point_identity);
+        return RISTRETTO_SUCCESS;
+    }
+
+    const size_t bytes = multiscalar_scratch_bytes(n,0,executor != NULL);
+    assert(bytes <= n*ristretto255_multiscalar_scratch_bytes_per_term);
+    void *scratch = ristretto_alloc(allocator, bytes);
+    if (scratch == NULL) return RISTRETTO_FAILURE;
+    multiscalar_mul_scratch(combo, scalars, bases, n, scratch, executor);
+    ristretto_free(allocator, scratch, bytes);
+    return RISTRETTO_SUCCESS;
+}
+
+static ristretto_error_t multiscalar_mul_non_secret (
+    point_t *combo,
+    const scalar_t *scalars,
+    const struct msm_bases *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) {
+    if (n == 0) {
+        ristretto255_point_copy(combo, &ristretto255_point_identity);
+        return RISTRETTO_SUCCESS;
+    }
+
+    const size_t bytes = multiscalar_scratch_bytes(n,1,executor != NULL);
+    assert(bytes <= n*ristretto255_multiscalar_scratch_bytes_per_term);
+    void *scratch = ristretto_alloc(allocator, bytes);
+    if (scratch == NULL) return RISTRETTO_FAILURE;
+    multiscalar_mul_non_secret_scratch(combo, scalars, bases, n, scratch, executor);
+    ristretto_free(allocator, scratch, bytes);
+    return RISTRETTO_SUCCESS;
+}
+
+/* Caller-supplied scratch is aligned here as ristretto_alloc would align it */
+#define MSM_SCRATCH_ALIGN sizeof(big_register_t)
+
+size_t ristretto255_multiscalar_scratch_size (
+    size_t n
+) {
+    /* Each mode needs most when run in parallel.  Straus takes more per term
+     * than Pippenger, so the size must also cover the largest smaller call
+     * that still runs Straus, or it would drop at the threshold.
+     */
+    const size_t straus_n = n < RISTRETTO_MSM_PIPPENGER_THRESHOLD ? n : RISTRETTO_MSM_PIPPENGER_THRESHOLD-1;
+    size_t bytes = multiscalar_scratch_bytes(n,0,1), more;
+    more = multiscalar_scratch_bytes(straus_n,1,1);
+    if (more > bytes) bytes = more;
+    more = multiscalar_scratch_bytes(n,1,1);
+    if (more > bytes) bytes = more;
+    return bytes + MSM_SCRATCH_ALIGN - 1;
+}
+
+/* The aligned start of scratch, or NULL if it is smaller than bytes */
+static void *msm_scratch_align(void *scratch, size_t scratch_bytes, size_t bytes) {
+    size_t pad = (size_t)(-(uintptr_t)scratch) & (MSM_SCRATCH_ALIGN-1);
+    if (scratch == NULL || scratch_bytes < pad || scratch_bytes - pad < bytes) return NULL;
+    return (unsigned char *)scratch + pad;
+}
+
+ristretto_error_t ristretto255_multiscalar_mul_with_scratch (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n,
+    void *scratch,
+    size_t scratch_bytes,
+    const ristretto255_executor_t *executor
+) {
+    const struct msm_bases b = { bases, NULL, 0 };
+    if (n == 0) {
+        ristretto255_point_copy(combo, &ristretto255_point_identity);
+        return RISTRETTO_SUCCESS;
+    }
+    void *aligned = msm_scratch_align(scratch, scratch_bytes, multiscalar_scratch_bytes(n,0,executor != NULL));
+    if (aligned == NULL) return RISTRETTO_FAILURE;
+    multiscalar_mul_scratch(combo, scalars, &b, n, aligned, executor);
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_multiscalar_mul_non_secret_with_scratch (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n,
+    void *scratch,
+    size_t scratch_bytes,
+    const ristretto255_executor_t *executor
+) {
+    const struct msm_bases b = { bases, NULL, 0 };
+    if (n == 0) {
+        ristretto255_point_copy(combo, &ristretto255_point_identity);
+        return RISTRETTO_SUCCESS;
+    }
+    void *aligned = msm_scratch_align(scratch, scratch_bytes, multiscalar_scratch_bytes(n,1,executor != NULL));
+    if (aligned == NULL) return RISTRETTO_FAILURE;
+    multiscalar_mul_non_secret_scratch(combo, scalars, &b, n, aligned, executor);
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_multiscalar_mul_parallel (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) {
+    const struct msm_bases b = { bases, NULL, 0 };
+    return multiscalar_mul(combo, scalars, &b, n, allocator, executor);
+}
+
+ristretto_error_t ristretto255_multiscalar_mul_non_secret_parallel (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) {
+    const struct msm_bases b = { bases, NULL, 0 };
+    return multiscalar_mul_non_secret(combo, scalars, &b, n, allocator, executor);
+}
+
+ristretto_error_t ristretto255_point_batch_multiscalar_mul (
+    point_t *combo,
+    const scalar_t *scalars,
+    const ristretto255_point_batch_t *bases,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) {
+    const struct msm_bases b = { NULL, bases, 0 };
+    return multiscalar_mul(combo, scalars, &b, bases->n, allocator, executor);
+}
+
+ristretto_error_t ristretto255_point_batch_multiscalar_mul_non_secret (
+    point_t *combo,
+    const scalar_t *scalars,
+    const ristretto255_point_batch_t *bases,
+    const ristretto255_allocator_t *allocator,
+    const ristretto255_executor_t *executor
+) {
+    const struct msm_bases b = { NULL, bases, 0 };
+    return multiscalar_mul_non_secret(combo, scalars, &b, bases->n, allocator, executor);
+}
+
+ristretto_error_t ristretto255_multiscalar_mul (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n
+) {
+    return ristretto255_multiscalar_mul_with_allocator(combo, scalars, bases, n, NULL);
+}
+
+ristretto_error_t ristretto255_multiscalar_mul_non_secret (
+    point_t *combo,
+    const scalar_t *scalars,
+    const point_t *bases,
+    size_t n
+) {
+    return ristretto255_multiscalar_mul_non_secret_with_allocator(combo, scalars, bases, n, NULL);
+}
+
+/* Fixed-base multiscalar: one comb of t teeth spaced s bits apart per
+ * generator.  Each chunk of RISTRETTO_GENERATORS_CHUNK generators shares
+ * the same s doublings, so each term costs only s additions.
+ */
+struct ristretto255_generators_s {
+    size_t n;
+    unsigned int teeth, spacing;
+    scalar_t adjustment; /* 2^(teeth*spacing) - 1 */
+    niels_t table[];
+};
+
+static size_t generators_bytes(size_t n, unsigned int teeth) {
+    return sizeof(ristretto255_generators_t) + n*(sizeof(niels_t)<<(teeth-1));
+}
+
+ristretto_error_t ristretto255_generators_create (
+    ristretto255_generators_t **gens,
+    const point_t *points,
+    size_t n,
+    unsigned int teeth,
+    const ristretto255_allocator_t *allocator
+) {
+    *gens = NULL;
+    const size_t bytes = ristretto255_sizeof_generators(n, teeth);
+    if (bytes == 0) return RISTRETTO_FAILURE;
+
+    const unsigned int per = 1u<<(teeth-1), spacing = (SCALAR_BITS + teeth - 1) / teeth,
+        batch = (RISTRETTO_GENERATORS_NORMALIZE + per - 1) / per;
+    const size_t tmp_bytes = 2 * batch * per * sizeof(gf_25519_t);
+    ristretto255_generators_t *out = ristretto_alloc(allocator, bytes);
+    gf_25519_t *zs = ristretto_alloc(allocator, tmp_bytes), *zis = &zs[batch*per];
+    if (out == NULL || zs == NULL) {
+        ristretto_free(allocator, out, bytes);
+        ristretto_free(allocator, zs, tmp_bytes);
+        return RISTRETTO_FAILURE;
+    }
+
+    /* Zero the header's padding too, so that serialized tables are reproducible */
+    memset(out, 0, sizeof(*out));
+    out->n = n;
+    out->teeth = teeth;
+    out->spacing = spacing;
+    unsigned int i;
+    out->adjustment = ristretto255_scalar_one;
+    for (i=0; i<teeth*spacing; i++) {
+        ristretto255_scalar_add(&out->adjustment, &out->adjustment, &out->adjustment);
+    }
+    ristretto255_scalar_sub(&out->adjustment, &out->adjustment, &ristretto255_scalar_one);
+
+    /* Normalize a batch of generators at a time, to share the inversions */
+    size_t j, k;
+    for (j=0; j<n; j+=batch) {
+        const size_t m = n-j < batch ? n-j : batch;
+        for (k=0; k<m; k++) {
+            comb_precompute(&out->table[(j+k)*per], &zs[k*per], &points[j+k], 1, teeth, spacing);
+        }
+        batch_normalize_niels(&out->table[j*per], zs, zis, m*per);
+    }
+
+    ristretto_bzero(zs, tmp_bytes);
+    ristretto_free(allocator, zs, tmp_bytes);
+    *gens = out;
+    return RISTRETTO_SUCCESS;
+}
+
+void ristretto255_generators_destroy (
+    ristretto255_generators_t *gens,
+    const ristretto255_allocator_t *allocator
+) {
+    if (gens == NULL) return;
+    const size_t bytes = generators_bytes(gens->n, gens->teeth);
+    ristretto_bzero(gens, bytes);
+    ristretto_free(allocator, gens, bytes);
+}
+
+size_t ristretto255_generators_count (
+    const ristretto255_generators_t *gens
+) {
+    return gens->n;
+}
+
+unsigned int ristretto255_generators_teeth (
+    const ristretto255_generators_t *gens
+) {
+    return gens->teeth;
+}
+
+size_t ristretto255_sizeof_generators (
+    size_t n,
+    unsigned int teeth
+) {
+    if (teeth < 1 || teeth > RISTRETTO255_GENERATORS_MAX_TEETH
+        || n > (SIZE_MAX/2 - sizeof(ristretto255_generators_t)) / (sizeof(niels_t)<<(teeth-1))) {
+        return 0;
+    }
+    return generators_bytes(n, teeth);
+}
+
+/* The comb's row i of a scalar that has been adjusted and halved */
+static RISTRETTO_INLINE int generators_comb_bits (
+    const scalar_t *scalar1x,
+    int i,
+    unsigned int teeth,
+    unsigned int spacing
+) {
+    int tab = 0;
+    unsigned int k;
+    for (k=0; k<teeth; k++) {
+        unsigned int bit = i + spacing*k;
+        if (bit < SCALAR_BITS) {
+            tab |= (scalar1x->limb[bit/WBITS] >> (bit%WBITS) & 1) << k;
+        }
+    }
+    return tab;
+}
+
+/* Constant-time comb multiscalar multiply of generators first..first+n-1,
+ * which share their doublings.  The generators are done in chunks, so that
+ * each chunk's tables stay in cache while its rows are added in.
+ */
+static void generators_comb (
+    point_t *out,
+    const ristretto255_generators_t *gens,
+    const scalar_t *scalars,
+    size_t first,
+    size_t n
+) {
+    const unsigned int t = gens->teeth, s = gens->spacing, per = 1u<<(t-1);
+    scalar_t scalar1x[RISTRETTO_GENERATORS_CHUNK];
+    niels_t ni;
+    size_t k;
+    int i;
+
+    assert(n >= 1 && n <= RISTRETTO_GENERATORS_CHUNK);
+    for (k=0; k<n; k++) {
+        ristretto255_scalar_add(&scalar1x[k], &scalars[first+k], &gens->adjustment);
+        ristretto255_scalar_halve(&scalar1x[k], &scalar1x[k]);
+    }
+
+    for (i=s-1; i>=0; i--) {
+        if (i != (int)s-1) point_double_internal(out,out,0);
+
+        for (k=0; k<n; k++) {
+            int tab = generators_comb_bits(&scalar1x[k], i, t, s);
+            mask_t invert = (tab>>(t-1))-1;
+            tab ^= invert;
+            tab &= per - 1;
+
+            constant_time_lookup_niels(&ni, &gens->table[(first+k)*per], per, tab);
+
+            cond_neg_niels(&ni, invert);
+            if ((i!=(int)s-1)||k) {
+                add_niels_to_pt(out, &ni, k==n-1 && i);
+            } else {
+                niels_to_pt(out, &ni);
+            }
+        }
+    }
+
+    ristretto_bzero(&ni,sizeof(ni));
+    ristretto_bzero(scalar1x,sizeof(scalar1x));
+}
+
+/* As generators_comb, but indexing the tables directly */
+static void generators_comb_non_secret (
+    point_t *out,
+    const ristretto255_generators_t *gens,
+    const scalar_t *scalars,
+    size_t first,
+    size_t n
+) {
+    const unsigned int t = gens->teeth, s = gens->spacing, per = 1u<<(t-1);
+    scalar_t scalar1x[RISTRETTO_GENERATORS_CHUNK];
+    size_t k;
+    int i;
+
+    assert(n >= 1 && n <= RISTRETTO_GENERATORS_CHUNK);
+    for (k=0; k<n; k++) {
+        ristretto255_scalar_add(&scalar1x[k], &scalars[first+k], &gens->adjustment);
+        ristretto255_scalar_halve(&scalar1x[k], &scalar1x[k]);
+    }
+
+    for (i=s-1; i>=0; i--) {
+        if (i != (int)s-1) point_double_internal(out,out,0);
+
+        for (k=0; k<n; k++) {
+            int tab = generators_comb_bits(&scalar1x[k], i, t, s);
+            int invert = !(tab>>(t-1));
+            if (invert) tab = ~tab;
+            tab &= per - 1;
+
+            const niels_t *ni = &gens->table[(first+k)*per + tab];
+            if ((i!=(int)s-1)||k) {
+                if (invert) sub_niels_from_pt(out, ni, k==n-1 && i);
+                else add_niels_to_pt(out, ni, k==n-1 && i);
+            } else {
+                niels_to_pt(out, ni);
+                if (invert) ristretto255_point_negate(out, out);
+            }
+        }
+    }
+}
+
+static ristretto_error_t generators_mul (
+    point_t *combo,
+    const ristretto255_generators_t *gens,
+    const scalar_t *scalars,
+    size_t n,
+    void (*comb)(point_t *, const ristretto255_generators_t *, const scalar_t *, size_t, size_t)
+) {
+    if (n > gens->n) return RISTRETTO_FAILURE;
+
+    point_t tmp, sum;
+    size_t j;
+    ristretto255_point_copy(&sum, &ristretto255_point_identity);
+    for (j=0; j<n; j+=RISTRETTO_GENERATORS_CHUNK) {
+        comb(&tmp, gens, scalars, j, n-j < RISTRETTO_GENERATORS_CHUNK ? n-j : RISTRETTO_GENERATORS_CHUNK);
+        ristretto255_point_add(&sum, &sum, &tmp);
+    }
+    ristretto255_point_copy(combo, &sum);
+
+    ristretto_bzero(&tmp,sizeof(tmp));
+    ristretto_bzero(&sum,sizeof(sum));
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_generators_mul (
+    point_t *combo,
+    const ristretto255_generators_t *gens,
+    const scalar_t *scalars,
+    size_t n
+) {
+    return generators_mul(combo, gens, scalars, n, generators_comb);
+}
+
+ristretto_error_t ristretto255_generators_mul_non_secret (
+    point_t *combo,
+    const ristretto255_generators_t *gens,
+    const scalar_t *scalars,
+    size_t n
+) {
+    return generators_mul(combo, gens, scalars, n, generators_comb_non_secret);
+}
+
 void ristretto255_point_destroy (
     point_t *point
 ) {
@@ -1155,3 +3147,12 @@ void ristretto255_precomputed_destroy (
 ) {
     ristretto_bzero(pre, ristretto255_sizeof_precomputed_s);
 }
+
+void ristretto255_precomputed_free (
+    precomputed_s *pre,
+    const ristretto255_allocator_t *allocator
+) {
+    if (pre == NULL) return;
+    ristretto255_precomputed_destroy(pre);
+    ristretto_free(allocator, pre, sizeof(precomputed_s));
+}
@@ -0,0 +1,445 @@
+/**
+ * @file ristretto_bench.c
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ *
+ * @brief Benchmarks of the field, scalar and point operations, printed as JSON.
+ *
+ * Usage: ristretto_bench [--check] [filter...].  With filters, only the
+ * benchmarks whose names contain one of them are run.  Each benchmark is
+ * repeated until it takes BENCH_MIN_SECONDS, and the best of BENCH_REPS
+ * runs of that many iterations is reported.  On x86 the cycle counts come
+ * from the TSC, so they are reference cycles and drift with turbo;
+ * elsewhere they are left out.  Builds with COUNTERS=1 also report the
+ * field and point operations each benchmark does.
+ *
+ * With --check, digests of each operation's outputs are printed instead,
+ * for comparing builds with each other.
+ */
+
+#define _XOPEN_SOURCE 600 /* for posix_memalign and clock_gettime */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ristretto255.h>
+#include <ristretto255_hash.h>
+#include "field.h"
+#include "f_field.h"
+
+#ifndef RISTRETTO_BENCH_ARCH
+#define RISTRETTO_BENCH_ARCH "unknown"
+#endif
+
+#define BENCH_MIN_SECONDS 0.02
+#define BENCH_REPS 5
+#define BENCH_MSM_TERMS 64
+#define BENCH_MESSAGE_BYTES 4096
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_HAS_CYCLES 1
+static uint64_t bench_cycles(void) {
+    uint32_t lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+#else
+#define BENCH_HAS_CYCLES 0
+static uint64_t bench_cycles(void) { return 0; }
+#endif
+
+static double bench_now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static int bench_argc, bench_first = 1;
+static char **bench_argv;
+static volatile int bench_sink;
+
+static int bench_selected(const char *name) {
+    int i;
+    if (bench_argc <= 1) return 1;
+    for (i=1; i<bench_argc; i++) {
+        if (strstr(name, bench_argv[i])) return 1;
+    }
+    return 0;
+}
+
+static void bench_report (
+    const char *name,
+    unsigned long iters,
+    double secs,
+    uint64_t cycles,
+    const ristretto255_counters_t *counts
+) {
+    printf("%s\n    {\"name\": \"%s\", \"iters\": %lu, \"ns_per_op\": %.1f, \"ops_per_sec\": %.0f",
+        bench_first ? "" : ",", name, iters, secs * 1e9 / iters, iters / secs);
+    if (BENCH_HAS_CYCLES) printf(", \"cycles_per_op\": %.0f", (double)cycles / iters);
+    if (counts) {
+        printf(", \"counts\": {\"gf_mul\": %llu, \"gf_sqr\": %llu, \"gf_isr\": %llu, "
+            "\"point_add\": %llu, \"point_double\": %llu}",
+            (unsigned long long)counts->gf_mul, (unsigned long long)counts->gf_sqr,
+            (unsigned long long)counts->gf_isr, (unsigned long long)counts->point_add,
+            (unsigned long long)counts->point_double);
+    }
+    printf("}");
+    fflush(stdout);
+    bench_first = 0;
+}
+
+/* Time code.  It should feed its result back into its input where it can,
+ * so that the latency is measured rather than the throughput.  In a build
+ * with COUNTERS=1, one more run is made to count its operations.
+ */
+#define BENCH(name, code) do { \
+    if (!bench_selected(name)) break; \
+    unsigned long iters_ = 1, i_; \
+    double t_, best_; \
+    uint64_t c_, bestc_ = UINT64_MAX; \
+    ristretto255_counters_t counts_; \
+    int r_; \
+    for (;;) { \
+        t_ = bench_now(); \
+        for (i_=0; i_<iters_; i_++) { code; } \
+        t_ = bench_now() - t_; \
+        if (t_ >= BENCH_MIN_SECONDS || iters_ >= 1ul<<30) break; \
+        iters_ *= 2; \
+    } \
+    best_ = t_; \
+    for (r_=0; r_<BENCH_REPS; r_++) { \
+        c_ = bench_cycles(); \
+        t_ = bench_now(); \
+        for (i_=0; i_<iters_; i_++) { code; } \
+        t_ = bench_now() - t_; \
+        c_ = bench_cycles() - c_; \
+        if (t_ < best_) best_ = t_; \
+        if (c_ < bestc_) bestc_ = c_; \
+    } \
+    ristretto255_counters_reset(); \
+    { code; } \
+    bench_report(name, iters_, best_, bestc_, \
+        ristretto255_counters_get(&counts_) == RISTRETTO_SUCCESS ? &counts_ : NULL); \
+} while (0)
+
+/* xorshift64*, so that runs are repeatable */
+static uint64_t bench_state = 0x9e3779b97f4a7c15ull;
+static void bench_random(unsigned char *out, size_t len) {
+    size_t i;
+    for (i=0; i<len; i++) {
+        bench_state ^= bench_state >> 12;
+        bench_state ^= bench_state << 25;
+        bench_state ^= bench_state >> 27;
+        out[i] = (bench_state * 0x2545f4914f6cdd1dull) >> 56;
+    }
+}
+
+static void bench_scalar(ristretto255_scalar_t *s) {
+    unsigned char ser[64];
+    bench_random(ser, sizeof(ser));
+    ristretto255_scalar_decode_long(s, ser, sizeof(ser));
+}
+
+static void bench_field(void) {
+    gf_25519_t a, b, c;
+    unsigned char ser[SER_BYTES];
+
+    bench_random(ser, sizeof(ser));
+    ignore_result(gf_deserialize(&a, ser, 1, 0));
+    bench_random(ser, sizeof(ser));
+    ignore_result(gf_deserialize(&b, ser, 1, 0));
+
+    BENCH("gf_mul", gf_mul(&c, &a, &b); gf_copy(&a, &c));
+    BENCH("gf_sqr", gf_sqr(&c, &a); gf_copy(&a, &c));
+    BENCH("gf_isr", bench_sink ^= (int)gf_isr(&c, &a); gf_copy(&a, &c));
+}
+
+static void bench_scalars(void) {
+    ristretto255_scalar_t a, b, c, many[BENCH_MSM_TERMS], inverses[BENCH_MSM_TERMS];
+    unsigned char ser[RISTRETTO255_SCALAR_BYTES], wide[64];
+    unsigned int i;
+
+    bench_scalar(&a);
+    bench_scalar(&b);
+    bench_scalar(&c);
+    for (i=0; i<BENCH_MSM_TERMS; i++) bench_scalar(&many[i]);
+    bench_random(wide, sizeof(wide));
+
+    BENCH("scalar_add", ristretto255_scalar_add(&a, &a, &b));
+    BENCH("scalar_sub", ristretto255_scalar_sub(&a, &a, &b));
+    BENCH("scalar_mul", ristretto255_scalar_mul(&a, &a, &b));
+    BENCH("scalar_muladd", ristretto255_scalar_muladd(&a, &a, &b, &c));
+    BENCH("scalar_halve", ristretto255_scalar_halve(&a, &a));
+    BENCH("scalar_invert", bench_sink ^= (int)ristretto255_scalar_invert(&a, &a));
+    BENCH("scalar_batch_invert_64",
+        bench_sink ^= (int)ristretto255_scalar_batch_invert(inverses, many, BENCH_MSM_TERMS));
+    BENCH("scalar_encode", ristretto255_scalar_encode(ser, &a));
+    BENCH("scalar_decode", bench_sink ^= (int)ristretto255_scalar_decode(&a, ser));
+    BENCH("scalar_decode_long", ristretto255_scalar_decode_long(&a, wide, sizeof(wide)));
+}
+
+static void bench_points(void) {
+    ristretto255_point_t p, q, r, many[BENCH_MSM_TERMS];
+    ristretto255_scalar_t a, b, scalars[BENCH_MSM_TERMS];
+    ristretto255_precomputed_s *pre = NULL;
+    ristretto255_wnaf_precomputed_t *wnaf = NULL;
+    ristretto255_generators_t *gens = NULL, *gens_vt = NULL;
+    ristretto255_point_batch_t *batch = NULL;
+    const size_t msm_scratch_bytes = ristretto255_multiscalar_scratch_size(BENCH_MSM_TERMS);
+    void *msm_scratch = malloc(msm_scratch_bytes);
+    unsigned char ser[RISTRETTO255_SER_BYTES], ser2[RISTRETTO255_SER_BYTES],
+        hash[RISTRETTO255_HASH_BYTES], hash2[2*RISTRETTO255_HASH_BYTES],
+        message[BENCH_MESSAGE_BYTES];
+    ristretto255_hash_to_point_ctx_t h2p;
+    unsigned int i;
+
+    bench_scalar(&a);
+    bench_scalar(&b);
+    ristretto255_precomputed_scalarmul(&p, ristretto255_precomputed_base, &a);
+    ristretto255_precomputed_scalarmul(&q, ristretto255_precomputed_base, &b);
+    for (i=0; i<BENCH_MSM_TERMS; i++) {
+        bench_scalar(&scalars[i]);
+        ristretto255_point_add(&many[i], i ? &many[i-1] : &p, &q);
+    }
+    ristretto255_point_encode(ser, &p);
+    bench_random(hash, sizeof(hash));
+    bench_random(hash2, sizeof(hash2));
+    bench_random(message, sizeof(message));
+
+    if (ristretto255_precomputed_create(&pre, &p, NULL) != RISTRETTO_SUCCESS
+        || ristretto255_wnaf_precomputed_create(&wnaf, &q, 5, NULL) != RISTRETTO_SUCCESS
+        || ristretto255_generators_create(&gens, many, BENCH_MSM_TERMS, 5, NULL) != RISTRETTO_SUCCESS
+        || ristretto255_generators_create(&gens_vt, many, BENCH_MSM_TERMS, 8, NULL) != RISTRETTO_SUCCESS
+        || ristretto255_point_batch_create(&batch, BENCH_MSM_TERMS, NULL) != RISTRETTO_SUCCESS
+        || ristretto255_point_batch_pack(batch, 0, many, BENCH_MSM_TERMS) != RISTRETTO_SUCCESS
+        || msm_scratch == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    BENCH("point_add", ristretto255_point_add(&p, &p, &q));
+    BENCH("point_double", ristretto255_point_double(&p, &p));
+    BENCH("point_eq", bench_sink ^= (int)ristretto255_point_eq(&p, &q));
+    BENCH("point_encode", ristretto255_point_encode(ser2, &p));
+    BENCH("point_decode", bench_sink ^= (int)ristretto255_point_decode(&r, ser, RISTRETTO_FALSE));
+    BENCH("point_scalarmul", ristretto255_point_scalarmul(&p, &p, &a));
+    BENCH("direct_scalarmul",
+        bench_sink ^= (int)ristretto255_direct_scalarmul(ser2, ser, &a, RISTRETTO_FALSE, RISTRETTO_TRUE));
+    BENCH("point_double_scalarmul", ristretto255_point_double_scalarmul(&p, &p, &a, &q, &b));
+    BENCH("point_dual_scalarmul", ristretto255_point_dual_scalarmul(&p, &r, &p, &a, &b));
+    BENCH("precompute", ristretto255_precompute(pre, &p));
+    BENCH("precomputed_scalarmul", ristretto255_precomputed_scalarmul(&p, pre, &a));
+    BENCH("precomputed_scalarmul_base", ristretto255_precomputed_scalarmul(&p, ristretto255_precomputed_base, &a));
+    BENCH("precomputed_scalarmul_non_secret",
+        ristretto255_precomputed_scalarmul_non_secret(&p, ristretto255_precomputed_base, &a));
+    BENCH("base_double_scalarmul_non_secret", ristretto255_base_double_scalarmul_non_secret(&p, &a, &p, &b));
+    BENCH("wnaf_precompute_5", bench_sink ^= (int)ristretto255_wnaf_precompute(wnaf, &q, 5, NULL));
+    BENCH("base_double_scalarmul_non_secret_precomputed",
+        ristretto255_base_double_scalarmul_non_secret_precomputed(&p, &a, wnaf, &b));
+    BENCH("multiscalar_mul_64",
+        bench_sink ^= (int)ristretto255_multiscalar_mul(&p, scalars, many, BENCH_MSM_TERMS));
+    BENCH("multiscalar_mul_non_secret_64",
+        bench_sink ^= (int)ristretto255_multiscalar_mul_non_secret(&p, scalars, many, BENCH_MSM_TERMS));
+    BENCH("multiscalar_mul_scratch_64",
+        bench_sink ^= (int)ristretto255_multiscalar_mul_with_scratch(&p, scalars, many, BENCH_MSM_TERMS,
+            msm_scratch, msm_scratch_bytes, NULL));
+    BENCH("multiscalar_mul_non_secret_scratch_64",
+        bench_sink ^= (int)ristretto255_multiscalar_mul_non_secret_with_scratch(&p, scalars, many, BENCH_MSM_TERMS,
+            msm_scratch, msm_scratch_bytes, NULL));
+    BENCH("generators_mul_64",
+        bench_sink ^= (int)ristretto255_generators_mul(&p, gens, scalars, BENCH_MSM_TERMS));
+    BENCH("generators_mul_non_secret_64",
+        bench_sink ^= (int)ristretto255_generators_mul_non_secret(&p, gens_vt, scalars, BENCH_MSM_TERMS));
+    BENCH("point_batch_add_64", bench_sink ^= (int)ristretto255_point_batch_add(batch, batch, batch));
+    BENCH("point_batch_scalarmul_64",
+        bench_sink ^= (int)ristretto255_point_batch_scalarmul(batch, batch, scalars));
+    BENCH("point_batch_multiscalar_mul_64",
+        bench_sink ^= (int)ristretto255_point_batch_multiscalar_mul(&p, scalars, batch, NULL, NULL));
+    BENCH("point_from_hash_nonuniform", ristretto255_point_from_hash_nonuniform(&p, hash); hash[0]++);
+    BENCH("point_from_hash_uniform", ristretto255_point_from_hash_uniform(&p, hash2); hash2[0]++);
+    BENCH("hash_to_point_4k",
+        ristretto255_hash_to_point_init(&h2p, NULL);
+        ristretto255_hash_to_point_update(&h2p, message, sizeof(message));
+        ristretto255_hash_to_point_final(&h2p, &p));
+    BENCH("invert_elligator_nonuniform",
+        bench_sink ^= (int)ristretto255_invert_elligator_nonuniform(hash, &q, (uint32_t)bench_sink));
+
+    free(msm_scratch);
+    ristretto255_point_batch_destroy(batch, NULL);
+    ristretto255_generators_destroy(gens_vt, NULL);
+    ristretto255_generators_destroy(gens, NULL);
+    ristretto255_wnaf_precomputed_destroy(wnaf, NULL);
+    ristretto255_precomputed_free(pre, NULL);
+}
+
+/* Correctness check for make bench-matrix.  Each operation runs on
+ * BENCH_CHECK_ROUNDS repeatable random inputs, and a digest of its outputs
+ * is printed, so any two builds should print exactly the same lines.
+ */
+#define BENCH_CHECK_ROUNDS 32
+#define BENCH_CHECK_BATCH 13
+#define BENCH_CHECK_PIPPENGER_TERMS 200
+
+static ristretto255_sha512_ctx_t check_ctx;
+
+static void check_bytes(const void *data, size_t len) {
+    ristretto255_sha512_update(&check_ctx, (const unsigned char *)data, len);
+}
+
+static void check_point(const ristretto255_point_t *p) {
+    unsigned char ser[RISTRETTO255_SER_BYTES];
+    ristretto255_point_encode(ser, p);
+    check_bytes(ser, sizeof(ser));
+}
+
+static void check_field(const gf_25519_t *x) {
+    unsigned char ser[SER_BYTES];
+    gf_serialize(ser, x, 1);
+    check_bytes(ser, sizeof(ser));
+}
+
+static void check_mask(mask_t m) {
+    unsigned char ok = m != 0;
+    check_bytes(&ok, 1);
+}
+
+static void check_error(ristretto_error_t ret) {
+    check_mask(ret == RISTRETTO_SUCCESS);
+}
+
+static void check_random_point(ristretto255_point_t *p) {
+    unsigned char hash[2*RISTRETTO255_HASH_BYTES];
+    bench_random(hash, sizeof(hash));
+    ristretto255_point_from_hash_uniform(p, hash);
+}
+
+static void check_report(const char *name) {
+    unsigned char digest[RISTRETTO255_SHA512_BYTES];
+    unsigned int i;
+    ristretto255_sha512_final(&check_ctx, digest);
+    printf("%s ", name);
+    for (i=0; i<16; i++) printf("%02x", digest[i]);
+    printf("\n");
+}
+
+#define CHECK(name, code) do { \
+    unsigned int round_; \
+    if (!bench_selected(name)) break; \
+    ristretto255_sha512_init(&check_ctx); \
+    for (round_=0; round_<BENCH_CHECK_ROUNDS; round_++) { code; } \
+    check_report(name); \
+} while (0)
+
+static void bench_check(void) {
+    static ristretto255_point_t many[BENCH_CHECK_PIPPENGER_TERMS];
+    static ristretto255_scalar_t scalars[BENCH_CHECK_PIPPENGER_TERMS];
+    ristretto255_point_t p, q, r;
+    ristretto255_scalar_t a, b;
+    ristretto255_point_batch_t *batch = NULL;
+    ristretto255_generators_t *gens = NULL;
+    ristretto255_hash_to_point_ctx_t h2p;
+    gf_25519_t x, y, z;
+    ristretto_error_t ret, results[BENCH_CHECK_BATCH];
+    unsigned char ser[RISTRETTO255_SER_BYTES], sers[BENCH_CHECK_BATCH][RISTRETTO255_SER_BYTES],
+        hash[RISTRETTO255_HASH_BYTES], hashes[BENCH_CHECK_BATCH][2*RISTRETTO255_HASH_BYTES],
+        message[BENCH_MESSAGE_BYTES];
+    unsigned int i;
+
+    CHECK("gf_mul",
+        bench_random(ser, sizeof(ser)); ignore_result(gf_deserialize(&x, ser, 1, 0));
+        bench_random(ser, sizeof(ser)); ignore_result(gf_deserialize(&y, ser, 1, 0));
+        gf_mul(&z, &x, &y); check_field(&z));
+    CHECK("gf_isr",
+        bench_random(ser, sizeof(ser)); ignore_result(gf_deserialize(&x, ser, 1, 0));
+        check_mask(gf_isr(&z, &x)); check_field(&z));
+    CHECK("point_add", check_random_point(&p); check_random_point(&q);
+        ristretto255_point_add(&r, &p, &q); check_point(&r));
+    CHECK("point_double", check_random_point(&p); ristretto255_point_double(&r, &p); check_point(&r));
+    CHECK("point_decode",
+        bench_random(ser, sizeof(ser)); ser[0] &= 0xfe; ser[31] &= 0x7f;
+        ret = ristretto255_point_decode(&p, ser, RISTRETTO_FALSE);
+        check_error(ret);
+        if (ret == RISTRETTO_SUCCESS) check_point(&p));
+    CHECK("point_scalarmul", check_random_point(&p); bench_scalar(&a);
+        ristretto255_point_scalarmul(&r, &p, &a); check_point(&r));
+    CHECK("point_double_scalarmul", check_random_point(&p); check_random_point(&q);
+        bench_scalar(&a); bench_scalar(&b);
+        ristretto255_point_double_scalarmul(&r, &p, &a, &q, &b); check_point(&r));
+    CHECK("point_dual_scalarmul", check_random_point(&p); bench_scalar(&a); bench_scalar(&b);
+        ristretto255_point_dual_scalarmul(&q, &r, &p, &a, &b); check_point(&q); check_point(&r));
+    CHECK("precomputed_scalarmul_base", bench_scalar(&a);
+        ristretto255_precomputed_scalarmul(&r, ristretto255_precomputed_base, &a); check_point(&r));
+    CHECK("base_double_scalarmul_non_secret", check_random_point(&p); bench_scalar(&a); bench_scalar(&b);
+        ristretto255_base_double_scalarmul_non_secret(&r, &a, &p, &b); check_point(&r));
+    CHECK("multiscalar_mul_64",
+        for (i=0; i<BENCH_MSM_TERMS; i++) { check_random_point(&many[i]); bench_scalar(&scalars[i]); }
+        check_error(ristretto255_multiscalar_mul(&r, scalars, many, BENCH_MSM_TERMS)); check_point(&r);
+        check_error(ristretto255_multiscalar_mul_non_secret(&r, scalars, many, BENCH_MSM_TERMS)); check_point(&r));
+    CHECK("multiscalar_mul_non_secret_pippenger",
+        for (i=0; i<BENCH_CHECK_PIPPENGER_TERMS; i++) { check_random_point(&many[i]); bench_scalar(&scalars[i]); }
+        check_error(ristretto255_multiscalar_mul_non_secret(&r, scalars, many, BENCH_CHECK_PIPPENGER_TERMS));
+        check_point(&r));
+    CHECK("generators_mul_64",
+        for (i=0; i<BENCH_MSM_TERMS; i++) { check_random_point(&many[i]); bench_scalar(&scalars[i]); }
+        if (ristretto255_generators_create(&gens, many, BENCH_MSM_TERMS, 5, NULL) == RISTRETTO_SUCCESS) {
+            check_error(ristretto255_generators_mul(&r, gens, scalars, BENCH_MSM_TERMS)); check_point(&r);
+            ristretto255_generators_destroy(gens, NULL);
+        });
+    CHECK("point_encode_decode_batch",
+        for (i=0; i<BENCH_CHECK_BATCH; i++) check_random_point(&many[i]);
+        ristretto255_point_encode_batch(sers, many, BENCH_CHECK_BATCH); check_bytes(sers, sizeof(sers));
+        sers[round_ % BENCH_CHECK_BATCH][0] ^= 1;
+        check_error(ristretto255_point_decode_batch(many, results, sers[0], BENCH_CHECK_BATCH, RISTRETTO_FALSE));
+        for (i=0; i<BENCH_CHECK_BATCH; i++) {
+            check_error(results[i]);
+            if (results[i] == RISTRETTO_SUCCESS) check_point(&many[i]);
+        });
+    CHECK("point_from_hash_nonuniform", bench_random(hash, sizeof(hash));
+        ristretto255_point_from_hash_nonuniform(&r, hash); check_point(&r));
+    CHECK("point_from_hash_uniform_batch", bench_random(hashes[0], sizeof(hashes));
+        ristretto255_point_from_hash_uniform_batch(many, hashes[0], BENCH_CHECK_BATCH);
+        for (i=0; i<BENCH_CHECK_BATCH; i++) check_point(&many[i]));
+    CHECK("point_batch_scalarmul",
+        for (i=0; i<BENCH_CHECK_BATCH; i++) { check_random_point(&many[i]); bench_scalar(&scalars[i]); }
+        if (ristretto255_point_batch_create(&batch, BENCH_CHECK_BATCH, NULL) == RISTRETTO_SUCCESS) {
+            check_error(ristretto255_point_batch_pack(batch, 0, many, BENCH_CHECK_BATCH));
+            check_error(ristretto255_point_batch_scalarmul(batch, batch, scalars));
+            check_error(ristretto255_point_batch_unpack(many, batch, 0, BENCH_CHECK_BATCH));
+            for (i=0; i<BENCH_CHECK_BATCH; i++) check_point(&many[i]);
+            ristretto255_point_batch_destroy(batch, NULL);
+        });
+    CHECK("hash_to_point",
+        bench_random(message, sizeof(message));
+        ristretto255_hash_to_point_init(&h2p, NULL);
+        ristretto255_hash_to_point_update(&h2p, message, round_ * (BENCH_MESSAGE_BYTES/BENCH_CHECK_ROUNDS));
+        ristretto255_hash_to_point_final(&h2p, &r); check_point(&r));
+    CHECK("invert_elligator_nonuniform", check_random_point(&p);
+        for (i=0; i<8; i++) {
+            ret = ristretto255_invert_elligator_nonuniform(hash, &p, i);
+            check_error(ret);
+            if (ret == RISTRETTO_SUCCESS) check_bytes(hash, sizeof(hash));
+        });
+}
+
+int main(int argc, char **argv) {
+    bench_argc = argc;
+    bench_argv = argv;
+
+    if (argc > 1 && !strcmp(argv[1], "--check")) {
+        bench_argc--;
+        bench_argv++;
+        bench_check();
+        return 0;
+    }
+
+    printf("{\n  \"arch\": \"%s\",\n  \"cycles\": %s,\n  \"results\": [",
+        RISTRETTO_BENCH_ARCH, BENCH_HAS_CYCLES ? "\"tsc\"" : "null");
+    bench_field();
+    bench_scalars();
+    bench_points();
+    printf("\n  ]\n}\n");
+    return 0;
+}
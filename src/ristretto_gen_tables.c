@@ -25,6 +25,9 @@ static const unsigned char base_point_ser_for_pregen[SER_BYTES] = {
 const gf_25519_t ristretto255_precomputed_base_as_fe[1];
 const ristretto255_point_t ristretto255_point_base;
 
+const ristretto255_scalar_t ristretto255_precomputed_scalarmul_adjustment;
+extern const unsigned int ristretto255_comb_bits;
+
 struct niels_s;
 const gf_25519_t *ristretto255_precomputed_wnaf_as_fe;
 extern const size_t ristretto255_sizeof_precomputed_wnafs;
@@ -55,6 +58,19 @@ static void field_print(const gf_25519_t *f) {
     assert(b<8);
 }
 
+static void scalar_print(const ristretto255_scalar_t *sc) {
+    unsigned char ser[RISTRETTO255_SCALAR_BYTES];
+    int i, j;
+    ristretto255_scalar_encode(ser,sc);
+    printf("{{");
+    for (i=0; i<RISTRETTO255_SCALAR_BYTES; i+=8) {
+        unsigned long long limb = 0;
+        for (j=7; j>=0; j--) limb = limb<<8 | ser[i+j];
+        printf("%sSC_LIMB(0x%016llx)", i ? ", " : " ", limb);
+    }
+    printf(" }}");
+}
+
 int main(int argc, char **argv) {
     (void)argc; (void)argv;
 
@@ -81,8 +97,15 @@ int main(int argc, char **argv) {
     }
     ristretto255_precompute_wnafs(pre_wnaf, &real_point_base);
 
-    const gf_25519_t *output;
+    /* The comb reads each bit b of (scalar+adj)/2 as the digit 2b-1 */
+    ristretto255_scalar_t adj = ristretto255_scalar_one;
     unsigned i;
+    for (i=0; i<ristretto255_comb_bits; i++) {
+        ristretto255_scalar_add(&adj,&adj,&adj);
+    }
+    ristretto255_scalar_sub(&adj,&adj,&ristretto255_scalar_one);
+
+    const gf_25519_t *output;
 
     printf("/** @warning: this file was automatically generated. */\n");
     printf("#include \"field.h\"\n\n");
@@ -97,6 +120,10 @@ int main(int argc, char **argv) {
     }
     printf("\n};\n");
 
+    printf("const ristretto255_scalar_t ristretto255_precomputed_scalarmul_adjustment = ");
+    scalar_print(&adj);
+    printf(";\n");
+
     output = (const gf_25519_t *)pre;
     printf("const gf_25519_t ristretto255_precomputed_base_as_fe[%d]\n",
         (int)(ristretto255_sizeof_precomputed_s / sizeof(gf_25519_t)));
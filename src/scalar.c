@@ -55,15 +55,25 @@ static RISTRETTO_NOINLINE void sc_subx(
     }
 }
 
-static RISTRETTO_NOINLINE void sc_montmul (
+#if ARCH_HAS_SC_IMPL
+#include "sc_impl.h"
+#endif
+
+#if !SC_HAS_ARCH_MONTMUL
+/* out = (a*b + c)/R: starting the accumulator at c adds it for free */
+static RISTRETTO_NOINLINE void sc_montmuladd (
     scalar_t *out,
     const scalar_t *a,
-    const scalar_t *b
+    const scalar_t *b,
+    const scalar_t *c
 ) {
     unsigned int i,j;
-    ristretto_word_t accum[SCALAR_LIMBS+1] = {0};
+    ristretto_word_t accum[SCALAR_LIMBS+1];
     ristretto_word_t hi_carry = 0;
 
+    for (i=0; i<SCALAR_LIMBS; i++) accum[i] = c->limb[i];
+    accum[SCALAR_LIMBS] = 0;
+
     for (i=0; i<SCALAR_LIMBS; i++) {
         ristretto_word_t mand = a->limb[i];
         const ristretto_word_t *mier = b->limb;
@@ -93,6 +103,23 @@ static RISTRETTO_NOINLINE void sc_montmul (
     sc_subx(out, accum, &sc_p, &sc_p, hi_carry);
 }
 
+static RISTRETTO_INLINE void sc_montmul (
+    scalar_t *out,
+    const scalar_t *a,
+    const scalar_t *b
+) {
+    sc_montmuladd(out,a,b,&ristretto255_scalar_zero);
+}
+
+/* A separate squaring loop saves multiplies but not time in portable C:
+ * the extra passes to double and reduce cost more than the cross products.
+ * Targets with a squaring kernel provide their own in sc_impl.h.
+ */
+static RISTRETTO_INLINE void sc_montsqr (scalar_t *out, const scalar_t *a) {
+    sc_montmul(out,a,a);
+}
+#endif /* !SC_HAS_ARCH_MONTMUL */
+
 void ristretto255_scalar_mul (
     scalar_t *out,
     const scalar_t *a,
@@ -102,9 +129,61 @@ void ristretto255_scalar_mul (
     sc_montmul(out,out,&sc_r2);
 }
 
-/* PERF: could implement this */
-static RISTRETTO_INLINE void sc_montsqr (scalar_t *out, const scalar_t *a) {
-    sc_montmul(out,a,a);
+void ristretto255_scalar_muladd (
+    scalar_t *out,
+    const scalar_t *a,
+    const scalar_t *b,
+    const scalar_t *c
+) {
+    sc_montmuladd(out,a,b,c);
+    sc_montmul(out,out,&sc_r2);
+}
+
+/* The Montgomery type has the same layout, and only ever meets sc_montmul
+ * and the linear operations, which don't care about the extra factor of R.
+ */
+#define MONT_AS_SCALAR(x) ((scalar_t *)(x))
+#define MONT_AS_CONST_SCALAR(x) ((const scalar_t *)(x))
+
+void ristretto255_scalar_to_montgomery (
+    ristretto255_scalar_mont_t *out,
+    const scalar_t *a
+) {
+    sc_montmul(MONT_AS_SCALAR(out),a,&sc_r2);
+}
+
+void ristretto255_scalar_from_montgomery (
+    scalar_t *out,
+    const ristretto255_scalar_mont_t *a
+) {
+    sc_montmul(out,MONT_AS_CONST_SCALAR(a),&ristretto255_scalar_one);
+}
+
+void ristretto255_scalar_mont_mul (
+    ristretto255_scalar_mont_t *out,
+    const ristretto255_scalar_mont_t *a,
+    const ristretto255_scalar_mont_t *b
+) {
+    sc_montmul(MONT_AS_SCALAR(out),MONT_AS_CONST_SCALAR(a),MONT_AS_CONST_SCALAR(b));
+}
+
+void ristretto255_scalar_mont_sqr (
+    ristretto255_scalar_mont_t *out,
+    const ristretto255_scalar_mont_t *a
+) {
+    sc_montsqr(MONT_AS_SCALAR(out),MONT_AS_CONST_SCALAR(a));
+}
+
+void ristretto255_scalar_mont_muladd (
+    ristretto255_scalar_mont_t *out,
+    const ristretto255_scalar_mont_t *a,
+    const ristretto255_scalar_mont_t *b,
+    const ristretto255_scalar_mont_t *c
+) {
+    scalar_t t;
+    sc_montmul(&t,MONT_AS_CONST_SCALAR(a),MONT_AS_CONST_SCALAR(b));
+    ristretto255_scalar_add(MONT_AS_SCALAR(out),&t,MONT_AS_CONST_SCALAR(c));
+    ristretto255_scalar_destroy(&t);
 }
 
 ristretto_error_t ristretto255_scalar_invert (
@@ -167,6 +246,48 @@ ristretto_error_t ristretto255_scalar_invert (
     return ristretto_succeed_if(~ristretto255_scalar_eq(out,&ristretto255_scalar_zero));
 }
 
+ristretto_error_t ristretto255_scalar_batch_invert (
+    scalar_t *__restrict__ out,
+    const scalar_t *__restrict__ a,
+    size_t n
+) {
+    /* sc_montmul divides by R each time, so the prefix products are
+     * out[i] = a[0]...a[i] / R^i.  The true inverse of the last one is then
+     * R^(n-1) / a[0]...a[n-1], and conveniently each step back through the
+     * list removes one factor of R along with a[i].  Zeros are replaced with
+     * one so that they don't poison the others.
+     */
+    if (n == 0) return RISTRETTO_SUCCESS;
+
+    scalar_t inv, tmp;
+    mask_t any_zero = 0;
+    size_t i;
+
+    for (i=0; i<n; i++) {
+        mask_t zero = bool_to_mask(ristretto255_scalar_eq(&a[i],&ristretto255_scalar_zero));
+        any_zero |= zero;
+        ristretto255_scalar_cond_sel(&tmp,&a[i],&ristretto255_scalar_one,mask_to_bool(zero));
+        if (i == 0) ristretto255_scalar_copy(&out[0],&tmp);
+        else sc_montmul(&out[i],&out[i-1],&tmp);
+    }
+
+    ignore_result(ristretto255_scalar_invert(&inv,&out[n-1]));
+
+    for (i=n-1; i>0; i--) {
+        mask_t zero = bool_to_mask(ristretto255_scalar_eq(&a[i],&ristretto255_scalar_zero));
+        ristretto255_scalar_cond_sel(&tmp,&a[i],&ristretto255_scalar_one,mask_to_bool(zero));
+        sc_montmul(&out[i],&inv,&out[i-1]);
+        sc_montmul(&inv,&inv,&tmp);
+        ristretto255_scalar_cond_sel(&out[i],&out[i],&ristretto255_scalar_zero,mask_to_bool(zero));
+    }
+    mask_t zero = bool_to_mask(ristretto255_scalar_eq(&a[0],&ristretto255_scalar_zero));
+    ristretto255_scalar_cond_sel(&out[0],&inv,&ristretto255_scalar_zero,mask_to_bool(zero));
+
+    ristretto255_scalar_destroy(&inv);
+    ristretto255_scalar_destroy(&tmp);
+    return ristretto_succeed_if(mask_to_bool(~any_zero));
+}
+
 void ristretto255_scalar_sub (
     scalar_t *out,
     const scalar_t *a,
@@ -233,6 +354,29 @@ static RISTRETTO_INLINE void scalar_decode_short (
     }
 }
 
+/* Reduce any s < 2^256 mod p.  Since p = 2^252 + c with c < 2^125,
+ * subtracting (s >> 252) * p leaves s in (-2^129, 2^252), and adding p back
+ * if that went negative finishes the job.
+ */
+static RISTRETTO_INLINE void sc_reduce_short (scalar_t *s) {
+    ristretto_word_t hi = s->limb[SCALAR_LIMBS-1] >> (WBITS-4);
+    ristretto_dsword_t chain = 0;
+    unsigned int i;
+    for (i=0; i<SCALAR_LIMBS; i++) {
+        chain = (chain + s->limb[i]) - (ristretto_dsword_t)((ristretto_dword_t)hi*sc_p.limb[i]);
+        s->limb[i] = chain;
+        chain >>= WBITS;
+    }
+    ristretto_word_t borrow = chain; /* = 0 or -1 */
+
+    ristretto_dword_t carry = 0;
+    for (i=0; i<SCALAR_LIMBS; i++) {
+        carry = (carry + s->limb[i]) + (sc_p.limb[i] & borrow);
+        s->limb[i] = carry;
+        carry >>= WBITS;
+    }
+}
+
 ristretto_error_t ristretto255_scalar_decode(
     scalar_t *s,
     const unsigned char ser[SCALAR_SER_BYTES]
@@ -245,11 +389,24 @@ ristretto_error_t ristretto255_scalar_decode(
     }
     /* Here accum == 0 or -1 */
 
-    ristretto255_scalar_mul(s,s,&ristretto255_scalar_one); /* ham-handed reduce */
+    sc_reduce_short(s);
 
     return ristretto_succeed_if(~word_is_zero(accum));
 }
 
+ristretto_error_t ristretto255_scalar_decode_batch(
+    scalar_t *s,
+    const unsigned char *ser,
+    size_t n
+) {
+    mask_t all = -(mask_t)1;
+    size_t i;
+    for (i=0; i<n; i++) {
+        all &= bool_to_mask(ristretto255_scalar_decode(&s[i], &ser[i*SCALAR_SER_BYTES]));
+    }
+    return ristretto_succeed_if(mask_to_bool(all));
+}
+
 void ristretto255_scalar_destroy (
     scalar_t *scalar
 ) {
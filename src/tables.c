@@ -0,0 +1,265 @@
+/**
+ * @file tables.c
+ * @copyright
+ *   Copyright (c) 2018 Ristretto Developers.  \n
+ *   Released under the MIT License.  See LICENSE.txt for license information.
+ * @brief Writing precomputed tables to a file, and finding them in one.
+ */
+
+#define _XOPEN_SOURCE 600 /* f_field.h brings in word.h's posix_memalign too late */
+
+#include <ristretto255.h>
+#include <ristretto255_tables.h>
+#include "f_field.h"
+
+#define point_t ristretto255_point_t
+#define wnaf_t ristretto255_wnaf_precomputed_t
+#define generators_t ristretto255_generators_t
+
+/* (COMBS_N, COMBS_T, COMBS_S), from ristretto.c */
+extern const unsigned int ristretto255_comb_geometry[3];
+
+#define TABLES_BYTE_ORDER 0x01020304u
+
+static const unsigned char tables_magic[8] = { 'R','2','5','5','T','B','L',0 };
+
+/* Every field is at its natural offset, so no ABI pads these */
+struct tables_header {
+    unsigned char magic[8];
+    uint32_t version;
+    uint32_t byte_order;    /* TABLES_BYTE_ORDER as the writer stored it */
+    uint32_t count;
+    uint16_t gf_bytes, point_bytes;
+    uint8_t limbs, limb_bits, comb_n, comb_t, comb_s, reserved[3];
+    uint64_t total_bytes;
+    uint64_t checksum;      /* of everything after the header */
+    uint8_t reserved2[16];
+};
+
+struct tables_entry {
+    uint32_t kind, table_bits;
+    uint64_t offset, count, bytes;
+};
+
+static size_t tables_align(size_t x) {
+    return (x + RISTRETTO255_TABLES_ALIGNMENT-1) & ~(size_t)(RISTRETTO255_TABLES_ALIGNMENT-1);
+}
+
+/* FNV-1a a word at a time, with a fold so that high bits reach low ones.
+ * Everything after the header is a multiple of 8 bytes.
+ */
+static uint64_t tables_checksum(const unsigned char *p, size_t bytes) {
+    uint64_t h = 0xcbf29ce484222325ull, w;
+    size_t i;
+    for (i=0; i+8<=bytes; i+=8) {
+        memcpy(&w, &p[i], sizeof(w));
+        h = (h ^ w) * 0x100000001b3ull;
+        h ^= h >> 32;
+    }
+    return h;
+}
+
+/* The size of one table, or 0 if it isn't valid */
+static size_t table_bytes(const ristretto255_table_ref_t *t, unsigned int *table_bits) {
+    *table_bits = 0;
+    switch (t->kind) {
+    case RISTRETTO255_TABLE_COMB:
+        return t->count == 1 ? ristretto255_sizeof_precomputed_s : 0;
+    case RISTRETTO255_TABLE_WNAF:
+        if (t->count != 1) return 0;
+        *table_bits = ristretto255_wnaf_precomputed_table_bits((const wnaf_t *)t->table);
+        return ristretto255_sizeof_wnaf_precomputed(*table_bits);
+    case RISTRETTO255_TABLE_GENERATORS:
+        if (t->count != 1) return 0;
+        *table_bits = ristretto255_generators_teeth((const generators_t *)t->table);
+        return ristretto255_sizeof_generators(
+            ristretto255_generators_count((const generators_t *)t->table), *table_bits);
+    case RISTRETTO255_TABLE_POINTS:
+        if (t->count > SIZE_MAX / 2 / sizeof(point_t)) return 0;
+        /* An empty vector still gets a section, to keep the offsets simple */
+        return t->count ? t->count * sizeof(point_t) : sizeof(point_t);
+    default:
+        return 0;
+    }
+}
+
+/* Copy n field elements, leaving the padding after their limbs zero */
+static void copy_field_elements(unsigned char *out, const gf_25519_t *in, size_t n) {
+    size_t i;
+    for (i=0; i<n; i++) {
+        memcpy(&out[i*sizeof(gf_25519_t)], in[i].limb, sizeof(in[i].limb));
+    }
+}
+
+size_t ristretto255_tables_serialized_bytes (
+    const ristretto255_table_ref_t *tables,
+    size_t n
+) {
+    unsigned int table_bits;
+    size_t i, total;
+    if (n > UINT32_MAX) return 0;
+    total = tables_align(sizeof(struct tables_header) + n*sizeof(struct tables_entry));
+    for (i=0; i<n; i++) {
+        size_t bytes = table_bytes(&tables[i], &table_bits);
+        if (bytes == 0 || bytes > SIZE_MAX/2 - total) return 0;
+        total += tables_align(bytes);
+    }
+    return total;
+}
+
+ristretto_error_t ristretto255_tables_serialize (
+    unsigned char *out,
+    size_t out_bytes,
+    const ristretto255_table_ref_t *tables,
+    size_t n
+) {
+    const size_t total = ristretto255_tables_serialized_bytes(tables, n);
+    if (total == 0 || out_bytes < total) return RISTRETTO_FAILURE;
+    memset(out, 0, total);
+
+    struct tables_header hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, tables_magic, sizeof(hdr.magic));
+    hdr.version = RISTRETTO255_TABLES_VERSION;
+    hdr.byte_order = TABLES_BYTE_ORDER;
+    hdr.count = n;
+    hdr.gf_bytes = sizeof(gf_25519_t);
+    hdr.point_bytes = sizeof(point_t);
+    hdr.limbs = RISTRETTO255_FIELD_LIMBS;
+    hdr.limb_bits = LIMB_PLACE_VALUE(0);
+    hdr.comb_n = ristretto255_comb_geometry[0];
+    hdr.comb_t = ristretto255_comb_geometry[1];
+    hdr.comb_s = ristretto255_comb_geometry[2];
+    hdr.total_bytes = total;
+
+    size_t i, offset = tables_align(sizeof(hdr) + n*sizeof(struct tables_entry));
+    for (i=0; i<n; i++) {
+        struct tables_entry e;
+        unsigned int table_bits;
+        const size_t bytes = table_bytes(&tables[i], &table_bits);
+        unsigned char *dst = &out[offset];
+
+        e.kind = tables[i].kind;
+        e.table_bits = table_bits;
+        e.offset = offset;
+        e.count = tables[i].count;
+        e.bytes = bytes;
+        memcpy(&out[sizeof(hdr) + i*sizeof(e)], &e, sizeof(e));
+
+        if (tables[i].kind == RISTRETTO255_TABLE_WNAF) {
+            /* The window, then padding, then the niels points */
+            const size_t head = bytes - ((3*sizeof(gf_25519_t)) << table_bits);
+            memcpy(dst, tables[i].table, sizeof(unsigned int));
+            copy_field_elements(&dst[head],
+                (const gf_25519_t *)((const unsigned char *)tables[i].table + head),
+                (bytes - head) / sizeof(gf_25519_t));
+        } else if (tables[i].kind == RISTRETTO255_TABLE_GENERATORS) {
+            /* The header, whose padding ristretto255_generators_create
+             * zeroes, then the niels points
+             */
+            const size_t head = ristretto255_sizeof_generators(0, table_bits);
+            memcpy(dst, tables[i].table, head);
+            copy_field_elements(&dst[head],
+                (const gf_25519_t *)((const unsigned char *)tables[i].table + head),
+                (bytes - head) / sizeof(gf_25519_t));
+        } else if (tables[i].count) {
+            copy_field_elements(dst, (const gf_25519_t *)tables[i].table,
+                bytes / sizeof(gf_25519_t));
+        }
+        offset += tables_align(bytes);
+    }
+    assert(offset == total);
+
+    hdr.checksum = tables_checksum(&out[sizeof(hdr)], total - sizeof(hdr));
+    memcpy(out, &hdr, sizeof(hdr));
+    return RISTRETTO_SUCCESS;
+}
+
+ristretto_error_t ristretto255_tables_view (
+    ristretto255_table_ref_t *tables,
+    size_t *n,
+    const unsigned char *buf,
+    size_t buf_bytes,
+    ristretto_bool_t verify
+) {
+    const struct tables_header *hdr = (const struct tables_header *)buf;
+    const size_t capacity = *n;
+    *n = 0;
+
+    if ((uintptr_t)buf % RISTRETTO255_TABLES_ALIGNMENT
+        || buf_bytes < sizeof(*hdr)
+        || memcmp(hdr->magic, tables_magic, sizeof(hdr->magic))
+        || hdr->version != RISTRETTO255_TABLES_VERSION
+        || hdr->byte_order != TABLES_BYTE_ORDER
+        || hdr->gf_bytes != sizeof(gf_25519_t)
+        || hdr->point_bytes != sizeof(point_t)
+        || hdr->limbs != RISTRETTO255_FIELD_LIMBS
+        || hdr->limb_bits != LIMB_PLACE_VALUE(0)
+        || hdr->comb_n != ristretto255_comb_geometry[0]
+        || hdr->comb_t != ristretto255_comb_geometry[1]
+        || hdr->comb_s != ristretto255_comb_geometry[2]
+        || hdr->total_bytes < sizeof(*hdr)
+        || hdr->total_bytes > buf_bytes
+        || hdr->total_bytes % 8
+        || hdr->count > (hdr->total_bytes - sizeof(*hdr)) / sizeof(struct tables_entry)) {
+        return RISTRETTO_FAILURE;
+    }
+    const size_t total = hdr->total_bytes, count = hdr->count,
+        data_start = sizeof(*hdr) + count*sizeof(struct tables_entry);
+
+    if (verify && tables_checksum(&buf[sizeof(*hdr)], total - sizeof(*hdr)) != hdr->checksum) {
+        return RISTRETTO_FAILURE;
+    }
+
+    const struct tables_entry *entries = (const struct tables_entry *)&buf[sizeof(*hdr)];
+    size_t i;
+    for (i=0; i<count; i++) {
+        const struct tables_entry *e = &entries[i];
+        size_t expected;
+
+        if (e->offset % RISTRETTO255_TABLES_ALIGNMENT || e->offset < data_start
+            || e->offset > total || e->bytes > total - e->offset) {
+            return RISTRETTO_FAILURE;
+        }
+        const unsigned char *table = &buf[e->offset];
+        switch (e->kind) {
+        case RISTRETTO255_TABLE_COMB:
+            expected = e->count == 1 ? ristretto255_sizeof_precomputed_s : 0;
+            break;
+        case RISTRETTO255_TABLE_WNAF:
+            expected = e->count == 1 ? ristretto255_sizeof_wnaf_precomputed(e->table_bits) : 0;
+            if (expected && e->bytes == expected && ristretto255_wnaf_precomputed_table_bits(
+                    (const wnaf_t *)table) != e->table_bits) {
+                return RISTRETTO_FAILURE;
+            }
+            break;
+        case RISTRETTO255_TABLE_GENERATORS:
+            /* The size depends on the generator count in the table's header */
+            expected = e->count == 1 ? ristretto255_sizeof_generators(0, e->table_bits) : 0;
+            if (expected && e->bytes >= expected) {
+                const generators_t *gens = (const generators_t *)table;
+                expected = ristretto255_generators_teeth(gens) == e->table_bits
+                    ? ristretto255_sizeof_generators(ristretto255_generators_count(gens), e->table_bits)
+                    : 0;
+            }
+            break;
+        case RISTRETTO255_TABLE_POINTS:
+            expected = e->count > total / sizeof(point_t) ? 0
+                : e->count ? e->count * sizeof(point_t) : sizeof(point_t);
+            break;
+        default:
+            expected = 0;
+            break;
+        }
+        if (expected == 0 || e->bytes != expected) return RISTRETTO_FAILURE;
+
+        if (i < capacity) {
+            tables[i].kind = (ristretto255_table_kind_t)e->kind;
+            tables[i].count = e->count;
+            tables[i].table = table;
+        }
+    }
+
+    *n = count;
+    return count <= capacity ? RISTRETTO_SUCCESS : RISTRETTO_FAILURE;
+}
@@ -5,7 +5,8 @@
 #ifndef __WORD_H__
 #define __WORD_H__
 
-/* for posix_memalign */
+/* for posix_memalign.  This only works if no system header came first, so
+ * files that include <ristretto255.h> before word.h define it themselves. */
 #define _XOPEN_SOURCE 600
 #define __STDC_WANT_LIB_EXT1__ 1 /* for memset_s */
 #include <string.h>
@@ -38,7 +39,12 @@ extern int posix_memalign(void **, size_t, size_t);
 #include <sys/types.h>
 #include <inttypes.h>
 
-#if defined(__ARM_NEON__)
+/* ACLE compilers define __ARM_NEON; GCC for aarch64 leaves out __ARM_NEON__ */
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define HAS_NEON 1
+#endif
+
+#if HAS_NEON
 #include <arm_neon.h>
 #elif defined(__SSE2__)
     #if !defined(__GNUC__) || __clang__ || __GNUC__ >= 5 || (__GNUC__==4 && __GNUC_MINOR__ >= 4)
@@ -73,7 +79,7 @@ extern int posix_memalign(void **, size_t, size_t);
     #error "libristretto255 only supports 32-bit and 64-bit architectures."
 #endif
 
-#ifdef __ARM_NEON__
+#if HAS_NEON
     typedef uint32x4_t vecmask_t;
 #elif __clang__
     typedef uint64_t uint64x2_t __attribute__((ext_vector_type(2)));
@@ -125,7 +131,7 @@ extern int posix_memalign(void **, size_t, size_t);
         big_register_t ret = {y,y,y,y};
         return ret;
     }
-#elif __ARM_NEON__
+#elif HAS_NEON
     #define VECTOR_ALIGNED __attribute__((aligned(16)))
     typedef uint32x4_t big_register_t;
     typedef uint64x2_t uint64xn_t;
@@ -175,7 +181,7 @@ typedef struct {
         return (big_register_t)_mm_cmpeq_epi32((__m128i)x, _mm_setzero_si128());
         //return (big_register_t)(x == br_set_to_mask(0));
     }
-#elif __ARM_NEON__
+#elif HAS_NEON
     static RISTRETTO_INLINE big_register_t
     br_is_zero(big_register_t x) {
         return vceqq_u32(x,x^x);
@@ -240,6 +246,20 @@ malloc_vector(size_t size) {
     }
 }
 
+/* Allocate from a caller's allocator, or the heap if it is NULL */
+static RISTRETTO_INLINE void *
+ristretto_alloc(const ristretto255_allocator_t *allocator, size_t size) {
+    if (allocator == NULL) return malloc_vector(size);
+    return allocator->alloc(allocator->ctx, size, sizeof(big_register_t));
+}
+
+static RISTRETTO_INLINE void
+ristretto_free(const ristretto255_allocator_t *allocator, void *ptr, size_t size) {
+    if (ptr == NULL) return;
+    if (allocator == NULL) free(ptr);
+    else allocator->free(allocator->ctx, ptr, size);
+}
+
 /* PERF: vectorize vs unroll */
 #ifdef __clang__
 #if 100*__clang_major__ + __clang_minor__ > 305
@@ -280,4 +300,12 @@ static RISTRETTO_INLINE void ignore_result ( ristretto_bool_t boo ) {
     (void)boo;
 }
 
+/* Operation counters, compiled in with COUNTERS=1.  See counters.c. */
+#ifdef RISTRETTO_COUNTERS
+extern __thread ristretto255_counters_t ristretto_counters;
+#define RISTRETTO_COUNT(op,n) (ristretto_counters.op += (n))
+#else
+#define RISTRETTO_COUNT(op,n) ((void)0)
+#endif
+
 #endif /* __WORD_H__ */
@@ -147,6 +147,125 @@ extern "C" {
     pub static mut ristretto255_alignof_precomputed_s: usize;
 }
 
+/// Caller-supplied memory allocator for tables and scratch space.  Every
+/// function which takes one also accepts NULL, meaning posix_memalign and
+/// free.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_allocator_t {
+    /// Return size bytes aligned to align, a power of two, or NULL.
+    pub alloc: ::std::option::Option<
+        unsafe extern "C" fn(
+            ctx: *mut ::std::os::raw::c_void,
+            size: usize,
+            align: usize,
+        ) -> *mut ::std::os::raw::c_void,
+    >,
+    /// Release a region from alloc.  size is the size that was asked for.
+    pub free: ::std::option::Option<
+        unsafe extern "C" fn(
+            ctx: *mut ::std::os::raw::c_void,
+            ptr: *mut ::std::os::raw::c_void,
+            size: usize,
+        ),
+    >,
+    /// Passed to alloc and free.
+    pub ctx: *mut ::std::os::raw::c_void,
+}
+
+/// Caller-supplied way to run independent tasks in parallel, e.g. on a thread
+/// pool.  Every function which takes one also accepts NULL, meaning run
+/// everything on the calling thread.
+///
+/// The library splits a job into tasks of a fixed shape which doesn't depend
+/// on the executor, so the result is the same however many threads run them.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_executor_t {
+    /// Call task(arg, i) once for each i < ntasks, in any order and from any
+    /// threads, and return when they have all finished.
+    pub run: ::std::option::Option<
+        unsafe extern "C" fn(
+            ctx: *mut ::std::os::raw::c_void,
+            task: ::std::option::Option<
+                unsafe extern "C" fn(arg: *mut ::std::os::raw::c_void, i: usize),
+            >,
+            arg: *mut ::std::os::raw::c_void,
+            ntasks: usize,
+        ),
+    >,
+    /// Passed to run.
+    pub ctx: *mut ::std::os::raw::c_void,
+}
+
+/// Caller-supplied source of random bytes, e.g. for the weights in
+/// ristretto255_batch_verify.  It must be cryptographically secure and
+/// unpredictable to whoever supplied the data being checked.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_rng_t {
+    /// Fill out with len random bytes.
+    pub fill: ::std::option::Option<
+        unsafe extern "C" fn(ctx: *mut ::std::os::raw::c_void, out: *mut u8, len: usize),
+    >,
+    /// Passed to fill.
+    pub ctx: *mut ::std::os::raw::c_void,
+}
+
+/// Counts of the field and point operations done by one thread, in a library
+/// built with COUNTERS=1.
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct ristretto255_counters_t {
+    pub gf_mul: u64,
+    pub gf_sqr: u64,
+    pub gf_isr: u64,
+    pub point_add: u64,
+    pub point_double: u64,
+}
+
+extern "C" {
+    /// Bytes of scratch space per term used by ristretto255_multiscalar_mul and
+    /// ristretto255_multiscalar_mul_non_secret.
+    pub static ristretto255_multiscalar_scratch_bytes_per_term: usize;
+}
+
+/// Table of odd multiples of a point, for repeated variable-time
+/// multiplication by the same base.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_wnaf_precomputed_s {
+    _unused: [u8; 0],
+}
+pub type ristretto255_wnaf_precomputed_t = ristretto255_wnaf_precomputed_s;
+
+/// Largest table_bits accepted by ristretto255_wnaf_precomputed_create.
+pub const RISTRETTO255_WNAF_MAX_TABLE_BITS: u32 = 8;
+
+/// Comb tables of a fixed vector of generators, for repeated multiscalar
+/// multiplication by the same points.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_generators_s {
+    _unused: [u8; 0],
+}
+pub type ristretto255_generators_t = ristretto255_generators_s;
+
+/// Largest teeth accepted by ristretto255_generators_create.
+pub const RISTRETTO255_GENERATORS_MAX_TEETH: u32 = 8;
+
+/// Points stored by coordinate limb rather than by point, in blocks of
+/// RISTRETTO255_POINT_BATCH_LANES.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_point_batch_s {
+    _unused: [u8; 0],
+}
+pub type ristretto255_point_batch_t = ristretto255_point_batch_s;
+
+/// Points in each block of a ristretto255_point_batch_t.
+pub const RISTRETTO255_POINT_BATCH_LANES: u32 = 8;
+
 /// Representation of an element of the scalar field.
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -179,6 +298,16 @@ fn bindgen_test_layout_ristretto255_scalar_t() {
     );
 }
 
+/// A scalar x held as x*2^256 mod the group order.  Multiplying two of these
+/// costs half as much as ristretto255_scalar_mul, so long chains of products
+/// can convert once on the way in and once on the way out.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_scalar_mont_t {
+    /// @cond internal
+    pub limb: [ristretto_word_t; 4usize],
+}
+
 extern "C" {
     pub static mut ristretto255_scalar_one: ristretto255_scalar_t;
     pub static mut ristretto255_scalar_zero: ristretto255_scalar_t;
@@ -199,6 +328,22 @@ extern "C" {
         ser: *const ::std::os::raw::c_uchar,
     ) -> ristretto_error_t;
 
+    /// @brief Read an array of scalars from wire format.
+    ///
+    /// @param [out] out The n deserialized scalars.
+    /// @param [in] ser The serialized scalars, n*RISTRETTO255_SCALAR_BYTES bytes
+    /// laid out back to back.
+    /// @param [in] n The number of scalars.
+    ///
+    /// @retval RISTRETTO_SUCCESS Every scalar was correctly encoded.
+    /// @retval RISTRETTO_FAILURE At least one scalar was greater than the
+    /// modulus.  Every scalar has still been decoded and reduced.
+    pub fn ristretto255_scalar_decode_batch(
+        out: *mut ristretto255_scalar_t,
+        ser: *const ::std::os::raw::c_uchar,
+        n: usize,
+    ) -> ristretto_error_t;
+
     /// @brief Read a scalar from wire format or from bytes.  Reduces mod
     /// scalar prime.
     ///
@@ -260,6 +405,70 @@ extern "C" {
         b: *const ristretto255_scalar_t,
     );
 
+    /// @brief Multiply two scalars and add a third, as one reduction.  The
+    /// scalars may use the same memory.
+    /// @param [in] a One scalar.
+    /// @param [in] b Another scalar.
+    /// @param [in] c The scalar to add.
+    /// @param [out] out a*b+c.
+    pub fn ristretto255_scalar_muladd(
+        out: *mut ristretto255_scalar_t,
+        a: *const ristretto255_scalar_t,
+        b: *const ristretto255_scalar_t,
+        c: *const ristretto255_scalar_t,
+    );
+
+    /// @brief Convert a scalar to Montgomery form.  The scalars may use the
+    /// same memory.
+    /// @param [in] a A scalar.
+    /// @param [out] out a in Montgomery form.
+    pub fn ristretto255_scalar_to_montgomery(
+        out: *mut ristretto255_scalar_mont_t,
+        a: *const ristretto255_scalar_t,
+    );
+
+    /// @brief Convert a scalar out of Montgomery form.  The scalars may use the
+    /// same memory.
+    /// @param [in] a A scalar in Montgomery form.
+    /// @param [out] out a as an ordinary scalar.
+    pub fn ristretto255_scalar_from_montgomery(
+        out: *mut ristretto255_scalar_t,
+        a: *const ristretto255_scalar_mont_t,
+    );
+
+    /// @brief Multiply two scalars in Montgomery form.  The scalars may use the
+    /// same memory.
+    /// @param [in] a One scalar.
+    /// @param [in] b Another scalar.
+    /// @param [out] out a*b, in Montgomery form.
+    pub fn ristretto255_scalar_mont_mul(
+        out: *mut ristretto255_scalar_mont_t,
+        a: *const ristretto255_scalar_mont_t,
+        b: *const ristretto255_scalar_mont_t,
+    );
+
+    /// @brief Square a scalar in Montgomery form.  The scalars may use the same
+    /// memory.
+    /// @param [in] a A scalar.
+    /// @param [out] out a^2, in Montgomery form.
+    pub fn ristretto255_scalar_mont_sqr(
+        out: *mut ristretto255_scalar_mont_t,
+        a: *const ristretto255_scalar_mont_t,
+    );
+
+    /// @brief Multiply two scalars in Montgomery form and add a third, e.g. for
+    /// one step of Horner's rule.  The scalars may use the same memory.
+    /// @param [in] a One scalar.
+    /// @param [in] b Another scalar.
+    /// @param [in] c The scalar to add.
+    /// @param [out] out a*b+c, in Montgomery form.
+    pub fn ristretto255_scalar_mont_muladd(
+        out: *mut ristretto255_scalar_mont_t,
+        a: *const ristretto255_scalar_mont_t,
+        b: *const ristretto255_scalar_mont_t,
+        c: *const ristretto255_scalar_mont_t,
+    );
+
     /// @brief Halve a scalar.  The scalars may use the same memory.
     /// @param [in] a A scalar.
     /// @param [out] out a/2.
@@ -277,6 +486,21 @@ extern "C" {
         a: *const ristretto255_scalar_t,
     ) -> ristretto_error_t;
 
+    /// @brief Invert an array of scalars.  Zeros are inverted to 0 as with
+    /// ristretto255_scalar_invert, and the others are unaffected by them.
+    ///
+    /// @param [out] out The n inverses.  Must not overlap a.
+    /// @param [in] a The n scalars to invert.
+    /// @param [in] n The number of scalars.
+    ///
+    /// @retval RISTRETTO_SUCCESS Every input was nonzero.
+    /// @retval RISTRETTO_FAILURE At least one input was zero.
+    pub fn ristretto255_scalar_batch_invert(
+        out: *mut ristretto255_scalar_t,
+        a: *const ristretto255_scalar_t,
+        n: usize,
+    ) -> ristretto_error_t;
+
     /// @brief Set a scalar to an unsigned 64-bit integer.
     /// @param [in] a An integer.
     /// @param [out] out Will become equal to a.
@@ -288,6 +512,19 @@ extern "C" {
     /// @param [in] pt The point to encode.
     pub fn ristretto255_point_encode(ser: *mut u8, pt: *const ristretto255_point_t);
 
+    /// @brief Encode an array of points as sequences of bytes.
+    ///
+    /// Equivalent to calling ristretto255_point_encode on each point.
+    ///
+    /// @param [out] out The byte representations of the points.
+    /// @param [in] pts The points to encode.
+    /// @param [in] n The number of points.
+    pub fn ristretto255_point_encode_batch(
+        out: *mut [u8; 32usize],
+        pts: *const ristretto255_point_t,
+        n: usize,
+    );
+
     /// @brief Decode a point from a sequence of bytes.
     ///
     /// Every point has a unique encoding, so not every
@@ -306,6 +543,29 @@ extern "C" {
         allow_identity: ristretto_bool_t,
     ) -> ristretto_error_t;
 
+    /// @brief Decode an array of points from sequences of bytes.
+    ///
+    /// Equivalent to calling ristretto255_point_decode on each element.  If an
+    /// element is an invalid encoding, its output point is undefined, but the
+    /// others are still decoded.
+    ///
+    /// @param [out] pts The decoded points.
+    /// @param [out] results The result of decoding each element.
+    /// @param [in] ser The serialized points, n*RISTRETTO255_SER_BYTES bytes
+    /// laid out back to back.
+    /// @param [in] n The number of points.
+    /// @param [in] allow_identity RISTRETTO_TRUE if the identity is a legal input.
+    /// @retval RISTRETTO_SUCCESS Every element was decoded successfully.
+    /// @retval RISTRETTO_FAILURE At least one element didn't represent a point;
+    /// consult results to find out which.
+    pub fn ristretto255_point_decode_batch(
+        pts: *mut ristretto255_point_t,
+        results: *mut ristretto_error_t,
+        ser: *const u8,
+        n: usize,
+        allow_identity: ristretto_bool_t,
+    ) -> ristretto_error_t;
+
     /// @brief Test whether two points are equal.  If yes, return
     /// RISTRETTO_TRUE, else return RISTRETTO_FALSE.
     ///
@@ -318,6 +578,26 @@ extern "C" {
         b: *const ristretto255_point_t,
     ) -> ristretto_bool_t;
 
+    /// @brief Compute a key for each of an array of points, such that two
+    /// points are equal exactly when their keys are equal as bytes.
+    pub fn ristretto255_point_canonical_batch(
+        keys: *mut [u8; 32usize],
+        pts: *const ristretto255_point_t,
+        n: usize,
+    );
+
+    /// @brief Find the duplicates in an array of points: first[i] is the index
+    /// of the first point equal to pts[i].
+    ///
+    /// @retval RISTRETTO_SUCCESS The duplicates were found.
+    /// @retval RISTRETTO_FAILURE Scratch space couldn't be allocated.
+    pub fn ristretto255_point_dedup(
+        first: *mut usize,
+        pts: *const ristretto255_point_t,
+        n: usize,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
     /// @brief Add two points to produce a third point.  The
     /// input points and output point can be pointers to the same
     /// memory.
@@ -410,6 +690,19 @@ extern "C" {
         b: *const ristretto255_point_t,
     );
 
+    /// @brief Allocate and fill a precomputed table, as with
+    /// ristretto255_precompute.
+    ///
+    /// @param [out] pre The new table, to be freed with
+    /// ristretto255_precomputed_free.  NULL on failure.
+    /// @param [in] base Any point.
+    /// @param [in] allocator Where to allocate the table, or NULL for the heap.
+    pub fn ristretto255_precomputed_create(
+        pre: *mut *mut ristretto255_precomputed_s,
+        base: *const ristretto255_point_t,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
     /// @brief Multiply a precomputed base point by a scalar:
     /// scaled = scalar*base.
     /// Some implementations do not include precomputed points; for
@@ -425,6 +718,24 @@ extern "C" {
         scalar: *const ristretto255_scalar_t,
     );
 
+    /// @brief Multiply a precomputed base point by a scalar:
+    /// scaled = scalar*base.
+    ///
+    /// Otherwise equivalent to ristretto255_precomputed_scalarmul, but faster
+    /// at the expense of being variable time.  It uses the same tables.
+    ///
+    /// @param [out] scaled The scaled point base*scalar
+    /// @param [in] base The point to be scaled.
+    /// @param [in] scalar The scalar to multiply by.
+    ///
+    /// @warning: This function takes variable time, and may leak the scalar
+    /// used.  It is designed for signature verification.
+    pub fn ristretto255_precomputed_scalarmul_non_secret(
+        scaled: *mut ristretto255_point_t,
+        base: *const ristretto255_precomputed_s,
+        scalar: *const ristretto255_scalar_t,
+    );
+
     /// @brief Multiply two base points by two scalars:
     /// scaled = scalar1*base1 + scalar2*base2.
     ///
@@ -485,6 +796,344 @@ extern "C" {
         scalar2: *const ristretto255_scalar_t,
     );
 
+    /// @brief As ristretto255_multiscalar_mul, but takes its scratch space from
+    /// allocator, or from the heap if it is NULL.
+    pub fn ristretto255_multiscalar_mul_with_allocator(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
+    /// @brief As ristretto255_multiscalar_mul_non_secret, but takes its scratch
+    /// space from allocator, or from the heap if it is NULL.
+    pub fn ristretto255_multiscalar_mul_non_secret_with_allocator(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
+    /// @brief As ristretto255_multiscalar_mul_with_allocator, but splits the
+    /// terms into fixed-size groups and runs them on executor.  The scratch
+    /// space is still a single allocation within the same per-term bound.
+    pub fn ristretto255_multiscalar_mul_parallel(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+        allocator: *const ristretto255_allocator_t,
+        executor: *const ristretto255_executor_t,
+    ) -> ristretto_error_t;
+
+    /// @brief As ristretto255_multiscalar_mul_non_secret_with_allocator, but runs
+    /// the work on executor: each Pippenger window accumulates its buckets as a
+    /// separate task.  Batches too small for Pippenger run on the calling thread.
+    /// The scratch space is still a single allocation within the same per-term
+    /// bound.
+    pub fn ristretto255_multiscalar_mul_non_secret_parallel(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+        allocator: *const ristretto255_allocator_t,
+        executor: *const ristretto255_executor_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Bytes of scratch space that the _with_scratch multiscalar
+    /// functions need for n terms, with or without an executor, at any
+    /// alignment.
+    pub fn ristretto255_multiscalar_scratch_size(n: usize) -> usize;
+
+    /// @brief As ristretto255_multiscalar_mul_parallel, but in caller-owned
+    /// scratch space instead of an allocation.
+    pub fn ristretto255_multiscalar_mul_with_scratch(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+        scratch: *mut ::std::os::raw::c_void,
+        scratch_bytes: usize,
+        executor: *const ristretto255_executor_t,
+    ) -> ristretto_error_t;
+
+    /// @brief As ristretto255_multiscalar_mul_non_secret_parallel, but in
+    /// caller-owned scratch space instead of an allocation.
+    pub fn ristretto255_multiscalar_mul_non_secret_with_scratch(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+        scratch: *mut ::std::os::raw::c_void,
+        scratch_bytes: usize,
+        executor: *const ristretto255_executor_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Precompute comb tables of a fixed vector of generators, such as
+    /// the g_i and h of Pedersen vector commitments, to be reused by many calls
+    /// to ristretto255_generators_mul.
+    pub fn ristretto255_generators_create(
+        gens: *mut *mut ristretto255_generators_t,
+        points: *const ristretto255_point_t,
+        n: usize,
+        teeth: ::std::os::raw::c_uint,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Erase and free tables from ristretto255_generators_create.
+    pub fn ristretto255_generators_destroy(
+        gens: *mut ristretto255_generators_t,
+        allocator: *const ristretto255_allocator_t,
+    );
+
+    /// @brief The number of generators that tables were created with.
+    pub fn ristretto255_generators_count(gens: *const ristretto255_generators_t) -> usize;
+
+    /// @brief The comb size that tables were created with.
+    pub fn ristretto255_generators_teeth(gens: *const ristretto255_generators_t) -> ::std::os::raw::c_uint;
+
+    /// @brief Bytes in the tables of n generators, or 0 if teeth is invalid.
+    pub fn ristretto255_sizeof_generators(n: usize, teeth: ::std::os::raw::c_uint) -> usize;
+
+    /// @brief Multiply the first n generators by n scalars.
+    pub fn ristretto255_generators_mul(
+        combo: *mut ristretto255_point_t,
+        gens: *const ristretto255_generators_t,
+        scalars: *const ristretto255_scalar_t,
+        n: usize,
+    ) -> ristretto_error_t;
+
+    /// @brief Multiply the first n generators by n scalars, in variable time.
+    pub fn ristretto255_generators_mul_non_secret(
+        combo: *mut ristretto255_point_t,
+        gens: *const ristretto255_generators_t,
+        scalars: *const ristretto255_scalar_t,
+        n: usize,
+    ) -> ristretto_error_t;
+
+    /// @brief Create a batch of n points, all the identity.
+    pub fn ristretto255_point_batch_create(
+        batch: *mut *mut ristretto255_point_batch_t,
+        n: usize,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Erase and free a batch from ristretto255_point_batch_create.
+    pub fn ristretto255_point_batch_destroy(
+        batch: *mut ristretto255_point_batch_t,
+        allocator: *const ristretto255_allocator_t,
+    );
+
+    /// The number of points in a batch.
+    pub fn ristretto255_point_batch_count(batch: *const ristretto255_point_batch_t) -> usize;
+
+    /// @brief Copy points into a batch: point first+i of the batch becomes pts[i].
+    pub fn ristretto255_point_batch_pack(
+        batch: *mut ristretto255_point_batch_t,
+        first: usize,
+        pts: *const ristretto255_point_t,
+        n: usize,
+    ) -> ristretto_error_t;
+
+    /// @brief Copy points out of a batch: pts[i] becomes point first+i of the
+    /// batch.
+    pub fn ristretto255_point_batch_unpack(
+        pts: *mut ristretto255_point_t,
+        batch: *const ristretto255_point_batch_t,
+        first: usize,
+        n: usize,
+    ) -> ristretto_error_t;
+
+    /// @brief Add two batches pointwise: out[i] = a[i] + b[i].
+    pub fn ristretto255_point_batch_add(
+        out: *mut ristretto255_point_batch_t,
+        a: *const ristretto255_point_batch_t,
+        b: *const ristretto255_point_batch_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Double a batch pointwise: out[i] = 2*a[i].
+    pub fn ristretto255_point_batch_double(
+        out: *mut ristretto255_point_batch_t,
+        a: *const ristretto255_point_batch_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Negate a batch pointwise: out[i] = -a[i].
+    pub fn ristretto255_point_batch_negate(
+        out: *mut ristretto255_point_batch_t,
+        a: *const ristretto255_point_batch_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Select between two batches pointwise in constant time:
+    /// out[i] = pick_b[i] ? b[i] : a[i].
+    pub fn ristretto255_point_batch_cond_sel(
+        out: *mut ristretto255_point_batch_t,
+        a: *const ristretto255_point_batch_t,
+        b: *const ristretto255_point_batch_t,
+        pick_b: *const ristretto_bool_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Multiply each point of a batch by its own secret scalar:
+    /// out[i] = scalars[i]*a[i].
+    pub fn ristretto255_point_batch_scalarmul(
+        out: *mut ristretto255_point_batch_t,
+        a: *const ristretto255_point_batch_t,
+        scalars: *const ristretto255_scalar_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Encode every point of a batch, as ristretto255_point_encode_batch.
+    pub fn ristretto255_point_batch_encode(
+        out: *mut [u8; 32usize],
+        batch: *const ristretto255_point_batch_t,
+    );
+
+    /// @brief Decode one point for each point of a batch, as
+    /// ristretto255_point_decode_batch.
+    pub fn ristretto255_point_batch_decode(
+        batch: *mut ristretto255_point_batch_t,
+        results: *mut ristretto_error_t,
+        ser: *const u8,
+        allow_identity: ristretto_bool_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Hash one input to the curve for each point of a batch, as
+    /// ristretto255_point_from_hash_uniform_batch.
+    pub fn ristretto255_point_batch_from_hash_uniform(
+        batch: *mut ristretto255_point_batch_t,
+        hashed_data: *const u8,
+    );
+
+    /// @brief As ristretto255_multiscalar_mul_parallel, with the bases taken
+    /// from a batch.
+    pub fn ristretto255_point_batch_multiscalar_mul(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_batch_t,
+        allocator: *const ristretto255_allocator_t,
+        executor: *const ristretto255_executor_t,
+    ) -> ristretto_error_t;
+
+    /// @brief As ristretto255_multiscalar_mul_non_secret_parallel, with the
+    /// bases taken from a batch.
+    pub fn ristretto255_point_batch_multiscalar_mul_non_secret(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_batch_t,
+        allocator: *const ristretto255_allocator_t,
+        executor: *const ristretto255_executor_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Precompute a wNAF table of a point, to be reused by many calls to
+    /// ristretto255_base_double_scalarmul_non_secret_precomputed.
+    ///
+    /// @param [out] pre The new table, to be freed with
+    /// ristretto255_wnaf_precomputed_destroy.  NULL on failure.
+    /// @param [in] base The point.
+    /// @param [in] table_bits The window, from 1 to RISTRETTO255_WNAF_MAX_TABLE_BITS.
+    /// @param [in] allocator Where to allocate the table, or NULL for the heap.
+    pub fn ristretto255_wnaf_precomputed_create(
+        pre: *mut *mut ristretto255_wnaf_precomputed_t,
+        base: *const ristretto255_point_t,
+        table_bits: ::std::os::raw::c_uint,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Erase and free a table from ristretto255_wnaf_precomputed_create.
+    pub fn ristretto255_wnaf_precomputed_destroy(
+        pre: *mut ristretto255_wnaf_precomputed_t,
+        allocator: *const ristretto255_allocator_t,
+    );
+
+    /// @brief The size of a wNAF table with the given window, for
+    /// ristretto255_wnaf_precompute.  0 if table_bits is out of range.
+    pub fn ristretto255_sizeof_wnaf_precomputed(table_bits: ::std::os::raw::c_uint) -> usize;
+
+    /// @brief Bytes of scratch space ristretto255_wnaf_precompute allocates.
+    /// 0 if table_bits is out of range.
+    pub fn ristretto255_wnaf_precompute_scratch_size(table_bits: ::std::os::raw::c_uint) -> usize;
+
+    /// @brief Build a wNAF table of a point in memory the caller provides,
+    /// which must be ristretto255_sizeof_wnaf_precomputed(table_bits) bytes
+    /// and aligned as a point.
+    pub fn ristretto255_wnaf_precompute(
+        pre: *mut ristretto255_wnaf_precomputed_t,
+        base: *const ristretto255_point_t,
+        table_bits: ::std::os::raw::c_uint,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
+    /// @brief The window a wNAF table was built with.
+    pub fn ristretto255_wnaf_precomputed_table_bits(
+        pre: *const ristretto255_wnaf_precomputed_t,
+    ) -> ::std::os::raw::c_uint;
+
+    /// @brief Check n equations s[i]*B == R[i] + c[i]*A[i] at once, where B is
+    /// the base point, as in Schnorr signature verification.
+    ///
+    /// The equations are combined with random 128-bit weights from rng into one
+    /// multiscalar multiply and one comparison.  If the batch fails and bad is
+    /// not NULL, it is split in halves recursively to find the false equations.
+    ///
+    /// @retval RISTRETTO_SUCCESS Every equation holds.
+    /// @retval RISTRETTO_FAILURE At least one equation is false, or scratch
+    /// space couldn't be allocated, in which case *nbad is 0.
+    pub fn ristretto255_batch_verify(
+        bad: *mut usize,
+        nbad: *mut usize,
+        s: *const ristretto255_scalar_t,
+        R: *const ristretto255_point_t,
+        c: *const ristretto255_scalar_t,
+        A: *const ristretto255_point_t,
+        n: usize,
+        rng: *const ristretto255_rng_t,
+        allocator: *const ristretto255_allocator_t,
+        executor: *const ristretto255_executor_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Multiply two base points by two scalars:
+    /// scaled = scalar1*ristretto255_point_base + scalar2*base2,
+    /// with the second base's table built ahead of time.
+    pub fn ristretto255_base_double_scalarmul_non_secret_precomputed(
+        combo: *mut ristretto255_point_t,
+        scalar1: *const ristretto255_scalar_t,
+        base2: *const ristretto255_wnaf_precomputed_t,
+        scalar2: *const ristretto255_scalar_t,
+    );
+
+    /// @brief Multiply many base points by many scalars:
+    /// combo = scalars[0]*bases[0] + ... + scalars[n-1]*bases[n-1].
+    ///
+    /// @param [out] combo The linear combination.
+    /// @param [in] scalars An array of n scalars.
+    /// @param [in] bases An array of n points to be scaled.
+    /// @param [in] n The number of terms.  If zero, combo is the identity.
+    ///
+    /// @retval RISTRETTO_SUCCESS The multiplication succeeded.
+    /// @retval RISTRETTO_FAILURE Scratch space couldn't be allocated, and
+    /// combo was not written.
+    pub fn ristretto255_multiscalar_mul(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+    ) -> ristretto_error_t;
+
+    /// @brief Multiply many base points by many scalars:
+    /// combo = scalars[0]*bases[0] + ... + scalars[n-1]*bases[n-1].
+    ///
+    /// Otherwise equivalent to ristretto255_multiscalar_mul, but faster at the
+    /// expense of being variable time.
+    ///
+    /// @warning: This function takes variable time, and may leak the scalars
+    /// used.  It is designed for batch signature verification.
+    pub fn ristretto255_multiscalar_mul_non_secret(
+        combo: *mut ristretto255_point_t,
+        scalars: *const ristretto255_scalar_t,
+        bases: *const ristretto255_point_t,
+        n: usize,
+    ) -> ristretto_error_t;
+
     /// @brief Constant-time decision between two points.  If pick_b
     /// is zero, out = a; else out = b.
     ///
@@ -543,6 +1192,15 @@ extern "C" {
         factor: *const ::std::os::raw::c_uchar,
     );
 
+    /// @brief Get the calling thread's operation counts.
+    ///
+    /// @retval RISTRETTO_SUCCESS The library was built to count.
+    /// @retval RISTRETTO_FAILURE It wasn't, and the counts are zero.
+    pub fn ristretto255_counters_get(counters: *mut ristretto255_counters_t) -> ristretto_error_t;
+
+    /// @brief Reset the calling thread's operation counts to zero.
+    pub fn ristretto255_counters_reset();
+
     /// @brief Almost-Elligator-like hash to curve.
     ///
     /// Call this function with the output of a hash to make a hash to the curve.
@@ -585,6 +1243,21 @@ extern "C" {
         hashed_data: *const ::std::os::raw::c_uchar,
     );
 
+    /// @brief Hash an array of inputs to the curve.
+    ///
+    /// Equivalent to calling ristretto255_point_from_hash_uniform on each
+    /// input.
+    ///
+    /// @param [out] pts The n points.
+    /// @param [in] hashed_data n outputs of some hash function,
+    /// 2*RISTRETTO255_HASH_BYTES each, laid out back to back.
+    /// @param [in] n The number of inputs.
+    pub fn ristretto255_point_from_hash_uniform_batch(
+        pts: *mut ristretto255_point_t,
+        hashed_data: *const ::std::os::raw::c_uchar,
+        n: usize,
+    );
+
     /// @brief Inverse of elligator-like hash to curve.
     ///
     /// This function writes to the buffer, to make it so that
@@ -649,4 +1322,177 @@ extern "C" {
     /// Securely erase a precomputed table by overwriting it with zeros.
     /// @warning This causes the table object to become invalid.
     pub fn ristretto255_precomputed_destroy(pre: *mut ristretto255_precomputed_s);
+
+    /// @brief Erase and free a table from ristretto255_precomputed_create.
+    pub fn ristretto255_precomputed_free(
+        pre: *mut ristretto255_precomputed_s,
+        allocator: *const ristretto255_allocator_t,
+    );
+}
+
+/// A point cache, from ristretto255_cache.h.  Opaque.
+#[repr(C)]
+pub struct ristretto255_point_cache_s {
+    _unused: [u8; 0],
+}
+pub type ristretto255_point_cache_t = ristretto255_point_cache_s;
+
+extern "C" {
+    /// @brief Create a point cache of at most max_bytes, holding wNAF tables
+    /// with the given window.
+    pub fn ristretto255_point_cache_create(
+        cache: *mut *mut ristretto255_point_cache_t,
+        max_bytes: usize,
+        table_bits: ::std::os::raw::c_uint,
+        allocator: *const ristretto255_allocator_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Free a cache.  No tables from it may still be in use.
+    pub fn ristretto255_point_cache_destroy(
+        cache: *mut ristretto255_point_cache_t,
+        allocator: *const ristretto255_allocator_t,
+    );
+
+    /// @brief Decode a point through the cache, and get its wNAF table, or
+    /// NULL if it couldn't be cached.
+    pub fn ristretto255_point_cache_decode(
+        pt: *mut ristretto255_point_t,
+        table: *mut *const ristretto255_wnaf_precomputed_t,
+        cache: *mut ristretto255_point_cache_t,
+        ser: *const u8,
+        allow_identity: ristretto_bool_t,
+    ) -> ristretto_error_t;
+
+    /// @brief Give back a table from ristretto255_point_cache_decode.
+    pub fn ristretto255_point_cache_release(
+        cache: *mut ristretto255_point_cache_t,
+        table: *const ristretto255_wnaf_precomputed_t,
+    );
+}
+
+/// Table files, from ristretto255_tables.h.
+pub const RISTRETTO255_TABLES_VERSION: u32 = 1;
+pub const RISTRETTO255_TABLES_ALIGNMENT: usize = 64;
+
+pub type ristretto255_table_kind_t = u32;
+pub const RISTRETTO255_TABLE_COMB: ristretto255_table_kind_t = 1;
+pub const RISTRETTO255_TABLE_WNAF: ristretto255_table_kind_t = 2;
+pub const RISTRETTO255_TABLE_POINTS: ristretto255_table_kind_t = 3;
+pub const RISTRETTO255_TABLE_GENERATORS: ristretto255_table_kind_t = 4;
+
+/// A table to write, or one found in a buffer.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_table_ref_t {
+    pub kind: ristretto255_table_kind_t,
+    pub count: usize,
+    pub table: *const ::std::os::raw::c_void,
+}
+
+extern "C" {
+    /// @brief Size of the file ristretto255_tables_serialize writes, or 0 if
+    /// a table is invalid.
+    pub fn ristretto255_tables_serialized_bytes(
+        tables: *const ristretto255_table_ref_t,
+        n: usize,
+    ) -> usize;
+
+    /// @brief Write tables in the file format.
+    pub fn ristretto255_tables_serialize(
+        out: *mut u8,
+        out_bytes: usize,
+        tables: *const ristretto255_table_ref_t,
+        n: usize,
+    ) -> ristretto_error_t;
+
+    /// @brief Find the tables in a file without copying them.  On output *n
+    /// is the number of tables in the file.
+    pub fn ristretto255_tables_view(
+        tables: *mut ristretto255_table_ref_t,
+        n: *mut usize,
+        buf: *const u8,
+        buf_bytes: usize,
+        verify: ristretto_bool_t,
+    ) -> ristretto_error_t;
+}
+
+/// Streaming hash to the group, from ristretto255_hash.h.
+pub const RISTRETTO255_SHA512_BYTES: usize = 64;
+
+/// The state of a SHA-512 computation.
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct ristretto255_sha512_ctx_t {
+    pub state: [u64; 8usize],
+    pub bytes: u64,
+    pub block: [u8; 128usize],
+}
+
+/// Caller-supplied hash for ristretto255_hash_to_point_init, with a
+/// 2*RISTRETTO255_HASH_BYTES byte output.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ristretto255_hash_t {
+    /// Start a new computation.
+    pub init: ::std::option::Option<unsafe extern "C" fn(ctx: *mut ::std::os::raw::c_void)>,
+    /// Absorb len bytes of data.
+    pub update: ::std::option::Option<
+        unsafe extern "C" fn(ctx: *mut ::std::os::raw::c_void, data: *const u8, len: usize),
+    >,
+    /// Write the digest of everything absorbed.
+    pub final_: ::std::option::Option<
+        unsafe extern "C" fn(ctx: *mut ::std::os::raw::c_void, out: *mut u8),
+    >,
+    /// Passed to init, update and final.
+    pub ctx: *mut ::std::os::raw::c_void,
+}
+
+/// A message being hashed to the group.
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct ristretto255_hash_to_point_ctx_t {
+    pub hash: *const ristretto255_hash_t,
+    pub sha512: ristretto255_sha512_ctx_t,
+}
+
+extern "C" {
+    /// Start a SHA-512 computation.
+    pub fn ristretto255_sha512_init(ctx: *mut ristretto255_sha512_ctx_t);
+
+    /// Absorb len bytes of data into a SHA-512 computation.
+    pub fn ristretto255_sha512_update(
+        ctx: *mut ristretto255_sha512_ctx_t,
+        data: *const u8,
+        len: usize,
+    );
+
+    /// @brief Finish a SHA-512 computation, erasing the state.
+    pub fn ristretto255_sha512_final(ctx: *mut ristretto255_sha512_ctx_t, out: *mut u8);
+
+    /// @brief Start hashing a message to the group, with a caller-supplied
+    /// hash or NULL for SHA-512.
+    pub fn ristretto255_hash_to_point_init(
+        ctx: *mut ristretto255_hash_to_point_ctx_t,
+        hash: *const ristretto255_hash_t,
+    );
+
+    /// Absorb the next len bytes of the message.
+    pub fn ristretto255_hash_to_point_update(
+        ctx: *mut ristretto255_hash_to_point_ctx_t,
+        data: *const u8,
+        len: usize,
+    );
+
+    /// @brief Finish hashing a message to the group, erasing the state.
+    pub fn ristretto255_hash_to_point_final(
+        ctx: *mut ristretto255_hash_to_point_ctx_t,
+        pt: *mut ristretto255_point_t,
+    );
+
+    /// @brief Finish hashing a message, but stop at the digest, for
+    /// ristretto255_point_from_hash_uniform_batch.
+    pub fn ristretto255_hash_to_point_final_digest(
+        ctx: *mut ristretto255_hash_to_point_ctx_t,
+        out: *mut u8,
+    );
 }
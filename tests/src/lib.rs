@@ -60,9 +60,15 @@ pub mod vectors;
 #[cfg(test)]
 #[allow(non_snake_case)]
 mod test {
-    use rand::OsRng;
+    use rand::{OsRng, Rng};
+    use std::mem;
+    use std::os::raw::c_void;
+    use std::ptr;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+    use std::thread;
 
-    use ristretto::{CompressedRistretto, RistrettoPoint};
+    use libristretto255_sys::*;
+    use ristretto::{CompressedRistretto, RistrettoPoint, VartimePrecomputation};
     use scalar::Scalar;
 
     #[test]
@@ -117,4 +123,1280 @@ mod test {
             assert_eq!(P, Q);
         }
     }
+
+    #[test]
+    fn compress_batch_matches_compress() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+
+        let mut points: Vec<RistrettoPoint> =
+            (0..32).map(|_| B * Scalar::random(&mut rng)).collect();
+        points.push(RistrettoPoint::identity());
+
+        let compressed = RistrettoPoint::compress_batch(&points);
+        assert_eq!(compressed.len(), points.len());
+
+        for (P, c) in points.iter().zip(compressed.iter()) {
+            assert_eq!(P.compress(), *c);
+        }
+
+        assert!(RistrettoPoint::compress_batch(&[]).is_empty());
+    }
+
+    #[test]
+    fn from_uniform_bytes_batch_matches_from_uniform_bytes() {
+        let mut rng = OsRng::new().unwrap();
+
+        // Enough for the 8-way path plus a tail
+        let mut inputs = vec![[0u8; 64]; 11];
+        for input in inputs.iter_mut() {
+            for b in input.iter_mut() {
+                *b = rng.gen();
+            }
+        }
+
+        let points = RistrettoPoint::from_uniform_bytes_batch(&inputs);
+        for (input, P) in inputs.iter().zip(points.iter()) {
+            assert_eq!(RistrettoPoint::from_uniform_bytes(input), *P);
+        }
+
+        assert!(RistrettoPoint::from_uniform_bytes_batch(&[]).is_empty());
+    }
+
+    #[test]
+    fn decompress_batch_matches_decompress() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+
+        let mut encodings: Vec<CompressedRistretto> =
+            (0..9).map(|_| (B * Scalar::random(&mut rng)).compress()).collect();
+        encodings.push(CompressedRistretto::identity());
+
+        let points = CompressedRistretto::decompress_batch(&encodings).unwrap();
+        for (c, P) in encodings.iter().zip(points.iter()) {
+            assert_eq!(c.decompress().unwrap(), *P);
+        }
+
+        // A negative field element (s = 1) is never a valid encoding
+        let mut bad = [0u8; 32];
+        bad[0] = 1;
+        encodings[3] = CompressedRistretto(bad);
+
+        let points = CompressedRistretto::decompress_batch(&encodings).unwrap_err();
+        for (i, (c, P)) in encodings.iter().zip(points.iter()).enumerate() {
+            assert_eq!(P.is_none(), i == 3);
+            assert_eq!(c.decompress(), *P);
+        }
+    }
+
+    #[test]
+    fn vartime_mul_base_matches_mul_base() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+
+        let mut scalars: Vec<Scalar> = (0..16).map(|_| Scalar::random(&mut rng)).collect();
+        scalars.push(Scalar::from(0u64));
+        scalars.push(Scalar::from(1u64));
+        scalars.push(Scalar::from(0u64) - Scalar::from(1u64));
+
+        for s in scalars {
+            let P = RistrettoPoint::mul_base(&s);
+            assert_eq!(P, B * s);
+            assert_eq!(RistrettoPoint::vartime_mul_base(&s), P);
+        }
+    }
+
+    #[test]
+    fn double_and_dual_scalarmul_match_scalarmul() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let P = B * Scalar::random(&mut rng);
+        let Q = B * Scalar::random(&mut rng);
+
+        let mut scalars: Vec<Scalar> = (0..4).map(|_| Scalar::random(&mut rng)).collect();
+        scalars.push(Scalar::from(0u64));
+        scalars.push(Scalar::from(1u64));
+        scalars.push(Scalar::from(0u64) - Scalar::from(1u64));
+
+        for a in scalars.iter() {
+            for b in scalars.iter() {
+                let mut combo = RistrettoPoint::identity();
+                let mut a1 = RistrettoPoint::identity();
+                let mut a2 = RistrettoPoint::identity();
+                unsafe {
+                    ristretto255_point_double_scalarmul(&mut combo.0, &P.0, &a.0, &Q.0, &b.0);
+                    ristretto255_point_dual_scalarmul(&mut a1.0, &mut a2.0, &P.0, &a.0, &b.0);
+                }
+                assert_eq!(combo, P * *a + Q * *b);
+                assert_eq!(a1, P * *a);
+                assert_eq!(a2, P * *b);
+            }
+        }
+    }
+
+    #[test]
+    fn vartime_precomputation_matches_double_scalar_mul() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let P = B * Scalar::random(&mut rng);
+
+        assert!(VartimePrecomputation::new(&P, 0).is_none());
+        assert!(VartimePrecomputation::new(&P, RISTRETTO255_WNAF_MAX_TABLE_BITS + 1).is_none());
+
+        for table_bits in 1..RISTRETTO255_WNAF_MAX_TABLE_BITS + 1 {
+            let table = VartimePrecomputation::new(&P, table_bits).unwrap();
+            for _ in 0..4 {
+                let a = Scalar::random(&mut rng);
+                let b = Scalar::random(&mut rng);
+                let expected = RistrettoPoint::vartime_double_scalar_mul_basepoint(&a, &P, &b);
+                assert_eq!(expected, B * a + P * b);
+                assert_eq!(table.vartime_double_scalar_mul_basepoint(&a, &b), expected);
+            }
+            let zero = Scalar::from(0u64);
+            assert_eq!(
+                table.vartime_double_scalar_mul_basepoint(&zero, &zero),
+                RistrettoPoint::identity()
+            );
+
+            // Either scalar alone being zero leaves the other term
+            let a = Scalar::random(&mut rng);
+            assert_eq!(RistrettoPoint::vartime_double_scalar_mul_basepoint(&a, &P, &zero), B * a);
+            assert_eq!(table.vartime_double_scalar_mul_basepoint(&a, &zero), B * a);
+            assert_eq!(RistrettoPoint::vartime_double_scalar_mul_basepoint(&zero, &P, &a), P * a);
+            assert_eq!(table.vartime_double_scalar_mul_basepoint(&zero, &a), P * a);
+        }
+    }
+
+    /// A bump allocator over a fixed buffer, which tracks how much is live
+    struct Arena {
+        buf: Vec<u8>,
+        used: usize,
+        live: usize,
+        peak: usize,
+    }
+
+    unsafe extern "C" fn arena_alloc(ctx: *mut c_void, size: usize, align: usize) -> *mut c_void {
+        let arena = &mut *(ctx as *mut Arena);
+        let base = arena.buf.as_mut_ptr() as usize;
+        let start = (base + arena.used + align - 1) & !(align - 1);
+        if start + size > base + arena.buf.len() {
+            return ptr::null_mut();
+        }
+        arena.used = start + size - base;
+        arena.live += size;
+        arena.peak = arena.peak.max(arena.live);
+        start as *mut c_void
+    }
+
+    unsafe extern "C" fn arena_free(ctx: *mut c_void, _ptr: *mut c_void, size: usize) {
+        (*(ctx as *mut Arena)).live -= size;
+    }
+
+    #[test]
+    fn allocator_is_used_for_tables_and_scratch() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let s = Scalar::random(&mut rng);
+
+        let arena: *mut Arena = Box::into_raw(Box::new(Arena {
+            buf: vec![0u8; 1 << 20],
+            used: 0,
+            live: 0,
+            peak: 0,
+        }));
+        let allocator = ristretto255_allocator_t {
+            alloc: Some(arena_alloc),
+            free: Some(arena_free),
+            ctx: arena as *mut c_void,
+        };
+
+        unsafe {
+            let mut pre = ptr::null_mut();
+            let error = ristretto255_precomputed_create(&mut pre, &B.0, &allocator);
+            assert_eq!(error, RISTRETTO_SUCCESS);
+            assert_eq!((*arena).live, ristretto255_sizeof_precomputed_s);
+            let mut P = B;
+            ristretto255_precomputed_scalarmul(&mut P.0, pre, &s.0);
+            assert_eq!(P, B * s);
+            ristretto255_precomputed_free(pre, &allocator);
+            assert_eq!((*arena).live, 0);
+
+            let mut wnaf = ptr::null_mut();
+            let error = ristretto255_wnaf_precomputed_create(&mut wnaf, &B.0, 6, &allocator);
+            assert_eq!(error, RISTRETTO_SUCCESS);
+            ristretto255_wnaf_precomputed_destroy(wnaf, &allocator);
+            assert_eq!((*arena).live, 0);
+
+            // Both multiscalar algorithms stay within the documented bound
+            for &n in [7usize, 250].iter() {
+                let scalars: Vec<ristretto255_scalar_t> =
+                    (0..n).map(|_| Scalar::random(&mut rng).0).collect();
+                let points: Vec<ristretto255_point_t> = (0..n).map(|_| B.0).collect();
+                (*arena).used = 0;
+                (*arena).peak = 0;
+                let error = ristretto255_multiscalar_mul_non_secret_with_allocator(
+                    &mut P.0,
+                    scalars.as_ptr(),
+                    points.as_ptr(),
+                    n,
+                    &allocator,
+                );
+                assert_eq!(error, RISTRETTO_SUCCESS);
+                assert!((*arena).peak <= n * ristretto255_multiscalar_scratch_bytes_per_term);
+                assert_eq!((*arena).live, 0);
+            }
+
+            // An exhausted arena is reported, not worked around
+            (*arena).used = (*arena).buf.len();
+            let error = ristretto255_precomputed_create(&mut pre, &B.0, &allocator);
+            assert_eq!(error, RISTRETTO_FAILURE);
+            assert!(pre.is_null());
+
+            drop(Box::from_raw(arena));
+        }
+    }
+
+    // Runs tasks on four scoped threads, counting how many it was given
+    unsafe extern "C" fn threads_run(
+        ctx: *mut c_void,
+        task: Option<unsafe extern "C" fn(*mut c_void, usize)>,
+        arg: *mut c_void,
+        ntasks: usize,
+    ) {
+        let tasks_run = &*(ctx as *const AtomicUsize);
+        let next = AtomicUsize::new(0);
+        let task = task.unwrap();
+        let arg = arg as usize;
+        thread::scope(|scope| {
+            for _ in 0..4 {
+                scope.spawn(|| loop {
+                    let i = next.fetch_add(1, Ordering::SeqCst);
+                    if i >= ntasks {
+                        break;
+                    }
+                    task(arg as *mut c_void, i);
+                    tasks_run.fetch_add(1, Ordering::SeqCst);
+                });
+            }
+        });
+    }
+
+    #[test]
+    fn parallel_multiscalar_matches_serial() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+
+        let tasks_run = AtomicUsize::new(0);
+        let executor = ristretto255_executor_t {
+            run: Some(threads_run),
+            ctx: &tasks_run as *const AtomicUsize as *mut c_void,
+        };
+
+        for &n in [150usize, 300].iter() {
+            let scalars: Vec<Scalar> = (0..n)
+                .map(|_| Scalar::random(&mut rng) * Scalar::random(&mut rng))
+                .collect();
+            let points: Vec<RistrettoPoint> = (0..n).map(|_| B * Scalar::random(&mut rng)).collect();
+            let raw_scalars: Vec<ristretto255_scalar_t> = scalars.iter().map(|s| s.0).collect();
+            let raw_points: Vec<ristretto255_point_t> = points.iter().map(|p| p.0).collect();
+
+            let mut P = B;
+            unsafe {
+                tasks_run.store(0, Ordering::SeqCst);
+                let error = ristretto255_multiscalar_mul_parallel(
+                    &mut P.0,
+                    raw_scalars.as_ptr(),
+                    raw_points.as_ptr(),
+                    n,
+                    ptr::null(),
+                    &executor,
+                );
+                assert_eq!(error, RISTRETTO_SUCCESS);
+                assert!(tasks_run.load(Ordering::SeqCst) > 1);
+                assert_eq!(P, RistrettoPoint::multiscalar_mul(&scalars, &points));
+
+                tasks_run.store(0, Ordering::SeqCst);
+                let error = ristretto255_multiscalar_mul_non_secret_parallel(
+                    &mut P.0,
+                    raw_scalars.as_ptr(),
+                    raw_points.as_ptr(),
+                    n,
+                    ptr::null(),
+                    &executor,
+                );
+                assert_eq!(error, RISTRETTO_SUCCESS);
+                assert_eq!(P, RistrettoPoint::vartime_multiscalar_mul(&scalars, &points));
+            }
+        }
+        assert!(tasks_run.load(Ordering::SeqCst) > 1);
+    }
+
+    unsafe extern "C" fn os_rng_fill(ctx: *mut c_void, out: *mut u8, len: usize) {
+        let rng = &mut *(ctx as *mut OsRng);
+        for i in 0..len {
+            *out.add(i) = rng.gen::<u8>();
+        }
+    }
+
+    #[test]
+    fn batch_verify_finds_false_equations() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let n = 40;
+
+        // s = r + c*a, so that s*B == R + c*A
+        let c: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+        let a: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+        let r: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+        let mut s: Vec<ristretto255_scalar_t> = (0..n).map(|i| (r[i] + c[i] * a[i]).0).collect();
+        let R: Vec<ristretto255_point_t> = r.iter().map(|r| (B * *r).0).collect();
+        let A: Vec<ristretto255_point_t> = a.iter().map(|a| (B * *a).0).collect();
+        let c: Vec<ristretto255_scalar_t> = c.iter().map(|c| c.0).collect();
+
+        let mut os_rng = OsRng::new().unwrap();
+        let weights = ristretto255_rng_t {
+            fill: Some(os_rng_fill),
+            ctx: &mut os_rng as *mut OsRng as *mut c_void,
+        };
+        let mut bad = vec![0usize; n];
+        let mut nbad = 0;
+
+        let verify = |s: &[ristretto255_scalar_t], bad: &mut [usize], nbad: &mut usize| unsafe {
+            ristretto255_batch_verify(
+                bad.as_mut_ptr(),
+                nbad,
+                s.as_ptr(),
+                R.as_ptr(),
+                c.as_ptr(),
+                A.as_ptr(),
+                n,
+                &weights,
+                ptr::null(),
+                ptr::null(),
+            )
+        };
+
+        assert_eq!(verify(&s, &mut bad, &mut nbad), RISTRETTO_SUCCESS);
+        assert_eq!(nbad, 0);
+
+        s[3] = (Scalar(s[3]) + Scalar::from(1u64)).0;
+        s[27] = (Scalar(s[27]) * Scalar::from(2u64)).0;
+        s[28] = (Scalar(s[28]) * Scalar::from(3u64)).0;
+        assert_eq!(verify(&s, &mut bad, &mut nbad), RISTRETTO_FAILURE);
+        assert_eq!(&bad[..nbad], &[3, 27, 28]);
+    }
+
+    #[test]
+    fn batch_verify_handles_zero_challenges() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let n = 4;
+
+        // Equation 1 is valid with c == 0; equation 2 claims s*B == identity
+        let mut c: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+        let a: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+        let r: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+        c[1] = Scalar::from(0u64);
+        c[2] = Scalar::from(0u64);
+        let s: Vec<ristretto255_scalar_t> = (0..n).map(|i| (r[i] + c[i] * a[i]).0).collect();
+        let mut R: Vec<ristretto255_point_t> = r.iter().map(|r| (B * *r).0).collect();
+        R[2] = RistrettoPoint::identity().0;
+        let A: Vec<ristretto255_point_t> = a.iter().map(|a| (B * *a).0).collect();
+        let c: Vec<ristretto255_scalar_t> = c.iter().map(|c| c.0).collect();
+
+        let mut os_rng = OsRng::new().unwrap();
+        let weights = ristretto255_rng_t {
+            fill: Some(os_rng_fill),
+            ctx: &mut os_rng as *mut OsRng as *mut c_void,
+        };
+        let verify = |range: ::std::ops::Range<usize>, bad: &mut [usize], nbad: &mut usize| unsafe {
+            ristretto255_batch_verify(
+                bad.as_mut_ptr(),
+                nbad,
+                s[range.clone()].as_ptr(),
+                R[range.clone()].as_ptr(),
+                c[range.clone()].as_ptr(),
+                A[range.clone()].as_ptr(),
+                range.len(),
+                &weights,
+                ptr::null(),
+                ptr::null(),
+            )
+        };
+
+        // On their own, and as the leaves of a bisection
+        let mut bad = vec![0usize; n];
+        let mut nbad = 0;
+        assert_eq!(verify(1..2, &mut bad, &mut nbad), RISTRETTO_SUCCESS);
+        assert_eq!(verify(2..3, &mut bad, &mut nbad), RISTRETTO_FAILURE);
+        assert_eq!(&bad[..nbad], &[0]);
+        assert_eq!(verify(0..n, &mut bad, &mut nbad), RISTRETTO_FAILURE);
+        assert_eq!(&bad[..nbad], &[2]);
+    }
+
+    #[test]
+    fn point_cache_hits_and_evicts() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let table_bytes = unsafe { ristretto255_sizeof_wnaf_precomputed(4) };
+        assert!(table_bytes > 0);
+
+        let mut cache = ptr::null_mut();
+        unsafe {
+            let error = ristretto255_point_cache_create(&mut cache, 64, 4, ptr::null());
+            assert_eq!(error, RISTRETTO_FAILURE);
+            assert!(cache.is_null());
+            // Room for one set of eight entries, but not two
+            let error = ristretto255_point_cache_create(&mut cache, 12 * table_bytes, 4, ptr::null());
+            assert_eq!(error, RISTRETTO_SUCCESS);
+        }
+
+        let points: Vec<RistrettoPoint> = (0..9).map(|_| B * Scalar::random(&mut rng)).collect();
+        let encodings: Vec<_> = points.iter().map(|P| P.compress()).collect();
+        let decode = |ser: &CompressedRistretto, allow_identity| unsafe {
+            let mut pt = RistrettoPoint::identity();
+            let mut table = ptr::null();
+            let error =
+                ristretto255_point_cache_decode(&mut pt.0, &mut table, cache, ser.0.as_ptr(), allow_identity);
+            (error, pt, table)
+        };
+
+        // Fill the set and hold every entry, so the last point can't be cached
+        let mut tables = Vec::new();
+        for (i, ser) in encodings.iter().enumerate() {
+            let (error, pt, table) = decode(ser, 0);
+            assert_eq!(error, RISTRETTO_SUCCESS);
+            assert_eq!(pt, points[i]);
+            assert_eq!(table.is_null(), i == 8);
+            tables.push(table);
+        }
+
+        // A hit gives back the same table, which computes the right thing
+        let (error, pt, table) = decode(&encodings[2], 0);
+        assert_eq!(error, RISTRETTO_SUCCESS);
+        assert_eq!(pt, points[2]);
+        assert_eq!(table, tables[2]);
+        let a = Scalar::random(&mut rng);
+        let b = Scalar::random(&mut rng);
+        let mut combo = RistrettoPoint::identity();
+        unsafe {
+            ristretto255_base_double_scalarmul_non_secret_precomputed(&mut combo.0, &a.0, table, &b.0);
+            ristretto255_point_cache_release(cache, table);
+        }
+        assert_eq!(combo, RistrettoPoint::vartime_double_scalar_mul_basepoint(&a, &points[2], &b));
+
+        // Once the entries are given back, the last point replaces one of them
+        for table in tables.iter() {
+            unsafe { ristretto255_point_cache_release(cache, *table) };
+        }
+        let (error, pt, table) = decode(&encodings[8], 0);
+        assert_eq!(error, RISTRETTO_SUCCESS);
+        assert_eq!(pt, points[8]);
+        assert!(!table.is_null());
+        unsafe { ristretto255_point_cache_release(cache, table) };
+
+        // Bad encodings fail, as does a cached identity when it isn't allowed
+        let (error, _, table) = decode(&CompressedRistretto([0xff; 32]), 0);
+        assert_eq!(error, RISTRETTO_FAILURE);
+        assert!(table.is_null());
+        let (error, pt, table) = decode(&CompressedRistretto::identity(), 1);
+        assert_eq!(error, RISTRETTO_SUCCESS);
+        assert_eq!(pt, RistrettoPoint::identity());
+        unsafe { ristretto255_point_cache_release(cache, table) };
+        let (error, _, table) = decode(&CompressedRistretto::identity(), 0);
+        assert_eq!(error, RISTRETTO_FAILURE);
+        assert!(table.is_null());
+
+        unsafe { ristretto255_point_cache_destroy(cache, ptr::null()) };
+    }
+
+    #[test]
+    fn point_cache_allocates_only_when_created() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let max_bytes = 1 << 18;
+
+        let arena: *mut Arena = Box::into_raw(Box::new(Arena {
+            buf: vec![0u8; 1 << 20],
+            used: 0,
+            live: 0,
+            peak: 0,
+        }));
+        let allocator = ristretto255_allocator_t {
+            alloc: Some(arena_alloc),
+            free: Some(arena_free),
+            ctx: arena as *mut c_void,
+        };
+
+        let mut cache = ptr::null_mut();
+        unsafe {
+            assert_eq!(ristretto255_point_cache_create(&mut cache, max_bytes, 5, &allocator), RISTRETTO_SUCCESS);
+            assert!((*arena).live <= max_bytes);
+        }
+        let used = unsafe { (*arena).used };
+
+        // Misses from several threads build their tables in the reserved scratch
+        let points: Vec<RistrettoPoint> = (0..64).map(|_| B * Scalar::random(&mut rng)).collect();
+        let shared = cache as usize;
+        let workers: Vec<_> = points
+            .chunks(16)
+            .map(|chunk| {
+                let chunk: Vec<(RistrettoPoint, CompressedRistretto)> = chunk.iter().map(|P| (*P, P.compress())).collect();
+                thread::spawn(move || {
+                    let cache = shared as *mut ristretto255_point_cache_t;
+                    let a = Scalar::from(5u64);
+                    let b = Scalar::from(7u64);
+                    for (P, ser) in chunk.iter() {
+                        let mut pt = RistrettoPoint::identity();
+                        let mut table = ptr::null();
+                        let mut combo = RistrettoPoint::identity();
+                        unsafe {
+                            let error = ristretto255_point_cache_decode(&mut pt.0, &mut table, cache, ser.0.as_ptr(), 0);
+                            assert_eq!(error, RISTRETTO_SUCCESS);
+                            assert!(!table.is_null());
+                            ristretto255_base_double_scalarmul_non_secret_precomputed(&mut combo.0, &a.0, table, &b.0);
+                            ristretto255_point_cache_release(cache, table);
+                        }
+                        assert_eq!(pt, *P);
+                        assert_eq!(combo, RistrettoPoint::vartime_double_scalar_mul_basepoint(&a, P, &b));
+                    }
+                })
+            })
+            .collect();
+        for w in workers {
+            w.join().unwrap();
+        }
+
+        unsafe {
+            assert_eq!((*arena).used, used);
+            ristretto255_point_cache_destroy(cache, &allocator);
+            assert_eq!((*arena).live, 0);
+            drop(Box::from_raw(arena));
+        }
+    }
+
+    #[test]
+    fn canonical_keys_and_dedup_match_point_eq() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+
+        // Repeats in other coordinates: torqued, and scaled projectively
+        let mut points: Vec<ristretto255_point_t> = (0..70).map(|_| (B * Scalar::random(&mut rng)).0).collect();
+        points.push(RistrettoPoint::identity().0);
+        for i in 0..points.len() {
+            if i % 3 == 0 {
+                let mut q = points[i];
+                let mut factor = [0u8; 32];
+                factor[0] = i as u8 + 2;
+                unsafe {
+                    ristretto255_point_debugging_torque(&mut q, &points[i]);
+                    ristretto255_point_debugging_pscale(&mut q, &q, factor.as_ptr());
+                }
+                points.push(q);
+            }
+        }
+        points.push(points[5]);
+        let n = points.len();
+
+        let mut keys = vec![[0u8; 32]; n];
+        let mut first = vec![0usize; n];
+        unsafe {
+            ristretto255_point_canonical_batch(keys.as_mut_ptr(), points.as_ptr(), n);
+            assert_eq!(ristretto255_point_dedup(first.as_mut_ptr(), points.as_ptr(), n, ptr::null()), RISTRETTO_SUCCESS);
+        }
+
+        for i in 0..n {
+            let mut expected = i;
+            for j in 0..n {
+                let eq = unsafe { ristretto255_point_eq(&points[i], &points[j]) } != 0;
+                assert_eq!(keys[i] == keys[j], eq);
+                if eq && j < expected {
+                    expected = j;
+                }
+            }
+            assert_eq!(first[i], expected);
+        }
+        assert_eq!(keys[70], [0u8; 32]);
+        assert_eq!(first.iter().enumerate().filter(|&(i, f)| i == *f).count(), 71);
+    }
+
+    #[test]
+    fn counters_count_this_threads_operations() {
+        let B = RistrettoPoint::basepoint();
+        let counts = || unsafe {
+            let mut counters = ristretto255_counters_t::default();
+            let error = ristretto255_counters_get(&mut counters);
+            (error, counters)
+        };
+
+        unsafe { ristretto255_counters_reset() };
+        let (error, before) = counts();
+        assert_eq!(before, ristretto255_counters_t::default());
+        if error != RISTRETTO_SUCCESS {
+            // Not a COUNTERS=1 build
+            return;
+        }
+
+        let mut P = B.0;
+        let mut ser = [0u8; 32];
+        unsafe {
+            ristretto255_point_double(&mut P, &B.0);
+            ristretto255_point_add(&mut P, &P, &B.0);
+            ristretto255_point_encode(ser.as_mut_ptr(), &P);
+        }
+        let (_, after) = counts();
+        assert_eq!(after.point_double, 1);
+        assert_eq!(after.point_add, 1);
+        assert_eq!(after.gf_isr, 1);
+        assert!(after.gf_mul > 0 && after.gf_sqr > 0);
+
+        // Other threads keep their own counts
+        thread::spawn(move || {
+            let _ = B * Scalar::from(3u64);
+        }).join()
+            .unwrap();
+        assert_eq!(counts().1, after);
+    }
+
+    #[test]
+    fn tables_round_trip_in_place() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let P = B * Scalar::random(&mut rng);
+        let points: Vec<RistrettoPoint> = (0..5).map(|_| B * Scalar::random(&mut rng)).collect();
+
+        let mut comb = ptr::null_mut();
+        let mut wnaf = ptr::null_mut();
+        unsafe {
+            assert_eq!(ristretto255_precomputed_create(&mut comb, &P.0, ptr::null()), RISTRETTO_SUCCESS);
+            assert_eq!(ristretto255_wnaf_precomputed_create(&mut wnaf, &P.0, 5, ptr::null()), RISTRETTO_SUCCESS);
+        }
+        let refs = [
+            ristretto255_table_ref_t { kind: RISTRETTO255_TABLE_COMB, count: 1, table: comb as *const c_void },
+            ristretto255_table_ref_t { kind: RISTRETTO255_TABLE_WNAF, count: 1, table: wnaf as *const c_void },
+            ristretto255_table_ref_t {
+                kind: RISTRETTO255_TABLE_POINTS,
+                count: points.len(),
+                table: points.as_ptr() as *const c_void,
+            },
+        ];
+
+        // Write into an aligned buffer, as mmap would give
+        let bytes = unsafe { ristretto255_tables_serialized_bytes(refs.as_ptr(), refs.len()) };
+        assert!(bytes > 0);
+        let mut storage = vec![0u8; bytes + 2 * RISTRETTO255_TABLES_ALIGNMENT];
+        let skip = storage.as_ptr().align_offset(RISTRETTO255_TABLES_ALIGNMENT);
+        let buf = &mut storage[skip..skip + bytes];
+        unsafe {
+            assert_eq!(ristretto255_tables_serialize(buf.as_mut_ptr(), bytes - 1, refs.as_ptr(), refs.len()), RISTRETTO_FAILURE);
+            assert_eq!(ristretto255_tables_serialize(buf.as_mut_ptr(), bytes, refs.as_ptr(), refs.len()), RISTRETTO_SUCCESS);
+        }
+
+        let (yes, no) = unsafe { (RISTRETTO_TRUE, RISTRETTO_FALSE) };
+        let view = |buf: &[u8], verify| unsafe {
+            let mut found = [ristretto255_table_ref_t { kind: 0, count: 0, table: ptr::null() }; 3];
+            let mut n = found.len();
+            let error = ristretto255_tables_view(found.as_mut_ptr(), &mut n, buf.as_ptr(), buf.len(), verify);
+            (error, n, found)
+        };
+        let (error, n, found) = view(buf, yes);
+        assert_eq!(error, RISTRETTO_SUCCESS);
+        assert_eq!(n, 3);
+
+        // The tables are used where they lie, and compute what the originals do
+        let range = buf.as_ptr_range();
+        for (f, r) in found.iter().zip(refs.iter()) {
+            assert_eq!((f.kind, f.count), (r.kind, r.count));
+            assert!(range.contains(&(f.table as *const u8)));
+        }
+        let a = Scalar::random(&mut rng);
+        let b = Scalar::random(&mut rng);
+        let mut combo = RistrettoPoint::identity();
+        unsafe {
+            ristretto255_precomputed_scalarmul(&mut combo.0, found[0].table as *const ristretto255_precomputed_s, &a.0);
+            assert_eq!(combo, P * a);
+            assert_eq!(ristretto255_wnaf_precomputed_table_bits(found[1].table as *const _), 5);
+            ristretto255_base_double_scalarmul_non_secret_precomputed(
+                &mut combo.0, &a.0, found[1].table as *const ristretto255_wnaf_precomputed_t, &b.0);
+            assert_eq!(combo, RistrettoPoint::vartime_double_scalar_mul_basepoint(&a, &P, &b));
+            let loaded = found[2].table as *const ristretto255_point_t;
+            for (i, pt) in points.iter().enumerate() {
+                assert_eq!(ristretto255_point_eq(loaded.add(i), &pt.0), yes);
+            }
+            ristretto255_precomputed_free(comb, ptr::null());
+            ristretto255_wnaf_precomputed_destroy(wnaf, ptr::null());
+        }
+
+        // Too little space reports the count; corruption, truncation and
+        // misalignment are caught
+        let (error, n, _) = unsafe {
+            let mut n = 1;
+            let mut one = [ristretto255_table_ref_t { kind: 0, count: 0, table: ptr::null() }];
+            let error = ristretto255_tables_view(one.as_mut_ptr(), &mut n, buf.as_ptr(), buf.len(), yes);
+            (error, n, one)
+        };
+        assert_eq!((error, n), (RISTRETTO_FAILURE, 3));
+        assert_eq!(view(&buf[..bytes - 64], no).0, RISTRETTO_FAILURE);
+        let last = bytes - 1;
+        buf[last - 100] ^= 1;
+        assert_eq!(view(buf, no).0, RISTRETTO_SUCCESS);
+        assert_eq!(view(buf, yes).0, RISTRETTO_FAILURE);
+        buf[last - 100] ^= 1;
+        buf[8] ^= 2; // the version
+        assert_eq!(view(buf, no).0, RISTRETTO_FAILURE);
+        buf[8] ^= 2;
+        storage.copy_within(skip..skip + bytes, skip + 8);
+        assert_eq!(view(&storage[skip + 8..skip + 8 + bytes], no).0, RISTRETTO_FAILURE);
+    }
+
+    #[test]
+    fn generators_mul_matches_multiscalar_mul() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        // More than one chunk of generators
+        let points: Vec<RistrettoPoint> = (0..70).map(|_| B * Scalar::random(&mut rng)).collect();
+        let scalars: Vec<Scalar> = (0..70).map(|_| Scalar::random(&mut rng)).collect();
+
+        for &teeth in [1u32, 5, 8].iter() {
+            let mut gens = ptr::null_mut();
+            unsafe {
+                assert_eq!(
+                    ristretto255_generators_create(&mut gens, points.as_ptr() as *const _, points.len(), teeth, ptr::null()),
+                    RISTRETTO_SUCCESS
+                );
+                assert_eq!(ristretto255_generators_count(gens), points.len());
+            }
+
+            for &n in [0usize, 1, 17, 64, 70].iter() {
+                let expected = RistrettoPoint::multiscalar_mul(&scalars[..n], &points[..n]);
+                let mut combo = RistrettoPoint::identity();
+                let mut combo_vt = RistrettoPoint::identity();
+                unsafe {
+                    assert_eq!(
+                        ristretto255_generators_mul(&mut combo.0, gens, scalars.as_ptr() as *const _, n),
+                        RISTRETTO_SUCCESS
+                    );
+                    assert_eq!(
+                        ristretto255_generators_mul_non_secret(&mut combo_vt.0, gens, scalars.as_ptr() as *const _, n),
+                        RISTRETTO_SUCCESS
+                    );
+                }
+                assert_eq!(combo, expected);
+                assert_eq!(combo_vt, expected);
+            }
+
+            unsafe {
+                let mut combo = RistrettoPoint::identity();
+                let more: Vec<Scalar> = (0..71).map(|_| Scalar::random(&mut rng)).collect();
+                assert_eq!(
+                    ristretto255_generators_mul(&mut combo.0, gens, more.as_ptr() as *const _, more.len()),
+                    RISTRETTO_FAILURE
+                );
+                ristretto255_generators_destroy(gens, ptr::null());
+            }
+        }
+
+        // With one tooth, n % 256 == 1 leaves one point in the last inversion
+        let more: Vec<RistrettoPoint> = (0..257).map(|_| B * Scalar::random(&mut rng)).collect();
+        let more_scalars: Vec<Scalar> = (0..257).map(|_| Scalar::random(&mut rng)).collect();
+        for &n in [1usize, 257].iter() {
+            let mut gens = ptr::null_mut();
+            let mut combo = RistrettoPoint::identity();
+            unsafe {
+                assert_eq!(
+                    ristretto255_generators_create(&mut gens, more.as_ptr() as *const _, n, 1, ptr::null()),
+                    RISTRETTO_SUCCESS
+                );
+                assert_eq!(
+                    ristretto255_generators_mul(&mut combo.0, gens, more_scalars.as_ptr() as *const _, n),
+                    RISTRETTO_SUCCESS
+                );
+                ristretto255_generators_destroy(gens, ptr::null());
+            }
+            assert_eq!(combo, RistrettoPoint::multiscalar_mul(&more_scalars[..n], &more[..n]));
+        }
+
+        let mut gens = ptr::null_mut();
+        unsafe {
+            assert_eq!(ristretto255_generators_create(&mut gens, points.as_ptr() as *const _, 1, 0, ptr::null()), RISTRETTO_FAILURE);
+            assert_eq!(ristretto255_generators_create(&mut gens, points.as_ptr() as *const _, 1, 9, ptr::null()), RISTRETTO_FAILURE);
+            assert!(gens.is_null());
+        }
+    }
+
+    #[test]
+    fn generators_tables_round_trip_in_place() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let points: Vec<RistrettoPoint> = (0..20).map(|_| B * Scalar::random(&mut rng)).collect();
+        let scalars: Vec<Scalar> = (0..20).map(|_| Scalar::random(&mut rng)).collect();
+
+        let serialize = |gens: *const ristretto255_generators_t, count| unsafe {
+            let refs = [ristretto255_table_ref_t { kind: RISTRETTO255_TABLE_GENERATORS, count, table: gens as *const c_void }];
+            let bytes = ristretto255_tables_serialized_bytes(refs.as_ptr(), refs.len());
+            let mut storage = vec![0u8; bytes + RISTRETTO255_TABLES_ALIGNMENT];
+            let skip = storage.as_ptr().align_offset(RISTRETTO255_TABLES_ALIGNMENT);
+            if bytes > 0 {
+                assert_eq!(
+                    ristretto255_tables_serialize(storage[skip..].as_mut_ptr(), bytes, refs.as_ptr(), refs.len()),
+                    RISTRETTO_SUCCESS
+                );
+            }
+            (storage, skip, bytes)
+        };
+
+        let mut gens = [ptr::null_mut(); 2];
+        for g in gens.iter_mut() {
+            unsafe {
+                assert_eq!(
+                    ristretto255_generators_create(g, points.as_ptr() as *const _, points.len(), 5, ptr::null()),
+                    RISTRETTO_SUCCESS
+                );
+            }
+        }
+        unsafe {
+            assert_eq!(ristretto255_generators_teeth(gens[0]), 5);
+            assert_eq!(ristretto255_sizeof_generators(1, 0), 0);
+            assert_eq!(ristretto255_sizeof_generators(1, 9), 0);
+            assert_eq!(ristretto255_sizeof_generators(usize::MAX, 5), 0);
+        }
+        assert_eq!(serialize(gens[0], 2).2, 0);
+
+        // The same generators give the same bytes
+        let (mut storage, skip, bytes) = serialize(gens[0], 1);
+        let (other, other_skip, _) = serialize(gens[1], 1);
+        assert!(bytes > 0);
+        assert_eq!(storage[skip..skip + bytes], other[other_skip..other_skip + bytes]);
+
+        let (yes, no) = unsafe { (RISTRETTO_TRUE, RISTRETTO_FALSE) };
+        let view = |buf: &[u8], verify| unsafe {
+            let mut found = [ristretto255_table_ref_t { kind: 0, count: 0, table: ptr::null() }];
+            let mut n = found.len();
+            let error = ristretto255_tables_view(found.as_mut_ptr(), &mut n, buf.as_ptr(), buf.len(), verify);
+            (error, n, found[0])
+        };
+        let buf = &mut storage[skip..skip + bytes];
+        let (error, n, found) = view(buf, yes);
+        assert_eq!((error, n, found.kind, found.count), (RISTRETTO_SUCCESS, 1, RISTRETTO255_TABLE_GENERATORS, 1));
+        assert!(buf.as_ptr_range().contains(&(found.table as *const u8)));
+
+        // The tables compute in place what the originals do
+        let loaded = found.table as *const ristretto255_generators_t;
+        let expected = RistrettoPoint::multiscalar_mul(&scalars, &points);
+        let mut combo = RistrettoPoint::identity();
+        let mut combo_vt = RistrettoPoint::identity();
+        unsafe {
+            assert_eq!(ristretto255_generators_count(loaded), points.len());
+            assert_eq!(ristretto255_generators_teeth(loaded), 5);
+            assert_eq!(
+                ristretto255_generators_mul(&mut combo.0, loaded, scalars.as_ptr() as *const _, scalars.len()),
+                RISTRETTO_SUCCESS
+            );
+            assert_eq!(
+                ristretto255_generators_mul_non_secret(&mut combo_vt.0, loaded, scalars.as_ptr() as *const _, scalars.len()),
+                RISTRETTO_SUCCESS
+            );
+            for g in gens.iter() {
+                ristretto255_generators_destroy(*g, ptr::null());
+            }
+        }
+        assert_eq!(combo, expected);
+        assert_eq!(combo_vt, expected);
+
+        // A table whose size doesn't match its own header is rejected
+        assert_eq!(view(&buf[..bytes - 64], no).0, RISTRETTO_FAILURE);
+        let header = unsafe { (found.table as *const u8).offset_from(buf.as_ptr()) } as usize;
+        buf[header] ^= 1; // the generator count
+        assert_eq!(view(buf, no).0, RISTRETTO_FAILURE);
+    }
+
+    #[test]
+    fn direct_scalarmul_matches_scalarmul_and_encode() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let (yes, no) = unsafe { (RISTRETTO_TRUE, RISTRETTO_FALSE) };
+
+        for _ in 0..20 {
+            let P = B * Scalar::random(&mut rng);
+            let a = Scalar::random(&mut rng);
+            let expected = (P * a).compress();
+
+            let mut direct = [0u8; 32];
+            unsafe {
+                assert_eq!(
+                    ristretto255_direct_scalarmul(direct.as_mut_ptr(), P.compress().0.as_ptr(), &a.0, no, yes),
+                    RISTRETTO_SUCCESS
+                );
+            }
+            assert_eq!(direct, expected.0);
+        }
+    }
+
+    #[test]
+    fn hash_to_point_streams_sha512() {
+        use sha2::{Digest, Sha512};
+
+        // A caller-supplied hash: SHA-512 with a prefix, from the library's own
+        unsafe extern "C" fn prefixed_init(ctx: *mut c_void) {
+            let sha = ctx as *mut ristretto255_sha512_ctx_t;
+            ristretto255_sha512_init(sha);
+            ristretto255_sha512_update(sha, b"prefix".as_ptr(), 6);
+        }
+        unsafe extern "C" fn prefixed_update(ctx: *mut c_void, data: *const u8, len: usize) {
+            ristretto255_sha512_update(ctx as *mut _, data, len);
+        }
+        unsafe extern "C" fn prefixed_final(ctx: *mut c_void, out: *mut u8) {
+            ristretto255_sha512_final(ctx as *mut _, out);
+        }
+
+        let mut rng = OsRng::new().unwrap();
+        // Around every padding boundary, and several blocks
+        let lens = [0usize, 1, 111, 112, 113, 127, 128, 129, 239, 240, 256, 1000, 5000];
+        let mut digests = vec![0u8; 64 * lens.len()];
+        let mut expected = Vec::new();
+
+        for (j, &len) in lens.iter().enumerate() {
+            let msg: Vec<u8> = (0..len).map(|_| rng.gen::<u8>()).collect();
+            let mut sha_state: ristretto255_sha512_ctx_t = unsafe { mem::zeroed() };
+            let prefixed = ristretto255_hash_t {
+                init: Some(prefixed_init),
+                update: Some(prefixed_update),
+                final_: Some(prefixed_final),
+                ctx: &mut sha_state as *mut _ as *mut c_void,
+            };
+
+            let mut ctx: ristretto255_hash_to_point_ctx_t = unsafe { mem::zeroed() };
+            let mut ctx2: ristretto255_hash_to_point_ctx_t = unsafe { mem::zeroed() };
+            let mut sha: ristretto255_sha512_ctx_t = unsafe { mem::zeroed() };
+            unsafe {
+                ristretto255_hash_to_point_init(&mut ctx, ptr::null());
+                ristretto255_hash_to_point_init(&mut ctx2, &prefixed);
+                ristretto255_sha512_init(&mut sha);
+            }
+            let mut fed = 0;
+            while fed < len {
+                let chunk = ((rng.gen::<u8>() as usize) % 200).min(len - fed);
+                unsafe {
+                    ristretto255_hash_to_point_update(&mut ctx, msg[fed..].as_ptr(), chunk);
+                    ristretto255_hash_to_point_update(&mut ctx2, msg[fed..].as_ptr(), chunk);
+                    ristretto255_sha512_update(&mut sha, msg[fed..].as_ptr(), chunk);
+                }
+                fed += chunk;
+            }
+
+            let mut digest = [0u8; 64];
+            let mut pt = RistrettoPoint::identity();
+            let mut pt2 = RistrettoPoint::identity();
+            unsafe {
+                ristretto255_sha512_final(&mut sha, digest.as_mut_ptr());
+                ristretto255_hash_to_point_final(&mut ctx, &mut pt.0);
+                ristretto255_hash_to_point_final(&mut ctx2, &mut pt2.0);
+            }
+            assert_eq!(&digest[..], Sha512::digest(&msg).as_slice());
+
+            let mut bytes = [0u8; 64];
+            bytes.copy_from_slice(Sha512::digest(&msg).as_slice());
+            assert_eq!(pt, RistrettoPoint::from_uniform_bytes(&bytes));
+            let mut prefixed_msg = b"prefix".to_vec();
+            prefixed_msg.extend_from_slice(&msg);
+            bytes.copy_from_slice(Sha512::digest(&prefixed_msg).as_slice());
+            assert_eq!(pt2, RistrettoPoint::from_uniform_bytes(&bytes));
+
+            // The digests can go to the batch map instead
+            unsafe {
+                ristretto255_hash_to_point_init(&mut ctx, ptr::null());
+                ristretto255_hash_to_point_update(&mut ctx, msg.as_ptr(), len);
+                ristretto255_hash_to_point_final_digest(&mut ctx, digests[64 * j..].as_mut_ptr());
+            }
+            expected.push(pt);
+        }
+
+        let mut pts = vec![RistrettoPoint::identity(); lens.len()];
+        unsafe {
+            ristretto255_point_from_hash_uniform_batch(pts.as_mut_ptr() as *mut _, digests.as_ptr(), lens.len());
+        }
+        assert_eq!(pts, expected);
+    }
+
+    #[test]
+    fn point_batch_matches_point_ops() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let (yes, no) = unsafe { (RISTRETTO_TRUE, RISTRETTO_FALSE) };
+        let tasks_run = AtomicUsize::new(0);
+        let executor = ristretto255_executor_t {
+            run: Some(threads_run),
+            ctx: &tasks_run as *const AtomicUsize as *mut c_void,
+        };
+
+        // A partial last block, and enough terms for Pippenger and several chunks
+        for &n in [13usize, 200].iter() {
+            let a: Vec<RistrettoPoint> = (0..n).map(|_| B * Scalar::random(&mut rng)).collect();
+            let b: Vec<RistrettoPoint> = (0..n).map(|_| B * Scalar::random(&mut rng)).collect();
+            let scalars: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+            let pick: Vec<ristretto_bool_t> = (0..n).map(|i| if i % 3 == 0 { yes } else { no }).collect();
+            let mut hashes = vec![0u8; 64 * n];
+            rng.fill_bytes(&mut hashes);
+
+            let unpack = |batch: *const ristretto255_point_batch_t| -> Vec<RistrettoPoint> {
+                let mut out = vec![RistrettoPoint::identity(); n];
+                unsafe {
+                    assert_eq!(
+                        ristretto255_point_batch_unpack(out.as_mut_ptr() as *mut _, batch, 0, n),
+                        RISTRETTO_SUCCESS
+                    );
+                }
+                out
+            };
+
+            unsafe {
+                let (mut x, mut y, mut out) = (ptr::null_mut(), ptr::null_mut(), ptr::null_mut());
+                assert_eq!(ristretto255_point_batch_create(&mut x, n, ptr::null()), RISTRETTO_SUCCESS);
+                assert_eq!(ristretto255_point_batch_create(&mut y, n, ptr::null()), RISTRETTO_SUCCESS);
+                assert_eq!(ristretto255_point_batch_create(&mut out, n, ptr::null()), RISTRETTO_SUCCESS);
+                assert_eq!(ristretto255_point_batch_count(x), n);
+                assert!(unpack(x).iter().all(|p| *p == RistrettoPoint::identity()));
+
+                // Packing in two pieces, and out of range
+                assert_eq!(ristretto255_point_batch_pack(x, 0, a.as_ptr() as *const _, 5), RISTRETTO_SUCCESS);
+                assert_eq!(ristretto255_point_batch_pack(x, 5, a[5..].as_ptr() as *const _, n - 5), RISTRETTO_SUCCESS);
+                assert_eq!(ristretto255_point_batch_pack(y, 0, b.as_ptr() as *const _, n), RISTRETTO_SUCCESS);
+                assert_eq!(ristretto255_point_batch_pack(y, 1, b.as_ptr() as *const _, n), RISTRETTO_FAILURE);
+                assert_eq!(unpack(x), a);
+
+                assert_eq!(ristretto255_point_batch_add(out, x, y), RISTRETTO_SUCCESS);
+                assert_eq!(unpack(out), a.iter().zip(b.iter()).map(|(p, q)| *p + *q).collect::<Vec<_>>());
+                assert_eq!(ristretto255_point_batch_double(out, out), RISTRETTO_SUCCESS);
+                assert_eq!(unpack(out), a.iter().zip(b.iter()).map(|(p, q)| (*p + *q) + (*p + *q)).collect::<Vec<_>>());
+                assert_eq!(ristretto255_point_batch_negate(out, x), RISTRETTO_SUCCESS);
+                assert_eq!(unpack(out), a.iter().map(|p| -*p).collect::<Vec<_>>());
+                assert_eq!(ristretto255_point_batch_cond_sel(out, x, y, pick.as_ptr()), RISTRETTO_SUCCESS);
+                let selected: Vec<RistrettoPoint> = (0..n).map(|i| if i % 3 == 0 { b[i] } else { a[i] }).collect();
+                assert_eq!(unpack(out), selected);
+                assert_eq!(ristretto255_point_batch_scalarmul(out, x, scalars.as_ptr() as *const _), RISTRETTO_SUCCESS);
+                assert_eq!(unpack(out), a.iter().zip(scalars.iter()).map(|(p, s)| *p * *s).collect::<Vec<_>>());
+
+                let mut ser = vec![[0u8; 32]; n];
+                ristretto255_point_batch_encode(ser.as_mut_ptr(), x);
+                assert!(ser.iter().zip(a.iter()).all(|(s, p)| *s == p.compress().0));
+                let mut results = vec![RISTRETTO_FAILURE; n];
+                assert_eq!(
+                    ristretto255_point_batch_decode(out, results.as_mut_ptr(), ser.as_ptr() as *const u8, no),
+                    RISTRETTO_SUCCESS
+                );
+                assert_eq!(unpack(out), a);
+                ser[3] = [0xffu8; 32];
+                assert_eq!(
+                    ristretto255_point_batch_decode(out, results.as_mut_ptr(), ser.as_ptr() as *const u8, no),
+                    RISTRETTO_FAILURE
+                );
+                assert_eq!(results[3], RISTRETTO_FAILURE);
+                assert!(results.iter().enumerate().all(|(i, r)| i == 3 || *r == RISTRETTO_SUCCESS));
+
+                ristretto255_point_batch_from_hash_uniform(out, hashes.as_ptr());
+                let mut hashed = vec![RistrettoPoint::identity(); n];
+                ristretto255_point_from_hash_uniform_batch(hashed.as_mut_ptr() as *mut _, hashes.as_ptr(), n);
+                assert_eq!(unpack(out), hashed);
+
+                let expected = RistrettoPoint::multiscalar_mul(&scalars, &a);
+                let mut combo = RistrettoPoint::identity();
+                for &ex in [ptr::null(), &executor as *const _].iter() {
+                    assert_eq!(
+                        ristretto255_point_batch_multiscalar_mul(&mut combo.0, scalars.as_ptr() as *const _, x, ptr::null(), ex),
+                        RISTRETTO_SUCCESS
+                    );
+                    assert_eq!(combo, expected);
+                    assert_eq!(
+                        ristretto255_point_batch_multiscalar_mul_non_secret(
+                            &mut combo.0, scalars.as_ptr() as *const _, x, ptr::null(), ex
+                        ),
+                        RISTRETTO_SUCCESS
+                    );
+                    assert_eq!(combo, expected);
+                }
+
+                let mut small = ptr::null_mut();
+                assert_eq!(ristretto255_point_batch_create(&mut small, n - 1, ptr::null()), RISTRETTO_SUCCESS);
+                assert_eq!(ristretto255_point_batch_add(small, x, y), RISTRETTO_FAILURE);
+                assert_eq!(ristretto255_point_batch_scalarmul(small, x, scalars.as_ptr() as *const _), RISTRETTO_FAILURE);
+
+                for batch in [x, y, out, small].iter() {
+                    ristretto255_point_batch_destroy(*batch, ptr::null());
+                }
+                ristretto255_point_batch_destroy(ptr::null_mut(), ptr::null());
+            }
+        }
+    }
+
+    #[test]
+    fn multiscalar_mul_with_scratch_reuses_one_buffer() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+        let tasks_run = AtomicUsize::new(0);
+        let executor = ristretto255_executor_t {
+            run: Some(threads_run),
+            ctx: &tasks_run as *const AtomicUsize as *mut c_void,
+        };
+
+        // Either side of the Pippenger threshold, where the sizes must not drop
+        let sizes = [0usize, 1, 13, 189, 190, 200];
+        let max = unsafe { ristretto255_multiscalar_scratch_size(200) };
+        // One buffer for every call, deliberately misaligned, and sized for the largest
+        let mut buffer = vec![0u8; max + 1];
+        let scratch = buffer[1..].as_mut_ptr() as *mut c_void;
+
+        for &n in sizes.iter() {
+            let scalars: Vec<Scalar> = (0..n).map(|_| Scalar::random(&mut rng)).collect();
+            let points: Vec<RistrettoPoint> = (0..n).map(|_| B * Scalar::random(&mut rng)).collect();
+            let expected = RistrettoPoint::multiscalar_mul(&scalars, &points);
+            let size = unsafe { ristretto255_multiscalar_scratch_size(n) };
+            assert!(size <= max);
+
+            for &ex in [ptr::null(), &executor as *const _].iter() {
+                let mut combo = RistrettoPoint::identity();
+                unsafe {
+                    for &bytes in [max, size].iter() {
+                        assert_eq!(
+                            ristretto255_multiscalar_mul_with_scratch(
+                                &mut combo.0, scalars.as_ptr() as *const _, points.as_ptr() as *const _, n, scratch,
+                                bytes, ex
+                            ),
+                            RISTRETTO_SUCCESS
+                        );
+                        assert_eq!(combo, expected);
+                        assert_eq!(
+                            ristretto255_multiscalar_mul_non_secret_with_scratch(
+                                &mut combo.0, scalars.as_ptr() as *const _, points.as_ptr() as *const _, n, scratch,
+                                bytes, ex
+                            ),
+                            RISTRETTO_SUCCESS
+                        );
+                        assert_eq!(combo, expected);
+                    }
+
+                    if n > 0 {
+                        let small = mem::size_of::<ristretto255_point_t>() * n;
+                        assert_eq!(
+                            ristretto255_multiscalar_mul_with_scratch(
+                                &mut combo.0, scalars.as_ptr() as *const _, points.as_ptr() as *const _, n, scratch, small, ex
+                            ),
+                            RISTRETTO_FAILURE
+                        );
+                        assert_eq!(
+                            ristretto255_multiscalar_mul_non_secret_with_scratch(
+                                &mut combo.0, scalars.as_ptr() as *const _, points.as_ptr() as *const _, n, scratch,
+                                0, ex
+                            ),
+                            RISTRETTO_FAILURE
+                        );
+                    }
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn scalar_batch_invert_matches_invert() {
+        let mut rng = OsRng::new().unwrap();
+
+        let mut scalars: Vec<Scalar> = (0..17)
+            .map(|_| Scalar::random(&mut rng) * Scalar::random(&mut rng))
+            .collect();
+        scalars[5] = Scalar::from(0u64);
+
+        let inverses = Scalar::batch_invert(&scalars);
+        for (s, inv) in scalars.iter().zip(inverses.iter()) {
+            assert_eq!(s.invert(), *inv);
+        }
+        assert_eq!(inverses[5], Scalar::from(0u64));
+        assert_eq!(scalars[0] * inverses[0], Scalar::from(1u64));
+
+        assert!(Scalar::batch_invert(&[]).is_empty());
+    }
+
+    #[test]
+    fn scalar_muladd_and_montgomery_horner() {
+        let mut rng = OsRng::new().unwrap();
+
+        let a = Scalar::random(&mut rng) * Scalar::random(&mut rng);
+        let b = Scalar::random(&mut rng) * Scalar::random(&mut rng);
+        let c = Scalar::random(&mut rng) * Scalar::random(&mut rng);
+        assert_eq!(a.mul_add(&b, &c), a * b + c);
+        assert_eq!(a.mul_add(&a, &a), a * a + a);
+
+        let coeffs: Vec<Scalar> = (0..12)
+            .map(|_| Scalar::random(&mut rng) * Scalar::random(&mut rng))
+            .collect();
+        let mut expected = Scalar::from(0u64);
+        for coeff in coeffs.iter().rev() {
+            expected = expected * a + *coeff;
+        }
+
+        unsafe {
+            let mut x: ristretto255_scalar_mont_t = mem::zeroed();
+            let mut acc: ristretto255_scalar_mont_t = mem::zeroed();
+            let mut m: ristretto255_scalar_mont_t = mem::zeroed();
+            let accp: *mut ristretto255_scalar_mont_t = &mut acc;
+            let mp: *mut ristretto255_scalar_mont_t = &mut m;
+            ristretto255_scalar_to_montgomery(&mut x, &a.0);
+            for coeff in coeffs.iter().rev() {
+                ristretto255_scalar_to_montgomery(mp, &coeff.0);
+                ristretto255_scalar_mont_muladd(accp, accp, &x, mp);
+            }
+            let mut result = Scalar::from(0u64);
+            ristretto255_scalar_from_montgomery(&mut result.0, accp);
+            assert_eq!(result, expected);
+
+            ristretto255_scalar_mont_sqr(mp, &x);
+            ristretto255_scalar_mont_mul(mp, mp, &x);
+            ristretto255_scalar_from_montgomery(&mut result.0, mp);
+            assert_eq!(result, a * a * a);
+        }
+    }
+
+    #[test]
+    fn scalar_decode_batch_rejects_noncanonical() {
+        let mut rng = OsRng::new().unwrap();
+
+        let scalars: Vec<Scalar> = (0..9)
+            .map(|_| {
+                Scalar::random(&mut rng) * Scalar::random(&mut rng) * Scalar::random(&mut rng)
+            })
+            .collect();
+        let mut bytes: Vec<[u8; 32]> = scalars.iter().map(|s| s.to_bytes()).collect();
+
+        let decoded = Scalar::from_canonical_bytes_batch(&bytes).unwrap();
+        assert_eq!(decoded, scalars);
+
+        // The group order itself is the smallest non-canonical encoding
+        bytes[4] = (Scalar::from(0u64) - Scalar::from(1u64)).to_bytes();
+        bytes[4][0] += 1;
+        assert!(Scalar::from_canonical_bytes_batch(&bytes).is_none());
+    }
+
+    #[test]
+    fn multiscalar_mul_matches_naive() {
+        let mut rng = OsRng::new().unwrap();
+        let B = RistrettoPoint::basepoint();
+
+        // Straus below the Pippenger threshold, Pippenger above it
+        for &n in [0usize, 1, 2, 7, 64, 250].iter() {
+            let scalars: Vec<Scalar> = (0..n)
+                .map(|_| {
+                    Scalar::random(&mut rng) * Scalar::random(&mut rng) * Scalar::random(&mut rng)
+                        + Scalar::random(&mut rng)
+                })
+                .collect();
+            let points: Vec<RistrettoPoint> =
+                (0..n).map(|_| B * Scalar::random(&mut rng)).collect();
+
+            let naive = scalars
+                .iter()
+                .zip(points.iter())
+                .fold(RistrettoPoint::identity(), |acc, (s, P)| acc + *P * *s);
+
+            assert_eq!(RistrettoPoint::multiscalar_mul(&scalars, &points), naive);
+            assert_eq!(RistrettoPoint::vartime_multiscalar_mul(&scalars, &points), naive);
+        }
+    }
 }
@@ -45,6 +45,43 @@ impl CompressedRistretto {
 
         convert_result(point.into(), error).ok()
     }
+
+    /// Attempt to decompress a slice of encodings.
+    ///
+    /// # Return
+    ///
+    /// - `Ok(points)` if every element was the canonical encoding of a point;
+    ///
+    /// - `Err(points)` otherwise, with `None` for each element that wasn't.
+    pub fn decompress_batch(
+        encodings: &[CompressedRistretto],
+    ) -> Result<Vec<RistrettoPoint>, Vec<Option<RistrettoPoint>>> {
+        let n = encodings.len();
+        let bytes: Vec<u8> = encodings.iter().flat_map(|c| c.0.iter().cloned()).collect();
+        let mut points = vec![uninitialized_point_t(); n];
+        let mut results = vec![RISTRETTO_FAILURE; n];
+
+        let error = unsafe {
+            ristretto255_point_decode_batch(
+                points.as_mut_ptr(),
+                results.as_mut_ptr(),
+                bytes.as_ptr(),
+                n,
+                RISTRETTO_TRUE, // Allow identity for testing
+            )
+        };
+
+        let decoded: Vec<Option<RistrettoPoint>> = points
+            .into_iter()
+            .zip(results.into_iter())
+            .map(|(point, error)| convert_result(point.into(), error).ok())
+            .collect();
+
+        match convert_result((), error) {
+            Ok(()) => Ok(decoded.into_iter().map(Option::unwrap).collect()),
+            Err(_) => Err(decoded),
+        }
+    }
 }
 
 impl CompressedRistretto {
@@ -68,7 +105,7 @@ fn uninitialized_point_t() -> ristretto255_point_t {
 /// Curve25519 (a.k.a. Ristretto255)
 #[derive(Copy, Clone)]
 #[repr(transparent)]
-pub struct RistrettoPoint(ristretto255_point_t);
+pub struct RistrettoPoint(pub(crate) ristretto255_point_t);
 
 impl RistrettoPoint {
     /// Compress this point using the Ristretto encoding.
@@ -82,6 +119,18 @@ impl RistrettoPoint {
         CompressedRistretto(bytes)
     }
 
+    /// Compress a slice of points using the Ristretto encoding.
+    pub fn compress_batch(points: &[RistrettoPoint]) -> Vec<CompressedRistretto> {
+        let points: Vec<ristretto255_point_t> = points.iter().map(|p| p.0).collect();
+        let mut bytes = vec![[0u8; 32]; points.len()];
+
+        unsafe {
+            ristretto255_point_encode_batch(bytes.as_mut_ptr(), points.as_ptr(), points.len());
+        }
+
+        bytes.into_iter().map(CompressedRistretto).collect()
+    }
+
     /// Construct a `RistrettoPoint` from 64 bytes of data.
     pub fn from_uniform_bytes(bytes: &[u8; 64]) -> RistrettoPoint {
         let mut point = uninitialized_point_t();
@@ -93,6 +142,38 @@ impl RistrettoPoint {
         RistrettoPoint(point)
     }
 
+    /// Construct a `RistrettoPoint` from each of a slice of 64-byte inputs.
+    pub fn from_uniform_bytes_batch(inputs: &[[u8; 64]]) -> Vec<RistrettoPoint> {
+        let mut points = vec![RistrettoPoint(uninitialized_point_t()); inputs.len()];
+
+        unsafe {
+            ristretto255_point_from_hash_uniform_batch(
+                points.as_mut_ptr() as *mut ristretto255_point_t,
+                inputs.as_ptr() as *const u8,
+                inputs.len(),
+            );
+        }
+
+        points
+    }
+
+    /// Hash bytes to a `RistrettoPoint` with SHA-512, streaming them through
+    /// the hash in pieces of at most `chunk` bytes.
+    pub fn hash_from_bytes_sha512(bytes: &[u8], chunk: usize) -> RistrettoPoint {
+        let mut point = uninitialized_point_t();
+
+        unsafe {
+            let mut ctx: ristretto255_hash_to_point_ctx_t = mem::zeroed();
+            ristretto255_hash_to_point_init(&mut ctx, ::std::ptr::null());
+            for piece in bytes.chunks(chunk) {
+                ristretto255_hash_to_point_update(&mut ctx, piece.as_ptr(), piece.len());
+            }
+            ristretto255_hash_to_point_final(&mut ctx, &mut point);
+        }
+
+        RistrettoPoint(point)
+    }
+
     /// Return the coset self + E[4], for debugging.
     /// TODO: double check the `EIGHT_TORSION` table is correct
     pub fn coset4(self) -> [Self; 4] {
@@ -113,6 +194,128 @@ impl RistrettoPoint {
     pub fn identity() -> RistrettoPoint {
         RistrettoPoint(unsafe { ristretto255_point_identity })
     }
+
+    /// Compute `scalar * basepoint` using the precomputed comb table.
+    pub fn mul_base(scalar: &Scalar) -> RistrettoPoint {
+        let mut result = uninitialized_point_t();
+
+        unsafe {
+            ristretto255_precomputed_scalarmul(
+                &mut result,
+                ristretto255_precomputed_base,
+                &scalar.0,
+            );
+        }
+
+        RistrettoPoint(result)
+    }
+
+    /// Compute `scalar * basepoint` using the precomputed comb table, in
+    /// variable time.
+    pub fn vartime_mul_base(scalar: &Scalar) -> RistrettoPoint {
+        let mut result = uninitialized_point_t();
+
+        unsafe {
+            ristretto255_precomputed_scalarmul_non_secret(
+                &mut result,
+                ristretto255_precomputed_base,
+                &scalar.0,
+            );
+        }
+
+        RistrettoPoint(result)
+    }
+}
+
+impl RistrettoPoint {
+    /// Compute `a * basepoint + b * point` in variable time.
+    pub fn vartime_double_scalar_mul_basepoint(
+        a: &Scalar,
+        point: &RistrettoPoint,
+        b: &Scalar,
+    ) -> RistrettoPoint {
+        let mut result = uninitialized_point_t();
+
+        unsafe {
+            ristretto255_base_double_scalarmul_non_secret(&mut result, &a.0, &point.0, &b.0);
+        }
+
+        RistrettoPoint(result)
+    }
+}
+
+/// A wNAF table of a point, for repeated variable-time multiplication
+pub struct VartimePrecomputation(*mut ristretto255_wnaf_precomputed_t);
+
+impl VartimePrecomputation {
+    /// Build the table of `point` with a window of `table_bits` bits, or
+    /// `None` if the window is out of range.
+    pub fn new(point: &RistrettoPoint, table_bits: u32) -> Option<VartimePrecomputation> {
+        let mut pre = ::std::ptr::null_mut();
+        let error = unsafe {
+            ristretto255_wnaf_precomputed_create(&mut pre, &point.0, table_bits, ::std::ptr::null())
+        };
+        convert_result(VartimePrecomputation(pre), error).ok()
+    }
+
+    /// Compute `a * basepoint + b * point`.
+    pub fn vartime_double_scalar_mul_basepoint(&self, a: &Scalar, b: &Scalar) -> RistrettoPoint {
+        let mut result = uninitialized_point_t();
+
+        unsafe {
+            ristretto255_base_double_scalarmul_non_secret_precomputed(
+                &mut result,
+                &a.0,
+                self.0,
+                &b.0,
+            );
+        }
+
+        RistrettoPoint(result)
+    }
+}
+
+impl Drop for VartimePrecomputation {
+    fn drop(&mut self) {
+        unsafe { ristretto255_wnaf_precomputed_destroy(self.0, ::std::ptr::null()) }
+    }
+}
+
+impl RistrettoPoint {
+    /// Compute `scalars[0] * points[0] + ... + scalars[n-1] * points[n-1]`
+    /// in constant time.
+    pub fn multiscalar_mul(scalars: &[Scalar], points: &[RistrettoPoint]) -> RistrettoPoint {
+        Self::multiscalar_mul_with(ristretto255_multiscalar_mul, scalars, points)
+    }
+
+    /// Compute `scalars[0] * points[0] + ... + scalars[n-1] * points[n-1]`
+    /// in variable time.
+    pub fn vartime_multiscalar_mul(
+        scalars: &[Scalar],
+        points: &[RistrettoPoint],
+    ) -> RistrettoPoint {
+        Self::multiscalar_mul_with(ristretto255_multiscalar_mul_non_secret, scalars, points)
+    }
+
+    fn multiscalar_mul_with(
+        f: unsafe extern "C" fn(
+            *mut ristretto255_point_t,
+            *const ristretto255_scalar_t,
+            *const ristretto255_point_t,
+            usize,
+        ) -> ristretto_error_t,
+        scalars: &[Scalar],
+        points: &[RistrettoPoint],
+    ) -> RistrettoPoint {
+        assert_eq!(scalars.len(), points.len());
+
+        let scalars: Vec<ristretto255_scalar_t> = scalars.iter().map(|s| s.0).collect();
+        let points: Vec<ristretto255_point_t> = points.iter().map(|p| p.0).collect();
+        let mut result = uninitialized_point_t();
+
+        let error = unsafe { f(&mut result, scalars.as_ptr(), points.as_ptr(), scalars.len()) };
+        convert_result(RistrettoPoint(result), error).unwrap()
+    }
 }
 
 impl Default for RistrettoPoint {
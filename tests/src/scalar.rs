@@ -6,10 +6,11 @@ use std::{
 };
 
 use libristretto255_sys::*;
-use util::convert_bool;
+use util::{convert_bool, convert_result};
 
 /// Scalars (i.e. wrapper around `ristretto255_scalar_t`)
 #[derive(Copy, Clone)]
+#[repr(transparent)]
 pub struct Scalar(pub(crate) ristretto255_scalar_t);
 
 impl Scalar {
@@ -22,6 +23,64 @@ impl Scalar {
     pub fn random<T: Rng + CryptoRng>(rng: &mut T) -> Self {
         Scalar::from(rng.gen::<u64>())
     }
+
+    /// Decode a slice of canonical encodings, or `None` if any of them
+    /// wasn't canonical.
+    pub fn from_canonical_bytes_batch(bytes: &[[u8; 32]]) -> Option<Vec<Scalar>> {
+        let mut scalars = vec![Scalar(uninitialized_scalar_t()); bytes.len()];
+
+        let error = unsafe {
+            ristretto255_scalar_decode_batch(
+                scalars.as_mut_ptr() as *mut ristretto255_scalar_t,
+                bytes.as_ptr() as *const u8,
+                bytes.len(),
+            )
+        };
+
+        convert_result(scalars, error).ok()
+    }
+
+    /// Encode this `Scalar` as 32 little-endian bytes.
+    pub fn to_bytes(&self) -> [u8; 32] {
+        let mut bytes = [0u8; 32];
+        unsafe {
+            ristretto255_scalar_encode(bytes.as_mut_ptr(), &self.0);
+        }
+        bytes
+    }
+
+    /// Compute the inverse of this `Scalar`, or zero if it is zero.
+    pub fn invert(&self) -> Scalar {
+        let mut result = uninitialized_scalar_t();
+        unsafe {
+            let _ = ristretto255_scalar_invert(&mut result, &self.0);
+        }
+        Scalar(result)
+    }
+
+    /// Invert every element of a slice, sharing a single inversion.
+    pub fn batch_invert(scalars: &[Scalar]) -> Vec<Scalar> {
+        let mut result = vec![Scalar(uninitialized_scalar_t()); scalars.len()];
+
+        unsafe {
+            let _ = ristretto255_scalar_batch_invert(
+                result.as_mut_ptr() as *mut ristretto255_scalar_t,
+                scalars.as_ptr() as *const ristretto255_scalar_t,
+                scalars.len(),
+            );
+        }
+
+        result
+    }
+
+    /// Compute `self * b + c` with a single reduction.
+    pub fn mul_add(&self, b: &Scalar, c: &Scalar) -> Scalar {
+        let mut result = uninitialized_scalar_t();
+        unsafe {
+            ristretto255_scalar_muladd(&mut result, &self.0, &b.0, &c.0);
+        }
+        Scalar(result)
+    }
 }
 
 // ------------------------------------------------------------------------
@@ -6,7 +6,6 @@
 
 use ristretto::{CompressedRistretto, RistrettoPoint};
 use hex;
-//use sha2::{Digest, Sha512};
 
 /// Test the byte encodings of small multiples
 ///     [0]B, [1]B, ..., [15]B
@@ -99,34 +98,33 @@ pub fn bad_encodings() {
 
 // Test Elligator 2 by performing hash-to-point with SHA-512 on the byte
 // encodings of the following list of UTF-8 encoded strings
-// TODO: the vectors on the web site are wrong. get new ones!
-//#[test]
-//fn hash_to_point() {
-//    let labels = [
-//        "Ristretto is traditionally a short shot of espresso coffee",
-//        "made with the normal amount of ground coffee but extracted with",
-//        "about half the amount of water in the same amount of time",
-//        "by using a finer grind.",
-//        "This produces a concentrated shot of coffee per volume.",
-//        "Just pulling a normal shot short will produce a weaker shot",
-//        "and is not a Ristretto as some believe.",
-//    ];
-//
-//    let encoded_hash_to_points = [
-//        "5c827272de19f868edc97deac8a9b12dea4604807463b59b040d463b8fa7f77f",
-//        "88c01ea47c9a049578adced99d439d0f09a847595c546d51c6082b891f9dbc65",
-//        "722b48912cd619ad2d542e78293f11053f8d18dcae456c7c7c98923d5eda844d",
-//        "fafc78dec2fd2565d8592320fe0632ec288ffd3acd55314e619fdb9884dabe1c",
-//        "8ae1f2311f26c03f14bcc192c0dd7589f679019068e6c83907e01735810a817c",
-//        "6a152dcc33dfda4554e4999b439fe734f11021502825f14a1745e44dd023423b",
-//        "b2757b09bc0ab160b2965e8e6385b3238e04665159b65ba26f1526303ebda807",
-//    ];
-//
-//    for i in 0..7 {
-//        let point = RistrettoPoint::hash_from_bytes::<Sha512>(labels[i].as_bytes());
-//        assert_eq!(
-//            hex::encode(point.compress().as_bytes()),
-//            encoded_hash_to_points[i],
-//        );
-//    }
-//}
+#[test]
+fn hash_to_point() {
+    let labels = [
+        "Ristretto is traditionally a short shot of espresso coffee",
+        "made with the normal amount of ground coffee but extracted with",
+        "about half the amount of water in the same amount of time",
+        "by using a finer grind.",
+        "This produces a concentrated shot of coffee per volume.",
+        "Just pulling a normal shot short will produce a weaker shot",
+        "and is not a Ristretto as some believe.",
+    ];
+
+    let encoded_hash_to_points = [
+        "3066f82a1a747d45120d1740f14358531a8f04bbffe6a819f86dfe50f44a0a46",
+        "f26e5b6f7d362d2d2a94c5d0e7602cb4773c95a2e5c31a64f133189fa76ed61b",
+        "006ccd2a9e6867e6a2c5cea83d3302cc9de128dd2a9a57dd8ee7b9d7ffe02826",
+        "f8f0c87cf237953c5890aec3998169005dae3eca1fbb04548c635953c817f92a",
+        "ae81e7dedf20a497e10c304a765c1767a42d6e06029758d2d7e8ef7cc4c41179",
+        "e2705652ff9f5e44d3e841bf1c251cf7dddb77d140870d1ab2ed64f1a9ce8628",
+        "80bd07262511cdde4863f8a7434cef696750681cb9510eea557088f76d9e5065",
+    ];
+
+    for i in 0..7 {
+        let point = RistrettoPoint::hash_from_bytes_sha512(labels[i].as_bytes(), 7);
+        assert_eq!(
+            hex::encode(point.compress().0),
+            encoded_hash_to_points[i],
+        );
+    }
+}